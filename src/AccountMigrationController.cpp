@@ -555,8 +555,9 @@ QFuture<void> AccountMigrationController::importClientSettings(Account *newAccou
                         promise->start();
                         auto *context = new QObject(this);
 
-                        connect(RosterDb::instance(),
-                                &RosterDb::itemAdded,
+                        // The model emits the signal for items added individually and by roster replacements.
+                        connect(RosterModel::instance(),
+                                &RosterModel::itemAdded,
                                 context,
                                 [context, promise, newAccountJid, jid = itemSettings.jid, updateRosterItem](const RosterItem &rosterItem) mutable {
                                     if (rosterItem.accountJid == newAccountJid && rosterItem.jid == jid) {
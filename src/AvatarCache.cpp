@@ -16,6 +16,14 @@ AvatarCache::AvatarCache(AccountSettings *accountSettings, QObject *parent)
     , m_accountSettings(accountSettings)
 {
     connect(RosterDb::instance(), &RosterDb::itemRemoved, this, &AvatarCache::removeAvatar);
+    connect(RosterDb::instance(),
+            &RosterDb::itemsChanged,
+            this,
+            [this](const QString &accountJid, const QList<RosterItem> &, const QList<RosterItem> &, const QList<QString> &removedJids) {
+                for (const auto &jid : removedJids) {
+                    removeAvatar(accountJid, jid);
+                }
+            });
 }
 
 QPixmap AvatarCache::avatar(const QString &chatJid)
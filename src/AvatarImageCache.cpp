@@ -11,8 +11,10 @@
 #include <QCryptographicHash>
 #include <QDir>
 #include <QHash>
+#include <QSaveFile>
 #include <QStandardPaths>
 #include <QUrl>
+#include <QtConcurrentRun>
 // Kaidan
 #include "KaidanCoreLog.h"
 
@@ -25,10 +27,13 @@ AvatarImageCache *AvatarImageCache::instance()
 
 AvatarImageCache::AvatarImageCache(QObject *parent)
     : QObject(parent)
+    , m_avatarDirectoryPath(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QDir::separator() + QStringLiteral("avatars"))
 {
     Q_ASSERT(!s_instance);
     s_instance = this;
 
+    m_fileThreadPool.setMaxThreadCount(1);
+
     // create avatar directory, if it doesn't exists
     QDir cacheDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation));
     if (!cacheDir.exists(QStringLiteral("avatars")))
@@ -70,58 +75,82 @@ AvatarImageCache::AvatarImageCache(QObject *parent)
 
 AvatarImageCache::~AvatarImageCache()
 {
+    // Save the avatar list file whose saving has been deferred.
+    if (m_avatarsFileSaveScheduled) {
+        writeAvatarsFile();
+    }
+
+    // Finish pending file operations.
+    m_fileThreadPool.waitForDone();
+
     s_instance = nullptr;
 }
 
-AvatarImageCache::AddAvatarResult AvatarImageCache::addAvatar(const QString &jid, const QByteArray &avatar)
+QFuture<AvatarImageCache::AddAvatarResult> AvatarImageCache::addAvatar(const QString &jid, const QByteArray &avatar)
 {
-    AddAvatarResult result;
-
-    // generate a hexadecimal hash of the raw avatar
-    result.hash = QString::fromUtf8(QCryptographicHash::hash(avatar, QCryptographicHash::Sha1).toHex());
-    QString oldHash = QString::fromUtf8(m_jidAvatarMap[jid].toUtf8());
-
-    // set the new hash and the `hasChanged` tag
-    if (oldHash != result.hash) {
-        m_jidAvatarMap[jid] = result.hash;
-        result.hasChanged = true;
+    m_storingAvatarCount++;
+
+    return QtConcurrent::run(&m_fileThreadPool,
+                             [avatarDirectoryPath = m_avatarDirectoryPath, avatar]() {
+                                 AddAvatarResult result;
+
+                                 // generate a hexadecimal hash of the raw avatar
+                                 const auto hash = QString::fromUtf8(QCryptographicHash::hash(avatar, QCryptographicHash::Sha1).toHex());
+
+                                 // write the avatar to disk if it isn't already saved
+                                 if (const auto filePath = avatarDirectoryPath + QDir::separator() + hash; !QFile::exists(filePath)) {
+                                     QSaveFile file(filePath);
+
+                                     if (!file.open(QIODevice::WriteOnly) || file.write(avatar) != avatar.size() || !file.commit()) {
+                                         qCDebug(KAIDAN_CORE_LOG) << "Could not store avatar in" << filePath << file.errorString();
+                                         return result;
+                                     }
+
+                                     // mark that the avatar is new
+                                     result.newWritten = true;
+                                 }
+
+                                 result.hash = hash;
+                                 return result;
+                             })
+        .then(this, [this, jid](AddAvatarResult &&result) {
+            return handleAvatarStored(jid, std::move(result));
+        });
+}
 
-        // delete the avatar if it isn't used anymore
-        cleanUp(oldHash);
-    }
+AvatarImageCache::AddAvatarResult AvatarImageCache::handleAvatarStored(const QString &jid, AddAvatarResult &&result)
+{
+    m_storingAvatarCount--;
 
-    // abort if the avatar with this hash is already saved
-    // only update GUI, if avatar really has changed
-    if (hasAvatarHash(result.hash)) {
-        if (result.hasChanged)
-            Q_EMIT avatarIdsChanged();
-        return result;
-    }
+    // The hash is only set if the avatar could be stored.
+    if (!result.hash.isEmpty()) {
+        // set the new hash and the `hasChanged` tag
+        if (const auto oldHash = m_jidAvatarMap.value(jid); oldHash != result.hash) {
+            m_jidAvatarMap.insert(jid, result.hash);
+            result.hasChanged = true;
 
-    // write the avatar to disk:
-    // get the writable cache location for writing
-    QFile file(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QDir::separator() + QStringLiteral("avatars") + QDir::separator()
-               + result.hash);
-    if (!file.open(QIODevice::WriteOnly))
-        return result;
+            saveAvatarsFile();
 
-    // write the binary avatar
-    file.write(avatar);
+            // delete the avatar if it isn't used anymore
+            cleanUp(oldHash);
+        }
 
-    saveAvatarsFile();
+        // only update GUI, if avatar really has changed
+        if (result.hasChanged || result.newWritten) {
+            AvatarImageNotifier::instance().notifyWatchers(jid, result.hash);
+        }
+    }
 
-    // mark that the avatar is new
-    result.newWritten = true;
+    if (!m_storingAvatarCount) {
+        deleteUnusedAvatars();
+    }
 
-    Q_EMIT avatarIdsChanged();
     return result;
 }
 
 void AvatarImageCache::clearAvatar(const QString &jid)
 {
-    QString oldHash;
-    if (m_jidAvatarMap.contains(jid))
-        oldHash = m_jidAvatarMap[jid];
+    const auto oldHash = m_jidAvatarMap.value(jid);
 
     // if user had no avatar before, just return
     if (oldHash.isEmpty())
@@ -130,23 +159,46 @@ void AvatarImageCache::clearAvatar(const QString &jid)
     m_jidAvatarMap.remove(jid);
     saveAvatarsFile();
     cleanUp(oldHash);
-    Q_EMIT avatarIdsChanged();
+    AvatarImageNotifier::instance().notifyWatchers(jid, {});
 }
 
-void AvatarImageCache::cleanUp(QString &oldHash)
+void AvatarImageCache::cleanUp(const QString &oldHash)
 {
     if (oldHash.isEmpty())
         return;
 
-    // check if the same avatar is still used by another account
-    if (std::ranges::find(m_jidAvatarMap, oldHash) != m_jidAvatarMap.cend())
+    m_possiblyUnusedHashes.insert(oldHash);
+
+    if (!m_storingAvatarCount) {
+        deleteUnusedAvatars();
+    }
+}
+
+void AvatarImageCache::deleteUnusedAvatars()
+{
+    QStringList unusedHashes;
+
+    for (const auto &hash : std::as_const(m_possiblyUnusedHashes)) {
+        // check if the same avatar is still used by another account
+        if (std::ranges::find(m_jidAvatarMap, hash) == m_jidAvatarMap.cend()) {
+            unusedHashes.append(hash);
+        }
+    }
+
+    m_possiblyUnusedHashes.clear();
+
+    if (unusedHashes.isEmpty()) {
         return;
+    }
+
+    // delete the old avatars locally
+    m_fileThreadPool.start([avatarDirectoryPath = m_avatarDirectoryPath, unusedHashes = std::move(unusedHashes)]() {
+        QDir dir(avatarDirectoryPath);
 
-    // delete the old avatar locally
-    QString path = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QDir::separator() + QStringLiteral("avatars");
-    QDir dir(path);
-    if (dir.exists(oldHash))
-        dir.remove(oldHash);
+        for (const auto &hash : unusedHashes) {
+            dir.remove(hash);
+        }
+    });
 }
 
 QString AvatarImageCache::getAvatarPath(const QString &hash) const
@@ -176,34 +228,53 @@ bool AvatarImageCache::hasAvatarHash(const QString &hash) const
 
 void AvatarImageCache::saveAvatarsFile()
 {
-    QString path = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QDir::separator() + QStringLiteral("avatars") + QDir::separator()
-        + QStringLiteral("avatar_list.sha1");
-    QFile file(path);
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    if (m_avatarsFileSaveScheduled) {
         return;
+    }
+
+    m_avatarsFileSaveScheduled = true;
 
-    QTextStream out(&file);
-    const QStringList jidAvatarKeys = m_jidAvatarMap.keys();
-    for (const auto &jid : jidAvatarKeys)
-        /*     < HASH >            < JID >  */
-        out << m_jidAvatarMap[jid] << " " << jid << "\n";
+    QMetaObject::invokeMethod(this, &AvatarImageCache::writeAvatarsFile, Qt::QueuedConnection);
+}
+
+void AvatarImageCache::writeAvatarsFile()
+{
+    m_avatarsFileSaveScheduled = false;
+
+    m_fileThreadPool.start([path = m_avatarDirectoryPath + QDir::separator() + QStringLiteral("avatar_list.sha1"), jidAvatarMap = m_jidAvatarMap]() {
+        QSaveFile file(path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+            return;
+
+        QTextStream out(&file);
+        for (auto itr = jidAvatarMap.cbegin(); itr != jidAvatarMap.cend(); ++itr)
+            /*     < HASH >      < JID >  */
+            out << itr.value() << " " << itr.key() << "\n";
+
+        out.flush();
+
+        if (!file.commit()) {
+            qCDebug(KAIDAN_CORE_LOG) << "Could not save avatar list file" << path << file.errorString();
+        }
+    });
 }
 
 AvatarImageWatcher::AvatarImageWatcher(QObject *parent)
     : QObject(parent)
 {
-    connect(AvatarImageCache::instance(), &AvatarImageCache::avatarIdsChanged, this, &AvatarImageWatcher::urlChanged);
 }
 
+AvatarImageWatcher::~AvatarImageWatcher() = default;
+
 QString AvatarImageWatcher::jid() const
 {
-    return m_jid;
+    return m_key.value_or(QString());
 }
 
 void AvatarImageWatcher::setJid(const QString &jid)
 {
-    if (m_jid != jid) {
-        m_jid = jid;
+    if (!m_key || *m_key != jid) {
+        setKey(QString(jid));
         Q_EMIT jidChanged();
         Q_EMIT urlChanged();
     }
@@ -211,7 +282,12 @@ void AvatarImageWatcher::setJid(const QString &jid)
 
 QUrl AvatarImageWatcher::url()
 {
-    return AvatarImageCache::instance()->getAvatarUrl(m_jid);
+    return AvatarImageCache::instance()->getAvatarUrl(jid());
+}
+
+void AvatarImageWatcher::notify(const QString &)
+{
+    Q_EMIT urlChanged();
 }
 
 #include "moc_AvatarImageCache.cpp"
@@ -7,8 +7,20 @@
 #pragma once
 
 // Qt
+#include <QFuture>
 #include <QMap>
 #include <QObject>
+#include <QSet>
+#include <QThreadPool>
+// Kaidan
+#include "AbstractNotifier.h"
+
+/**
+ * Notifies watchers of a JID about changes of its avatar hash.
+ *
+ * An empty hash is passed if the avatar has been removed.
+ */
+using AvatarImageNotifier = AbstractNotifier<QString, QString>;
 
 /**
  * Caches avatar images.
@@ -35,21 +47,19 @@ public:
     /**
      * Add a new avatar in binary form that will be saved in a cache location
      *
+     * The avatar is hashed and written in the background.
+     * The hash of the JID is updated and its watchers are notified once the avatar is stored.
+     *
      * @param jid The JID the avatar belongs to
      * @param avatar The binary avatar (not in base64)
      */
-    AddAvatarResult addAvatar(const QString &jid, const QByteArray &avatar);
+    QFuture<AddAvatarResult> addAvatar(const QString &jid, const QByteArray &avatar);
 
     /**
      * Clears the user's avatar
      */
     void clearAvatar(const QString &jid);
 
-    /**
-     * Deletes the avatar with this hash, if it isn't used anymore
-     */
-    void cleanUp(QString &oldHash);
-
     /**
      * Returns the path to the avatar of the JID
      */
@@ -77,17 +87,41 @@ public:
      */
     Q_INVOKABLE QUrl getAvatarUrl(const QString &jid) const;
 
-    Q_SIGNAL void avatarIdsChanged();
-
 private:
+    AddAvatarResult handleAvatarStored(const QString &jid, AddAvatarResult &&result);
+
+    /**
+     * Deletes the avatar with this hash, if it isn't used anymore
+     *
+     * The deletion is deferred until no avatar is being stored because the avatar could be
+     * assigned to another JID meanwhile.
+     */
+    void cleanUp(const QString &oldHash);
+    void deleteUnusedAvatars();
+
+    /**
+     * Saves the avatar list file in the background once the current event is processed.
+     *
+     * Thus, adding many avatars at once results in only one write.
+     * A deferred saving is done once the cache is destroyed at the latest.
+     */
     void saveAvatarsFile();
+    void writeAvatarsFile();
+
+    const QString m_avatarDirectoryPath;
+
+    // Pool with a single thread so that file operations are run in the order they are requested
+    QThreadPool m_fileThreadPool;
+    int m_storingAvatarCount = 0;
+    QSet<QString> m_possiblyUnusedHashes;
+    bool m_avatarsFileSaveScheduled = false;
 
     QMap<QString, QString> m_jidAvatarMap;
 
     static AvatarImageCache *s_instance;
 };
 
-class AvatarImageWatcher : public QObject
+class AvatarImageWatcher : public QObject, public AbstractWatcher<QString, QString>
 {
     Q_OBJECT
     Q_PROPERTY(QString jid READ jid WRITE setJid NOTIFY jidChanged)
@@ -95,6 +129,7 @@ class AvatarImageWatcher : public QObject
 
 public:
     explicit AvatarImageWatcher(QObject *parent = nullptr);
+    ~AvatarImageWatcher() override;
 
     QString jid() const;
     void setJid(const QString &jid);
@@ -104,5 +139,5 @@ public:
     Q_SIGNAL void urlChanged();
 
 private:
-    QString m_jid;
+    void notify(const QString &hash) override;
 };
@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "BitsOfBinaryCache.h"
+
+// QXmpp
+#include <QXmppBitsOfBinaryContentId.h>
+
+// Maximum number of bytes of Bits of Binary data kept in memory.
+constexpr qsizetype BITS_OF_BINARY_CACHE_SIZE_LIMIT = 8 * 1024 * 1024;
+
+BitsOfBinaryCache &BitsOfBinaryCache::instance()
+{
+    static BitsOfBinaryCache cache(BITS_OF_BINARY_CACHE_SIZE_LIMIT);
+    return cache;
+}
+
+BitsOfBinaryCache::BitsOfBinaryCache(qsizetype sizeLimit)
+    : m_data(sizeLimit)
+{
+}
+
+bool BitsOfBinaryCache::insert(const QXmppBitsOfBinaryData &data)
+{
+    QMutexLocker locker(&m_mutex);
+    return m_data.insert(data.cid().toCidUrl(), new QXmppBitsOfBinaryData(data), data.data().size());
+}
+
+bool BitsOfBinaryCache::remove(const QXmppBitsOfBinaryContentId &cid)
+{
+    QMutexLocker locker(&m_mutex);
+    return m_data.remove(cid.toCidUrl());
+}
+
+std::optional<QXmppBitsOfBinaryData> BitsOfBinaryCache::data(const QString &cidUrl)
+{
+    QMutexLocker locker(&m_mutex);
+
+    if (const auto *data = m_data.object(cidUrl)) {
+        m_hitCount++;
+        return *data;
+    }
+
+    m_missCount++;
+    return {};
+}
+
+qsizetype BitsOfBinaryCache::count()
+{
+    QMutexLocker locker(&m_mutex);
+    return m_data.count();
+}
+
+qsizetype BitsOfBinaryCache::size()
+{
+    QMutexLocker locker(&m_mutex);
+    return m_data.totalCost();
+}
+
+qsizetype BitsOfBinaryCache::sizeLimit()
+{
+    QMutexLocker locker(&m_mutex);
+    return m_data.maxCost();
+}
+
+quint64 BitsOfBinaryCache::hitCount()
+{
+    QMutexLocker locker(&m_mutex);
+    return m_hitCount;
+}
+
+quint64 BitsOfBinaryCache::missCount()
+{
+    QMutexLocker locker(&m_mutex);
+    return m_missCount;
+}
@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+// std
+#include <optional>
+// Qt
+#include <QCache>
+#include <QMutex>
+// QXmpp
+#include <QXmppBitsOfBinaryData.h>
+
+class QXmppBitsOfBinaryContentId;
+
+/**
+ * Thread-safe cache for Bits of Binary data keyed by content ID.
+ *
+ * The cache is bounded by the byte size of the stored data.
+ * If it is exceeded, the least recently used data is evicted.
+ */
+class BitsOfBinaryCache
+{
+public:
+    static BitsOfBinaryCache &instance();
+
+    /**
+     * @param sizeLimit maximum number of bytes of all stored data
+     */
+    explicit BitsOfBinaryCache(qsizetype sizeLimit);
+
+    /**
+     * Adds data to the cache.
+     *
+     * @return whether the data could be added (i.e., it does not exceed the size limit)
+     */
+    bool insert(const QXmppBitsOfBinaryData &data);
+
+    /**
+     * Removes data from the cache.
+     *
+     * @return whether data for cid was stored
+     */
+    bool remove(const QXmppBitsOfBinaryContentId &cid);
+
+    /**
+     * Returns the data for a content ID URL (e.g., "cid:sha1+8f35fef110ffc5df08d579a50083ff9308fb6242@bob.xmpp.org").
+     */
+    std::optional<QXmppBitsOfBinaryData> data(const QString &cidUrl);
+
+    qsizetype count();
+    qsizetype size();
+    qsizetype sizeLimit();
+    quint64 hitCount();
+    quint64 missCount();
+
+private:
+    QMutex m_mutex;
+    QCache<QString, QXmppBitsOfBinaryData> m_data;
+    quint64 m_hitCount = 0;
+    quint64 m_missCount = 0;
+};
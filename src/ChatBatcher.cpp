@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ChatBatcher.h"
+
+// Qt
+#include <QTimer>
+
+ChatBatcher::ChatBatcher(std::chrono::milliseconds flushInterval, QObject *parent)
+    : QObject(parent)
+    , m_intervalTimer(flushInterval.count() > 0 ? new QTimer(this) : nullptr)
+{
+    if (m_intervalTimer) {
+        m_intervalTimer->setSingleShot(true);
+        m_intervalTimer->setInterval(flushInterval);
+        m_intervalTimer->callOnTimeout(this, &ChatBatcher::endInterval);
+    }
+}
+
+void ChatBatcher::flush()
+{
+    m_flushScheduled = false;
+
+    const auto chatJids = std::exchange(m_pendingChatJids, {});
+
+    if (chatJids.isEmpty()) {
+        return;
+    }
+
+    // Further updates are flushed once the interval has ended.
+    if (m_intervalTimer) {
+        m_intervalTimer->start();
+    }
+
+    for (const auto &chatJid : chatJids) {
+        flushChat(chatJid);
+    }
+}
+
+void ChatBatcher::endInterval()
+{
+    if (m_intervalTimer) {
+        m_intervalTimer->stop();
+    }
+
+    if (!m_pendingChatJids.isEmpty()) {
+        flush();
+    }
+}
+
+int ChatBatcher::pendingChatCount() const
+{
+    return m_pendingChatJids.size();
+}
+
+void ChatBatcher::addPendingChat(const QString &chatJid)
+{
+    if (!m_pendingChatJids.contains(chatJid)) {
+        m_pendingChatJids.append(chatJid);
+    }
+
+    scheduleFlush();
+}
+
+void ChatBatcher::removePendingChat(const QString &chatJid)
+{
+    m_pendingChatJids.removeOne(chatJid);
+}
+
+void ChatBatcher::scheduleFlush()
+{
+    // Updates during an interval are flushed once it has ended.
+    if (!m_flushScheduled && !(m_intervalTimer && m_intervalTimer->isActive())) {
+        m_flushScheduled = true;
+        QMetaObject::invokeMethod(this, &ChatBatcher::flush, Qt::QueuedConnection);
+    }
+}
+
+#include "moc_ChatBatcher.cpp"
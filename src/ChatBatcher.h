@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+// std
+#include <chrono>
+// Qt
+#include <QList>
+#include <QObject>
+
+class QTimer;
+
+/**
+ * Collects pending updates per chat and flushes them as one update per chat.
+ *
+ * The updates added until the event loop is entered again are flushed together.
+ * If a flush interval is set, further updates are flushed at most once per interval.
+ * Chats are flushed in the order their first pending update was added.
+ */
+class ChatBatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * Flushes all pending updates immediately.
+     */
+    void flush();
+
+    /**
+     * Ends the current flush interval and flushes the updates added during it.
+     */
+    void endInterval();
+
+    int pendingChatCount() const;
+
+protected:
+    /**
+     * @param flushInterval minimum time between two flushes or 0 for flushing each time the event
+     *        loop is entered
+     */
+    explicit ChatBatcher(std::chrono::milliseconds flushInterval, QObject *parent = nullptr);
+
+    /**
+     * Marks a chat as having a pending update and schedules flushing it.
+     */
+    void addPendingChat(const QString &chatJid);
+
+    /**
+     * Removes a chat's pending update without flushing it.
+     */
+    void removePendingChat(const QString &chatJid);
+
+    /**
+     * Flushes the pending update of a chat.
+     *
+     * The update may have been removed while flushing a previous chat.
+     */
+    virtual void flushChat(const QString &chatJid) = 0;
+
+private:
+    void scheduleFlush();
+
+    QTimer *const m_intervalTimer;
+
+    // Chats in the order their first pending update was added
+    QList<QString> m_pendingChatJids;
+    bool m_flushScheduled = false;
+};
@@ -10,15 +10,20 @@
 
 #include "ChatController.h"
 
+// std
+#include <numeric>
 // QXmpp
 #include <QXmppUtils.h>
 // Kaidan
 #include "Account.h"
+#include "AccountController.h"
 #include "ChatHintModel.h"
 #include "ChatStateCache.h"
 #include "ChatStateController.h"
 #include "EncryptionController.h"
 #include "EncryptionWatcher.h"
+#include "FileSharingController.h"
+#include "Globals.h"
 #include "GroupChatController.h"
 #include "GroupChatUserDb.h"
 #include "MessageController.h"
@@ -40,6 +45,22 @@ ChatController::ChatController(QObject *parent)
     connect(m_chatEncryptionWatcher, &EncryptionWatcher::hasUsableDevicesChanged, this, &ChatController::isEncryptionEnabledChanged);
 
     connect(GroupChatUserDb::instance(), &GroupChatUserDb::userJidsChanged, this, &ChatController::updateGroupChatUserJids);
+
+    connect(AccountController::instance(), &AccountController::accountRemoved, this, [this](const QString &accountJid) {
+        removeCachedChats([&accountJid](const CachedChat &cachedChat) {
+            return cachedChat.accountJid == accountJid;
+        });
+    });
+    connect(RosterModel::instance(), &RosterModel::itemRemoved, this, [this](const QString &accountJid, const QString &jid) {
+        removeCachedChats([&accountJid, &jid](const CachedChat &cachedChat) {
+            return cachedChat.accountJid == accountJid && cachedChat.jid == jid;
+        });
+    });
+    connect(RosterModel::instance(), &RosterModel::itemsRemoved, this, [this](const QString &accountJid) {
+        removeCachedChats([&accountJid](const CachedChat &cachedChat) {
+            return cachedChat.accountJid == accountJid;
+        });
+    });
 }
 
 ChatController::~ChatController()
@@ -73,25 +94,39 @@ void ChatController::initialize(Account *account, const QString &jid)
     m_rosterItemWatcher.setAccountJid(account->settings()->jid());
     m_rosterItemWatcher.setJid(jid);
 
+    auto cachedChat = takeCachedChat(account->settings()->jid(), jid);
+    m_encryptionInitialized = cachedChat && cachedChat->encryptionInitialized;
+
     initializeEncryption();
-    initializeGroupChat();
+    initializeGroupChat(cachedChat ? cachedChat->groupChatUserJids : std::nullopt);
 
     m_messageController = account->messageController();
 
+    account->fileSharingController()->setOpenChatJid(jid);
+
     m_notificationController = account->notificationController();
     m_notificationController->setChatController(this);
 
     m_chatHintModel = new ChatHintModel(account, this, this);
     Q_EMIT chatHintModelChanged();
 
-    m_messageModel = new MessageModel(account->settings(),
-                                      account->connection(),
-                                      account->atmController(),
-                                      this,
-                                      m_encryptionController,
-                                      m_messageController,
-                                      m_notificationController,
-                                      this);
+    if (cachedChat && cachedChat->messageModel->reactivate()) {
+        m_messageModel = cachedChat->messageModel;
+    } else {
+        if (cachedChat) {
+            discardCachedChat(*cachedChat);
+        }
+
+        m_messageModel = new MessageModel(account->settings(),
+                                          account->connection(),
+                                          account->atmController(),
+                                          this,
+                                          m_encryptionController,
+                                          m_messageController,
+                                          m_notificationController,
+                                          this);
+    }
+
     Q_EMIT messageModelChanged();
 
     initializeChatStateHandling();
@@ -216,17 +251,29 @@ void ChatController::initializeEncryption()
     }
 
     // The encryption for group chats is initialized by initializeGroupChat().
+    // The encryption of a cached chat is not initialized again as long as the account is connected.
+    if (m_encryptionInitialized) {
+        return;
+    }
+
     if (m_account->settings()->jid() == m_jid) {
         executeOnceConnected([this]() {
             m_encryptionController->initializeAccount();
+            m_encryptionInitialized = true;
         });
     } else if (!rosterItem().isGroupChat()) {
-        executeOnceConnected([this]() {
-            m_encryptionController->initializeChat({m_jid});
-        });
+        initializeChatEncryption({m_jid});
     }
 }
 
+void ChatController::initializeChatEncryption(const QList<QString> &jids)
+{
+    executeOnceConnected([this, jids]() {
+        m_encryptionController->initializeChat(jids);
+        m_encryptionInitialized = true;
+    });
+}
+
 bool ChatController::hasUsableEncryptionDevices() const
 {
     if (!m_account) {
@@ -244,11 +291,18 @@ bool ChatController::hasUsableEncryptionDevices() const
     return m_chatEncryptionWatcher->hasUsableDevices();
 }
 
-void ChatController::initializeGroupChat()
+void ChatController::initializeGroupChat(const std::optional<QList<QString>> &cachedGroupChatUserJids)
 {
+    m_groupChatUserJidsFetched = false;
+
     if (rosterItem().isGroupChat()) {
         m_groupChatController = m_account->groupChatController();
 
+        if (cachedGroupChatUserJids) {
+            handleGroupChatUserJidsFetched(*cachedGroupChatUserJids);
+            return;
+        }
+
         const auto relevantAccountJid = m_account->settings()->jid();
         const auto relevantChatJid = m_jid;
 
@@ -257,19 +311,7 @@ void ChatController::initializeGroupChat()
             .then(this, [this, relevantAccountJid, relevantChatJid](QList<QString> &&userJids) {
                 // Ensure that the chat is still the open one after fetching the user JIDs.
                 if (m_account->settings()->jid() == relevantAccountJid && m_jid == relevantChatJid) {
-                    setGroupChatUserJids(userJids);
-
-                    // Handle the case when the database does not contain users for the current group chat.
-                    // That happens, for example, after joining a channel or when the database was manually
-                    // deleted.
-                    //
-                    // The encryption for group chats is initialized once all group chat user JIDs are
-                    // fetched.
-                    if (m_groupChatUserJids.contains(m_account->settings()->jid())) {
-                        updateGroupChatEncryption();
-                    } else {
-                        m_groupChatController->requestGroupChatUsers(jid());
-                    }
+                    handleGroupChatUserJidsFetched(userJids);
                 }
             });
     } else {
@@ -278,13 +320,43 @@ void ChatController::initializeGroupChat()
     }
 }
 
+void ChatController::handleGroupChatUserJidsFetched(const QList<QString> &userJids)
+{
+    setGroupChatUserJids(userJids);
+    m_groupChatUserJidsFetched = true;
+
+    // Handle the case when the database does not contain users for the current group chat.
+    // That happens, for example, after joining a channel or when the database was manually
+    // deleted.
+    //
+    // The encryption for group chats is initialized once all group chat user JIDs are
+    // fetched.
+    if (m_groupChatUserJids.contains(m_account->settings()->jid())) {
+        updateGroupChatEncryption();
+    } else {
+        m_groupChatController->requestGroupChatUsers(jid());
+    }
+}
+
 void ChatController::updateGroupChatUserJids(const QString &accountJid, const QString &groupChatJid)
 {
+    // The user JIDs of a cached group chat are fetched again and the encryption is initialized for
+    // them once it is opened.
+    if (const auto itr = std::ranges::find_if(m_cachedChats,
+                                              [&accountJid, &groupChatJid](const CachedChat &cachedChat) {
+                                                  return cachedChat.accountJid == accountJid && cachedChat.jid == groupChatJid;
+                                              });
+        itr != m_cachedChats.end()) {
+        itr->groupChatUserJids.reset();
+        itr->encryptionInitialized = false;
+    }
+
     if (accountJid == m_account->settings()->jid() && groupChatJid == m_jid) {
         GroupChatUserDb::instance()->userJids(accountJid, groupChatJid).then(this, [this, accountJid, groupChatJid](QList<QString> &&userJids) {
             // Ensure that the chat is still the open one after fetching the user JIDs.
             if (m_account->settings()->jid() == accountJid && m_jid == groupChatJid) {
                 setGroupChatUserJids(userJids);
+                m_encryptionInitialized = false;
                 updateGroupChatEncryption();
             }
         });
@@ -299,9 +371,9 @@ void ChatController::updateGroupChatEncryption()
     if (!jids.isEmpty()) {
         m_chatEncryptionWatcher->setJids(jids);
 
-        executeOnceConnected([this, jids]() {
-            m_encryptionController->initializeChat(jids);
-        });
+        if (!m_encryptionInitialized) {
+            initializeChatEncryption(jids);
+        }
     }
 }
 
@@ -358,13 +430,97 @@ void ChatController::resetPreviousChat()
 {
     removeConnections();
 
+    m_account->fileSharingController()->setOpenChatJid({});
+
     m_chatHintModel->deleteLater();
 
-    m_messageModel->removeAllMessages();
-    m_messageModel->deleteLater();
+    cachePreviousChat();
 
     m_chatStateController->resetPreviousChat();
     m_chatStateController->deleteLater();
 }
 
+void ChatController::cachePreviousChat()
+{
+    const auto accountJid = m_account->settings()->jid();
+    const auto jid = m_jid;
+
+    CachedChat cachedChat{
+        .accountJid = accountJid,
+        .jid = jid,
+        .messageModel = m_messageModel,
+        .groupChatUserJids = rosterItem().isGroupChat() && m_groupChatUserJidsFetched ? std::optional(m_groupChatUserJids) : std::nullopt,
+        .encryptionInitialized = m_encryptionInitialized,
+    };
+
+    // The encryption is initialized again after reconnecting because device lists may have been
+    // missed in the meantime.
+    cachedChat.accountConnectedConnection = connect(
+        m_account->connection(),
+        &Connection::connected,
+        this,
+        [this, accountJid, jid]() {
+            if (const auto itr = std::ranges::find_if(m_cachedChats,
+                                                      [&accountJid, &jid](const CachedChat &cachedChat) {
+                                                          return cachedChat.accountJid == accountJid && cachedChat.jid == jid;
+                                                      });
+                itr != m_cachedChats.end()) {
+                itr->encryptionInitialized = false;
+            }
+        },
+        Qt::SingleShotConnection);
+
+    m_cachedChats.prepend(std::move(cachedChat));
+    m_messageModel = nullptr;
+
+    const auto cachedMessageCount = [this]() {
+        return std::accumulate(m_cachedChats.cbegin(), m_cachedChats.cend(), 0, [](int count, const CachedChat &cachedChat) {
+            return count + cachedChat.messageModel->rowCount();
+        });
+    };
+
+    while (!m_cachedChats.isEmpty() && (m_cachedChats.size() > MAX_CACHED_CHAT_COUNT || cachedMessageCount() > MAX_CACHED_CHAT_MESSAGE_COUNT)) {
+        discardCachedChat(m_cachedChats.last());
+        m_cachedChats.removeLast();
+    }
+}
+
+std::optional<ChatController::CachedChat> ChatController::takeCachedChat(const QString &accountJid, const QString &jid)
+{
+    const auto itr = std::ranges::find_if(m_cachedChats, [&accountJid, &jid](const CachedChat &cachedChat) {
+        return cachedChat.accountJid == accountJid && cachedChat.jid == jid;
+    });
+
+    if (itr == m_cachedChats.end()) {
+        return std::nullopt;
+    }
+
+    auto cachedChat = std::move(*itr);
+    m_cachedChats.erase(itr);
+
+    disconnect(cachedChat.accountConnectedConnection);
+
+    return cachedChat;
+}
+
+void ChatController::removeCachedChats(const std::function<bool(const CachedChat &)> &shouldBeRemoved)
+{
+    m_cachedChats.removeIf([&shouldBeRemoved](CachedChat &cachedChat) {
+        if (shouldBeRemoved(cachedChat)) {
+            discardCachedChat(cachedChat);
+            return true;
+        }
+
+        return false;
+    });
+}
+
+void ChatController::discardCachedChat(CachedChat &cachedChat)
+{
+    disconnect(cachedChat.accountConnectedConnection);
+
+    cachedChat.messageModel->removeAllMessages();
+    cachedChat.messageModel->deleteLater();
+}
+
 #include "moc_ChatController.cpp"
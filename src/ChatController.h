@@ -10,6 +10,9 @@
 
 #pragma once
 
+// std
+#include <functional>
+#include <optional>
 // Kaidan
 #include "RosterItemWatcher.h"
 
@@ -95,10 +98,32 @@ public:
     Q_SIGNAL void messageBodyToForwardChanged();
 
 private:
+    /**
+     * State of a recently opened chat that is kept in memory while another chat is open.
+     *
+     * That way, switching back to the chat does not require loading its messages, group chat users
+     * and encryption devices again.
+     * The message model stays connected to the database and is thus kept up to date while cached.
+     */
+    struct CachedChat {
+        QString accountJid;
+        QString jid;
+        MessageModel *messageModel;
+
+        // Empty if the group chat user JIDs changed while the chat was cached
+        std::optional<QList<QString>> groupChatUserJids;
+
+        // Whether the encryption was initialized since the account connected
+        bool encryptionInitialized;
+        QMetaObject::Connection accountConnectedConnection;
+    };
+
     void initializeEncryption();
+    void initializeChatEncryption(const QList<QString> &jids);
     bool hasUsableEncryptionDevices() const;
 
-    void initializeGroupChat();
+    void initializeGroupChat(const std::optional<QList<QString>> &cachedGroupChatUserJids);
+    void handleGroupChatUserJidsFetched(const QList<QString> &userJids);
     void updateGroupChatUserJids(const QString &accountJid, const QString &groupChatJid);
     void updateGroupChatEncryption();
     void setGroupChatUserJids(const QList<QString> &groupChatUserJids);
@@ -113,6 +138,22 @@ private:
 
     void resetPreviousChat();
 
+    /**
+     * Caches the state of the previously opened chat and evicts the least recently opened chats
+     * exceeding the cache limits.
+     */
+    void cachePreviousChat();
+
+    /**
+     * Removes the cached state of a chat from the cache.
+     *
+     * @return the cached state or nothing if the chat is not cached
+     */
+    std::optional<CachedChat> takeCachedChat(const QString &accountJid, const QString &jid);
+
+    void removeCachedChats(const std::function<bool(const CachedChat &)> &shouldBeRemoved);
+    static void discardCachedChat(CachedChat &cachedChat);
+
     Account *m_account = nullptr;
     QString m_jid;
 
@@ -131,7 +172,12 @@ private:
     MessageModel *m_messageModel = nullptr;
 
     QList<QString> m_groupChatUserJids;
+    bool m_groupChatUserJidsFetched = false;
+    bool m_encryptionInitialized = false;
     QString m_messageBodyToForward;
 
     QList<QMetaObject::Connection> m_connections;
+
+    // Recently opened chats ordered from the most to the least recently opened one
+    QList<CachedChat> m_cachedChats;
 };
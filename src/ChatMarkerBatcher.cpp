@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ChatMarkerBatcher.h"
+
+ChatMarkerBatcher::ChatMarkerBatcher(Flush &&flush, QObject *parent)
+    : ChatBatcher(std::chrono::milliseconds::zero(), parent)
+    , m_flush(std::move(flush))
+{
+}
+
+void ChatMarkerBatcher::addOwnMarker(const QString &chatJid, const QString &markedId, const QDateTime &timestamp)
+{
+    updateMarker(pendingMarkers(chatJid).ownMarker, markedId, timestamp);
+    addPendingChat(chatJid);
+}
+
+void ChatMarkerBatcher::addContactMarker(const QString &chatJid, const QString &markedId, const QDateTime &timestamp)
+{
+    updateMarker(pendingMarkers(chatJid).contactMarker, markedId, timestamp);
+    addPendingChat(chatJid);
+}
+
+void ChatMarkerBatcher::flushChat(const QString &chatJid)
+{
+    if (const auto markers = m_pendingMarkers.take(chatJid); !markers.chatJid.isEmpty()) {
+        m_flush(markers);
+    }
+}
+
+ChatMarkerBatcher::ChatMarkers &ChatMarkerBatcher::pendingMarkers(const QString &chatJid)
+{
+    auto itr = m_pendingMarkers.find(chatJid);
+
+    if (itr == m_pendingMarkers.end()) {
+        itr = m_pendingMarkers.insert(chatJid, ChatMarkers{.chatJid = chatJid});
+    }
+
+    return *itr;
+}
+
+void ChatMarkerBatcher::updateMarker(Marker &marker, const QString &markedId, const QDateTime &timestamp)
+{
+    // A marker received later but stamped earlier (e.g., a delayed one) does not override a newer
+    // one.
+    if (!marker.isValid() || !timestamp.isValid() || !marker.timestamp.isValid() || timestamp >= marker.timestamp) {
+        marker = {markedId, timestamp};
+    }
+}
+
+#include "moc_ChatMarkerBatcher.cpp"
@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+// std
+#include <functional>
+// Qt
+#include <QDateTime>
+#include <QHash>
+// Kaidan
+#include "ChatBatcher.h"
+
+/**
+ * Folds the read markers of each chat in memory and flushes them as one update per chat.
+ *
+ * Many markers for the same chat can arrive back to back (e.g., during MAM catch-up) while only the
+ * newest one is relevant.
+ * Thus, a marker only replaces a pending marker of the same chat and direction if it is not older
+ * (last writer wins by archive order).
+ * The pending markers are flushed once the event loop is entered again.
+ */
+class ChatMarkerBatcher : public ChatBatcher
+{
+    Q_OBJECT
+
+public:
+    struct Marker {
+        QString markedId;
+        QDateTime timestamp;
+
+        bool isValid() const
+        {
+            return !markedId.isEmpty();
+        }
+    };
+
+    struct ChatMarkers {
+        QString chatJid;
+
+        // Marker sent by the user for a contact's message
+        Marker ownMarker;
+
+        // Marker sent by a contact for an own message
+        Marker contactMarker;
+    };
+
+    using Flush = std::function<void(const ChatMarkers &markers)>;
+
+    ChatMarkerBatcher(Flush &&flush, QObject *parent = nullptr);
+
+    /**
+     * Adds a marker sent by the user (e.g., from another own device) for a contact's message.
+     */
+    void addOwnMarker(const QString &chatJid, const QString &markedId, const QDateTime &timestamp);
+
+    /**
+     * Adds a marker sent by a contact for an own message.
+     */
+    void addContactMarker(const QString &chatJid, const QString &markedId, const QDateTime &timestamp);
+
+protected:
+    void flushChat(const QString &chatJid) override;
+
+private:
+    ChatMarkers &pendingMarkers(const QString &chatJid);
+    static void updateMarker(Marker &marker, const QString &markedId, const QDateTime &timestamp);
+
+    const Flush m_flush;
+    QHash<QString, ChatMarkers> m_pendingMarkers;
+};
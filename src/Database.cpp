@@ -64,6 +64,14 @@ using namespace SqlUtils;
 
 #define SQL_ATTRIBUTE(name, dataType) SQL_LAST_ATTRIBUTE(name, dataType) ","
 
+// Creates the index used for listing group chat users page by page.
+// The expressions must match the ones used by GroupChatUserDb::users().
+static void createGroupChatUserIndexes(QSqlQuery &query)
+{
+    execQuery(query, QStringLiteral("CREATE INDEX groupChatUsers_order ON " DB_TABLE_GROUP_CHAT_USERS
+                                    " (accountJid, chatJid, status, IFNULL(name, ''), id, IFNULL(jid, ''))"));
+}
+
 class DbConnection;
 
 static QThreadStorage<DbConnection *> dbConnections;
@@ -396,7 +404,8 @@ void Database::createNewDatabase()
                                           SQL_ATTRIBUTE(readMarkerPending, SQL_BOOL) SQL_ATTRIBUTE(pinningPosition, SQL_INTEGER_NOT_NULL)
                                               SQL_ATTRIBUTE(chatStateSendingEnabled, SQL_BOOL) SQL_ATTRIBUTE(readMarkerSendingEnabled, SQL_BOOL)
                                                   SQL_ATTRIBUTE(notificationRule, SQL_INTEGER)
-                                                      SQL_ATTRIBUTE(automaticMediaDownloadsRule, SQL_INTEGER) "PRIMARY KEY(accountJid, jid)"));
+                                                      SQL_ATTRIBUTE(automaticMediaDownloadsRule, SQL_INTEGER)
+                                                          SQL_ATTRIBUTE(lastVCardCheckTimestamp, SQL_TEXT) "PRIMARY KEY(accountJid, jid)"));
     execQuery(query,
               SQL_CREATE_TABLE(DB_TABLE_ROSTER_GROUPS,
                                SQL_ATTRIBUTE(accountJid, SQL_TEXT_NOT_NULL) SQL_ATTRIBUTE(chatJid, SQL_TEXT_NOT_NULL)
@@ -432,6 +441,7 @@ void Database::createNewDatabase()
                                    SQL_ATTRIBUTE(jid, SQL_TEXT) SQL_ATTRIBUTE(name, SQL_TEXT)
                                        SQL_ATTRIBUTE(status, SQL_INTEGER) "PRIMARY KEY(accountJid, chatJid, id, jid),"
                                                                           "FOREIGN KEY(accountJid, chatJid) REFERENCES " DB_TABLE_CHATS " (accountJid, jid)"));
+    createGroupChatUserIndexes(query);
 
     // file sharing
     execQuery(query,
@@ -1846,6 +1856,14 @@ std::span<const Database::Migration> Database::migrations()
                                 )
                             )"));
          }},
+        {62,
+         [](QSqlQuery &query) {
+             createGroupChatUserIndexes(query);
+         }},
+        {63,
+         [](QSqlQuery &query) {
+             execQuery(query, QStringLiteral("ALTER TABLE " DB_TABLE_CHATS " ADD lastVCardCheckTimestamp " SQL_TEXT));
+         }},
     };
 
     static_assert(std::ranges::adjacent_find(MIGRATIONS, std::greater_equal{}, &Migration::version) == std::ranges::end(MIGRATIONS),
@@ -72,6 +72,18 @@ enum class DeliveryState {
 };
 Q_ENUM_NS(DeliveryState)
 
+/**
+ * Enumeration of text types determining how emojis are displayed
+ */
+enum class TextType {
+    // Not determined yet (e.g., for text being entered)
+    Unknown = -1,
+    Mixed,
+    SingleEmoji,
+    MultipleEmojis,
+};
+Q_ENUM_NS(TextType)
+
 template<typename T, ENABLE_IF(!has_enum_type<T>::value && std::is_enum<T>::value)>
 QString toString(const T flag)
 {
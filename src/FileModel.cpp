@@ -49,6 +49,7 @@ public:
 
 private:
     void handleMessageUpdated(Message message);
+    void handleFilesUpdated(const QList<MessageDb::FileUpdate> &updates);
 
     QString m_accountJid;
     QString m_chatJid;
@@ -60,6 +61,7 @@ FileTreeModel::FileTreeModel(QObject *parent)
     : QAbstractItemModel(parent)
 {
     connect(MessageDb::instance(), &MessageDb::messageUpdated, this, &FileTreeModel::handleMessageUpdated);
+    connect(MessageDb::instance(), &MessageDb::filesUpdated, this, &FileTreeModel::handleFilesUpdated);
 
     connect(&m_watcher, &QFutureWatcher<Messages>::finished, this, [this]() {
         setFiles(m_watcher.result());
@@ -255,6 +257,34 @@ void FileTreeModel::handleMessageUpdated(Message message)
     Q_EMIT layoutChanged({idx});
 }
 
+void FileTreeModel::handleFilesUpdated(const QList<MessageDb::FileUpdate> &updates)
+{
+    QHash<qint64, const MessageDb::FileUpdate *> updatesByFileId;
+    updatesByFileId.reserve(updates.size());
+
+    for (const auto &update : updates) {
+        updatesByFileId.insert(update.fileId, &update);
+    }
+
+    for (int i = 0; i < m_files.size() && !updatesByFileId.isEmpty(); ++i) {
+        auto &files = m_files[i].files;
+
+        for (int j = 0; j < files.size(); ++j) {
+            if (const auto update = updatesByFileId.take(files[j].id)) {
+                auto &file = files[j];
+                file.transferState = update->transferState;
+
+                if (update->localFilePath) {
+                    file.localFilePath = *update->localFilePath;
+                }
+
+                const auto idx = createIndex(j, 0, static_cast<quintptr>(i));
+                Q_EMIT dataChanged(idx, idx);
+            }
+        }
+    }
+}
+
 FileModel::FileModel(QObject *parent)
     : KDescendantsProxyModel(parent)
     , m_sourceModel(new FileTreeModel(this))
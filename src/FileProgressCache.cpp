@@ -5,6 +5,9 @@
 
 #include "FileProgressCache.h"
 
+// Kaidan
+#include "Globals.h"
+
 FileProgressWatcher::FileProgressWatcher(QObject *parent)
     : QObject(parent)
 {
@@ -38,7 +41,14 @@ void FileProgressWatcher::notify(const std::optional<FileProgress> &value)
     Q_EMIT progressChanged();
 }
 
-FileProgressCache::FileProgressCache() = default;
+FileProgressCache::FileProgressCache()
+{
+    m_notificationTimer.setSingleShot(true);
+    m_notificationTimer.setInterval(FILE_PROGRESS_NOTIFICATION_INTERVAL);
+    QObject::connect(&m_notificationTimer, &QTimer::timeout, [this]() {
+        notifyWatchersOfUpdatedProgress();
+    });
+}
 
 FileProgressCache &FileProgressCache::instance()
 {
@@ -58,15 +68,44 @@ std::optional<FileProgress> FileProgressCache::progress(qint64 fileId)
 void FileProgressCache::reportProgress(qint64 fileId, const FileProgress &progress)
 {
     m_files.insert_or_assign(fileId, progress);
+    m_updatedFileIds.erase(fileId);
     FileProgressNotifier::instance().notifyWatchers(fileId, progress);
 }
 
+void FileProgressCache::updateProgress(qint64 fileId, quint64 bytesSent, quint64 bytesTotal, float progress)
+{
+    if (auto itr = m_files.find(fileId); itr != m_files.end()) {
+        auto &fileProgress = itr->second;
+        fileProgress.bytesSent = bytesSent;
+        fileProgress.bytesTotal = bytesTotal;
+        fileProgress.progress = progress;
+
+        m_updatedFileIds.insert(fileId);
+
+        if (!m_notificationTimer.isActive()) {
+            m_notificationTimer.start();
+        }
+    }
+}
+
 void FileProgressCache::reportFinished(qint64 fileId)
 {
     m_files.erase(fileId);
+    m_updatedFileIds.erase(fileId);
     FileProgressNotifier::instance().notifyWatchers(fileId, {});
 }
 
+void FileProgressCache::notifyWatchersOfUpdatedProgress()
+{
+    const auto updatedFileIds = std::exchange(m_updatedFileIds, {});
+
+    for (const auto fileId : updatedFileIds) {
+        if (auto itr = m_files.find(fileId); itr != m_files.end()) {
+            FileProgressNotifier::instance().notifyWatchers(fileId, itr->second);
+        }
+    }
+}
+
 void FileProgressCache::cancelTransfers(const QString &accountJid)
 {
     const auto files = m_files;
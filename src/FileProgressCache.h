@@ -5,8 +5,11 @@
 
 #pragma once
 
+// std
+#include <unordered_set>
 // Qt
 #include <QObject>
+#include <QTimer>
 // Kaidan
 #include "AbstractNotifier.h"
 
@@ -72,7 +75,24 @@ public:
     static FileProgressCache &instance();
 
     std::optional<FileProgress> progress(qint64 fileId);
+
+    /**
+     * Sets the progress of a transfer and notifies its watchers immediately.
+     */
     void reportProgress(qint64 fileId, const FileProgress &progress);
+
+    /**
+     * Updates the transferred bytes of a running transfer.
+     *
+     * Transfers can report their progress very often.
+     * Thus, the watchers are notified at most once per FILE_PROGRESS_NOTIFICATION_INTERVAL with the
+     * latest progress.
+     */
+    void updateProgress(qint64 fileId, quint64 bytesSent, quint64 bytesTotal, float progress);
+
+    /**
+     * Removes the progress of a finished transfer and notifies its watchers immediately.
+     */
     void reportFinished(qint64 fileId);
 
     void cancelTransfers(const QString &jid);
@@ -80,5 +100,9 @@ public:
 private:
     FileProgressCache();
 
+    void notifyWatchersOfUpdatedProgress();
+
     std::unordered_map<qint64, FileProgress> m_files;
+    std::unordered_set<qint64> m_updatedFileIds;
+    QTimer m_notificationTimer;
 };
@@ -14,6 +14,7 @@
 #include <QNetworkReply>
 #include <QStandardPaths>
 #include <QStringBuilder>
+#include <QTimer>
 // KDE
 #include <KFileUtils>
 // QXmpp
@@ -33,6 +34,7 @@
 #include "Account.h"
 #include "Algorithms.h"
 #include "FileProgressCache.h"
+#include "Globals.h"
 #include "KaidanCoreLog.h"
 #include "MainController.h"
 #include "MediaUtils.h"
@@ -157,11 +159,19 @@ FileSharingController::FileSharingController(AccountSettings *accountSettings, C
     , m_connection(connection)
     , m_clientController(clientController)
     , m_manager(clientController->fileSharingManager())
+    , m_downloadScheduler(MAX_PARALLEL_FILE_DOWNLOAD_COUNT)
+    , m_completedDownloadsTimer(new QTimer(this))
 {
+    m_completedDownloadsTimer->setSingleShot(true);
+    m_completedDownloadsTimer->setInterval(COMPLETED_DOWNLOADS_STORING_INTERVAL);
+    m_completedDownloadsTimer->callOnTimeout(this, &FileSharingController::storeCompletedDownloads);
+
     connect(m_connection, &Connection::stateChanged, this, [this]() {
         if (m_connection->state() == Enums::ConnectionState::StateConnected) {
             downloadPendingFiles();
         } else if (m_connection->state() == Enums::ConnectionState::StateDisconnected) {
+            // Queued downloads are pending and enqueued again once connected.
+            m_downloadScheduler.clear();
             FileProgressCache::instance().cancelTransfers(m_accountSettings->jid());
         }
     });
@@ -169,6 +179,11 @@ FileSharingController::FileSharingController(AccountSettings *accountSettings, C
     connect(MessageDb::instance(), &MessageDb::messageAdded, this, &FileSharingController::handleMessageAdded);
 }
 
+FileSharingController::~FileSharingController()
+{
+    storeCompletedDownloads();
+}
+
 void FileSharingController::sendPendingFiles(const QString &chatJid, const QString &messageId, const QList<File> &files, bool encrypt)
 {
     join(transform(files, [this, chatJid, messageId, encrypt](const auto &file) {
@@ -198,22 +213,50 @@ void FileSharingController::sendFile(const QString &chatJid, const QString &mess
 }
 
 void FileSharingController::downloadFile(const QString &chatJid, const QString &messageId, const File &file)
+{
+    scheduleDownload(chatJid, messageId, file, DownloadPriority::UserRequested);
+}
+
+void FileSharingController::prioritizeDownload(const File &file)
+{
+    // Downloads requested by the user keep their priority.
+    if (m_downloadScheduler.priority(file.id) == DownloadPriority::Normal) {
+        m_downloadScheduler.setPriority(file.id, DownloadPriority::Visible);
+    }
+}
+
+void FileSharingController::deprioritizeDownload(const File &file)
+{
+    if (m_downloadScheduler.priority(file.id) == DownloadPriority::Visible) {
+        m_downloadScheduler.setPriority(file.id, DownloadPriority::Normal);
+    }
+}
+
+void FileSharingController::setOpenChatJid(const QString &chatJid)
+{
+    m_downloadScheduler.setPreferredGroup(chatJid);
+}
+
+void FileSharingController::scheduleDownload(const QString &chatJid, const QString &messageId, const File &file, DownloadPriority priority)
+{
+    m_downloadScheduler.enqueue(
+        file.id,
+        priority,
+        [this, chatJid, messageId, file]() {
+            return startDownload(chatJid, messageId, file);
+        },
+        chatJid);
+}
+
+QFuture<void> FileSharingController::startDownload(const QString &chatJid, const QString &messageId, const File &file)
 {
     const auto accountJid = m_accountSettings->jid();
     const auto fileId = file.id;
 
     if (m_connection->state() != Enums::ConnectionState::StateConnected) {
-        MessageDb::instance()->updateMessage(accountJid, chatJid, messageId, [fileId = file.id](Message &message) {
-            auto file = find_if(message.files, [fileId](const auto &file) {
-                return file.id == fileId;
-            });
-
-            if (file != message.files.end()) {
-                file->transferState = File::TransferState::Pending;
-            }
-        });
+        MessageDb::instance()->updateFiles({{fileId, File::TransferState::Pending}});
 
-        return;
+        return QtFuture::makeReadyVoidFuture();
     }
 
     const auto fileShare = file.toQXmpp();
@@ -256,18 +299,13 @@ void FileSharingController::downloadFile(const QString &chatJid, const QString &
 
     if (!output->open(QIODevice::WriteOnly)) {
         qCDebug(KAIDAN_CORE_LOG) << "Failed to open output file at" << filePath;
-        return;
+        return QtFuture::makeReadyVoidFuture();
     }
 
-    MessageDb::instance()->updateMessage(accountJid, chatJid, messageId, [fileId](Message &message) {
-        auto file = find_if(message.files, [fileId](const auto &file) {
-            return file.id == fileId;
-        });
+    MessageDb::instance()->updateFiles({{fileId, File::TransferState::Transferring}});
 
-        if (file != message.files.end()) {
-            file->transferState = File::TransferState::Transferring;
-        }
-    });
+    auto promise = std::make_shared<QPromise<void>>();
+    promise->start();
 
     auto download = m_manager->downloadFile(fileShare, std::move(output));
     std::weak_ptr<QXmppFileDownload> downloadPtr = download;
@@ -287,18 +325,11 @@ void FileSharingController::downloadFile(const QString &chatJid, const QString &
 
     connect(download.get(), &QXmppFileDownload::progressChanged, this, [fileId, downloadPtr]() {
         if (auto download = downloadPtr.lock()) {
-            auto progress = FileProgressCache::instance().progress(fileId);
-            Q_ASSERT(progress);
-
-            progress->bytesSent = download->bytesTransferred();
-            progress->bytesTotal = download->bytesTotal();
-            progress->progress = download->progress();
-
-            FileProgressCache::instance().reportProgress(fileId, *progress);
+            FileProgressCache::instance().updateProgress(fileId, download->bytesTransferred(), download->bytesTotal(), download->progress());
         }
     });
 
-    connect(download.get(), &QXmppFileDownload::finished, this, [this, accountJid, chatJid, messageId, fileId, filePath, download]() mutable {
+    connect(download.get(), &QXmppFileDownload::finished, this, [this, chatJid, messageId, fileId, filePath, download, promise]() mutable {
         auto result = download->result();
         auto error = [&result]() -> std::optional<QXmppError> {
             if (std::holds_alternative<QXmpp::Cancelled>(result)) {
@@ -311,21 +342,11 @@ void FileSharingController::downloadFile(const QString &chatJid, const QString &
         }();
 
         if (std::holds_alternative<QXmppFileDownload::Downloaded>(result)) {
-            MessageDb::instance()->updateMessage(accountJid, chatJid, messageId, [fileId, filePath](Message &message) {
-                auto file = find_if(message.files, [fileId](const auto &file) {
-                    return file.id == fileId;
-                });
+            // The message's error is reset by MessageDb once all of its files are downloaded.
+            addCompletedDownload(fileId, filePath);
 
-                if (file != message.files.end()) {
-                    file->localFilePath = filePath;
-                    file->transferState = File::TransferState::Done;
-                }
-
-                resetError(message);
-
-                // TODO: generate possibly missing metadata
-                // metadata may be missing if the sender only used out of band urls
-            });
+            // TODO: generate possibly missing metadata
+            // metadata may be missing if the sender only used out of band urls
         } else if (error) {
             auto progress = FileProgressCache::instance().progress(fileId);
             Q_ASSERT(progress);
@@ -344,29 +365,46 @@ void FileSharingController::downloadFile(const QString &chatJid, const QString &
         FileProgressCache::instance().reportFinished(fileId);
         // reduce ref count
         download.reset();
+
+        promise->finish();
     });
+
+    return promise->future();
 }
 
-void FileSharingController::cancelTransfer(const QString &chatJid, const QString &messageId, const File &file)
+void FileSharingController::addCompletedDownload(qint64 fileId, const QString &filePath)
 {
-    auto progress = FileProgressCache::instance().progress(file.id);
+    m_completedDownloads.append({fileId, File::TransferState::Done, filePath});
 
-    if (progress && progress->cancel) {
-        progress->canceledByUser = true;
-        FileProgressCache::instance().reportProgress(file.id, *progress);
+    if (!m_completedDownloadsTimer->isActive()) {
+        m_completedDownloadsTimer->start();
+    }
+}
 
-        progress->cancel();
-    } else {
-        MessageDb::instance()->updateMessage(m_accountSettings->jid(), chatJid, messageId, [fileId = file.id](Message &message) {
-            auto file = find_if(message.files, [fileId](const auto &file) {
-                return file.id == fileId;
-            });
+void FileSharingController::storeCompletedDownloads()
+{
+    m_completedDownloadsTimer->stop();
 
-            if (file != message.files.end()) {
-                file->transferState = File::TransferState::CanceledByUser;
-            }
-        });
+    // The database may already be closed while quitting.
+    if (auto *messageDb = MessageDb::instance(); messageDb && !m_completedDownloads.isEmpty()) {
+        messageDb->updateFiles(std::exchange(m_completedDownloads, {}));
+    }
+}
+
+void FileSharingController::cancelTransfer(const QString &, const QString &, const File &file)
+{
+    // A queued download is canceled before it is started.
+    if (!m_downloadScheduler.cancel(file.id)) {
+        if (auto progress = FileProgressCache::instance().progress(file.id); progress && progress->cancel) {
+            progress->canceledByUser = true;
+            FileProgressCache::instance().reportProgress(file.id, *progress);
+
+            progress->cancel();
+            return;
+        }
     }
+
+    MessageDb::instance()->updateFiles({MessageDb::FileUpdate{file.id, File::TransferState::CanceledByUser}});
 }
 
 QFuture<bool> FileSharingController::sendFileTask(const QString &chatJid, const QString &messageId, const File &file, bool encrypt)
@@ -394,15 +432,7 @@ QFuture<bool> FileSharingController::sendFileTask(const QString &chatJid, const
     auto provider = encrypt ? std::static_pointer_cast<QXmppFileSharingProvider>(m_clientController->encryptedHttpFileSharingProvider())
                             : std::static_pointer_cast<QXmppFileSharingProvider>(m_clientController->httpFileSharingProvider());
 
-    MessageDb::instance()->updateMessage(accountJid, chatJid, messageId, [fileId = file.id](Message &message) {
-        auto file = find_if(message.files, [fileId](const auto &file) {
-            return file.id == fileId;
-        });
-
-        if (file != message.files.end()) {
-            file->transferState = File::TransferState::Transferring;
-        }
-    });
+    MessageDb::instance()->updateFiles({{file.id, File::TransferState::Transferring}});
 
     auto upload = m_manager->uploadFile(provider, file.localFilePath, file.description);
     std::weak_ptr<QXmppFileUpload> uploadPtr = upload;
@@ -420,16 +450,9 @@ QFuture<bool> FileSharingController::sendFileTask(const QString &chatJid, const
                                                      },
                                                  });
 
-    connect(upload.get(), &QXmppFileUpload::progressChanged, this, [file, uploadPtr] {
+    connect(upload.get(), &QXmppFileUpload::progressChanged, this, [fileId = file.id, uploadPtr] {
         if (auto upload = uploadPtr.lock()) {
-            auto progress = FileProgressCache::instance().progress(file.id);
-            Q_ASSERT(progress);
-
-            progress->bytesSent = upload->bytesTransferred();
-            progress->bytesTotal = upload->bytesTotal();
-            progress->progress = upload->progress();
-
-            FileProgressCache::instance().reportProgress(file.id, *progress);
+            FileProgressCache::instance().updateProgress(fileId, upload->bytesTransferred(), upload->bytesTotal(), upload->progress());
         }
     });
 
@@ -558,7 +581,7 @@ void FileSharingController::downloadPendingFiles()
 {
     MessageDb::instance()->fetchAutomaticallyDownloadableFiles(m_accountSettings->jid()).then(this, [this](QList<MessageDb::DownloadableFile> &&files) {
         for (MessageDb::DownloadableFile &file : files) {
-            downloadFile(file.chatJid, file.messageId, file.file);
+            scheduleDownload(file.chatJid, file.messageId, file.file, DownloadPriority::Normal);
         }
     });
 }
@@ -585,15 +608,13 @@ void FileSharingController::handleMessageAdded(const Message &message, MessageOr
         if (RosterModel::instance()->item(message.accountJid, message.chatJid)->automaticDownloadsEnabled()) {
             for (const auto &file : message.files) {
                 if (file.localFilePath.isEmpty() || !QFile::exists(file.localFilePath)) {
-                    downloadFile(message.chatJid, message.id, file);
+                    scheduleDownload(message.chatJid, message.id, file, DownloadPriority::Normal);
                 }
             }
         } else {
-            MessageDb::instance()->updateMessage(message.accountJid, message.chatJid, message.referenceId(), [](Message &message) {
-                for (auto &file : message.files) {
-                    file.transferState = File::TransferState::Done;
-                }
-            });
+            MessageDb::instance()->updateFiles(transform(message.files, [](const File &file) {
+                return MessageDb::FileUpdate{file.id, File::TransferState::Done};
+            }));
         }
     }
 }
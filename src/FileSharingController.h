@@ -12,6 +12,8 @@
 #include <QXmppHttpUploadManager.h>
 #include <QXmppTask.h>
 // Kaidan
+#include "MessageDb.h"
+#include "PriorityScheduler.h"
 #include <Message.h>
 
 class AccountSettings;
@@ -19,6 +21,7 @@ class ClientController;
 class Connection;
 struct File;
 struct FileProgress;
+class QTimer;
 class QXmppClient;
 class Message;
 
@@ -31,6 +34,7 @@ public:
     using UploadResult = std::tuple<qint64, QXmppFileUpload::Result>;
 
     FileSharingController(AccountSettings *accountSettings, Connection *connection, ClientController *clientController, QObject *parent = nullptr);
+    ~FileSharingController() override;
 
     void sendPendingFiles(const QString &chatJid, const QString &messageId, const QList<File> &files, bool encrypt);
     Q_SIGNAL void filesUploadedForPendingMessage(const Message &message);
@@ -39,7 +43,47 @@ public:
     Q_INVOKABLE void downloadFile(const QString &chatJid, const QString &messageId, const File &file);
     Q_INVOKABLE void cancelTransfer(const QString &chatJid, const QString &messageId, const File &file);
 
+    /**
+     * Downloads a file before other files waiting to be automatically downloaded.
+     *
+     * That is used for files that are visible to the user.
+     */
+    Q_INVOKABLE void prioritizeDownload(const File &file);
+
+    /**
+     * Downloads a file in its normal order after it is not visible to the user anymore.
+     *
+     * Downloads requested by the user are not affected.
+     */
+    Q_INVOKABLE void deprioritizeDownload(const File &file);
+
+    /**
+     * Sets the JID of the open chat whose files are downloaded before the ones of other chats.
+     */
+    void setOpenChatJid(const QString &chatJid);
+
 private:
+    enum class DownloadPriority {
+        Normal,
+        Visible,
+        UserRequested,
+    };
+
+    /**
+     * Enqueues a download.
+     *
+     * Downloads of the same priority are started for the open chat before the ones for other chats.
+     */
+    void scheduleDownload(const QString &chatJid, const QString &messageId, const File &file, DownloadPriority priority);
+    QFuture<void> startDownload(const QString &chatJid, const QString &messageId, const File &file);
+
+    /**
+     * Adds a downloaded file to be stored together with the other files downloaded within
+     * COMPLETED_DOWNLOADS_STORING_INTERVAL.
+     */
+    void addCompletedDownload(qint64 fileId, const QString &filePath);
+    void storeCompletedDownloads();
+
     QFuture<bool> sendFileTask(const QString &chatJid, const QString &messageId, const File &file, bool encrypt);
     void maybeSendPendingMessage(const QString &chatJid, const QString &messageId);
     static void resetError(Message &message);
@@ -60,5 +104,8 @@ private:
     Connection *const m_connection;
     ClientController *const m_clientController;
     QXmppFileSharingManager *const m_manager;
+    PriorityScheduler<qint64, DownloadPriority> m_downloadScheduler;
+    QTimer *const m_completedDownloadsTimer;
+    QList<MessageDb::FileUpdate> m_completedDownloads;
     QXmppHttpUploadManager::Support m_uploadSupport;
 };
@@ -8,6 +8,8 @@
 
 #pragma once
 
+// std
+#include <chrono>
 // Qt
 #include <QLatin1String>
 #include <QObject>
@@ -123,6 +125,26 @@ constexpr auto THUMBNAIL_EDGE_PIXEL_COUNT = 30;
 // Width and height of generated video thumbnails.
 constexpr auto VIDEO_THUMBNAIL_EDGE_PIXEL_COUNT = 500;
 
+// Maximum number of files downloaded in parallel per account.
+constexpr int MAX_PARALLEL_FILE_DOWNLOAD_COUNT = 3;
+
+// Maximum number of vCards requested in parallel per account.
+constexpr int MAX_PARALLEL_VCARD_REQUEST_COUNT = 5;
+
+// Interval after which the vCard of a contact without presence is requested again.
+constexpr auto VCARD_CHECK_INTERVAL = std::chrono::hours(24);
+
+// Maximum number of recently opened chats whose state is kept in memory while another chat is open.
+constexpr int MAX_CACHED_CHAT_COUNT = 5;
+// Maximum number of messages kept in memory for all cached chats together.
+constexpr int MAX_CACHED_CHAT_MESSAGE_COUNT = 2000;
+
+// Minimum interval between two notifications about the progress of a file transfer.
+constexpr auto FILE_PROGRESS_NOTIFICATION_INTERVAL = std::chrono::milliseconds(100);
+
+// Interval during which completed downloads are collected to be stored together.
+constexpr auto COMPLETED_DOWNLOADS_STORING_INTERVAL = std::chrono::milliseconds(200);
+
 // Count of encryption key ID characters that are grouped to be displayed for better readability
 constexpr int ENCRYPTION_KEY_ID_CHARACTER_GROUP_SIZE = 8;
 
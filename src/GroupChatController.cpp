@@ -27,6 +27,11 @@ GroupChatController::GroupChatController(AccountSettings *accountSettings,
     , m_mucController(new MucController(accountSettings, this, messageController, mucManager, bookmarkManager, this))
 {
     connect(RosterDb::instance(), &RosterDb::itemAdded, this, &GroupChatController::requestGroupChatData);
+    connect(RosterDb::instance(), &RosterDb::itemsChanged, this, [this](const QString &, const QList<RosterItem> &addedItems) {
+        for (const auto &item : addedItems) {
+            requestGroupChatData(item);
+        }
+    });
     connect(RosterModel::instance(), &RosterModel::itemAdded, this, &GroupChatController::handleRosterItemAdded);
 
     connect(this, &GroupChatController::groupChatMadePrivate, this, [this](const QString &groupChatJid) {
@@ -42,9 +47,11 @@ GroupChatController::GroupChatController(AccountSettings *accountSettings,
     });
 
     connect(this, &GroupChatController::userAllowedOrBanned, GroupChatUserDb::instance(), &GroupChatUserDb::handleUserAllowedOrBanned);
+    connect(this, &GroupChatController::usersAllowedOrBanned, GroupChatUserDb::instance(), &GroupChatUserDb::handleUsersAllowedOrBanned);
     connect(this, &GroupChatController::userDisallowedOrUnbanned, GroupChatUserDb::instance(), &GroupChatUserDb::handleUserDisallowedOrUnbanned);
 
     connect(this, &GroupChatController::participantReceived, GroupChatUserDb::instance(), &GroupChatUserDb::handleParticipantReceived);
+    connect(this, &GroupChatController::participantsReceived, GroupChatUserDb::instance(), &GroupChatUserDb::handleParticipantsReceived);
     connect(this, &GroupChatController::participantLeft, GroupChatUserDb::instance(), &GroupChatUserDb::handleParticipantLeft);
 
     connect(this, &GroupChatController::groupChatLeft, GroupChatUserDb::instance(), qOverload<const QString &>(&GroupChatUserDb::removeUsers));
@@ -91,8 +91,10 @@ public:
 
     Q_SIGNAL void userDisallowedOrUnbanned(const GroupChatUser &user);
     Q_SIGNAL void userAllowedOrBanned(const GroupChatUser &user);
+    Q_SIGNAL void usersAllowedOrBanned(const QList<GroupChatUser> &users);
 
     Q_SIGNAL void participantReceived(const GroupChatUser &participant);
+    Q_SIGNAL void participantsReceived(const QList<GroupChatUser> &participants);
     Q_SIGNAL void participantLeft(const GroupChatUser &participant);
 
 private:
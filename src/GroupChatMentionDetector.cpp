@@ -0,0 +1,150 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "GroupChatMentionDetector.h"
+
+// Kaidan
+#include "GroupChatUserDb.h"
+#include "RosterDb.h"
+
+GroupChatMentionDetector::GroupChatMentionDetector(QObject *parent)
+    : QObject(parent)
+{
+    connect(GroupChatUserDb::instance(), &GroupChatUserDb::userAdded, this, &GroupChatMentionDetector::handleUserUpdated);
+    connect(GroupChatUserDb::instance(), &GroupChatUserDb::userUpdated, this, &GroupChatMentionDetector::handleUserUpdated);
+    connect(GroupChatUserDb::instance(), &GroupChatUserDb::userRemoved, this, &GroupChatMentionDetector::handleUserRemoved);
+    connect(GroupChatUserDb::instance(),
+            &GroupChatUserDb::usersChanged,
+            this,
+            [this](const QList<GroupChatUser> &addedUsers, const QList<GroupChatUser> &updatedUsers) {
+                for (const auto &user : addedUsers) {
+                    handleUserUpdated(user);
+                }
+
+                for (const auto &user : updatedUsers) {
+                    handleUserUpdated(user);
+                }
+            });
+
+    // The users of a group chat are removed together with its roster item.
+    connect(RosterDb::instance(), &RosterDb::itemRemoved, this, [this](const QString &accountJid, const QString &jid) {
+        removeOwnParticipants(accountJid, {jid});
+    });
+    connect(RosterDb::instance(),
+            &RosterDb::itemsChanged,
+            this,
+            [this](const QString &accountJid, const QList<RosterItem> &, const QList<RosterItem> &, const QList<QString> &removedJids) {
+                removeOwnParticipants(accountJid, removedJids);
+            });
+    connect(RosterDb::instance(), &RosterDb::itemsRemoved, this, qOverload<const QString &>(&GroupChatMentionDetector::removeOwnParticipants));
+}
+
+void GroupChatMentionDetector::checkMention(const QString &accountJid,
+                                            const QString &chatJid,
+                                            const QString &ownParticipantId,
+                                            const QString &body,
+                                            Mentioned &&mentioned)
+{
+    auto itr = m_ownParticipants.find(ChatKey{accountJid, chatJid});
+
+    // The own participant changes when the group chat is joined again.
+    if (itr == m_ownParticipants.end() || itr->id != ownParticipantId) {
+        itr = m_ownParticipants.insert(ChatKey{accountJid, chatJid}, OwnParticipant{.id = ownParticipantId});
+        requestOwnParticipant(accountJid, chatJid, ownParticipantId);
+    }
+
+    if (itr->loaded) {
+        check(itr->matcher, body, mentioned);
+    } else {
+        itr->pendingChecks.append({body, std::move(mentioned)});
+    }
+}
+
+void GroupChatMentionDetector::requestOwnParticipant(const QString &accountJid, const QString &chatJid, const QString &ownParticipantId)
+{
+    GroupChatUserDb::instance()
+        ->user(accountJid, chatJid, ownParticipantId)
+        .then(this, [this, chatKey = ChatKey{accountJid, chatJid}, ownParticipantId](const std::optional<GroupChatUser> &user) {
+            auto itr = m_ownParticipants.find(chatKey);
+
+            // Skip outdated results.
+            if (itr == m_ownParticipants.end() || itr->id != ownParticipantId) {
+                return;
+            }
+
+            // The participant may have been updated in the meantime.
+            if (!itr->loaded) {
+                itr->loaded = true;
+                itr->matcher = user ? createMatcher(*user) : std::nullopt;
+            }
+
+            const auto matcher = itr->matcher;
+            const auto pendingChecks = std::move(itr->pendingChecks);
+            itr->pendingChecks.clear();
+
+            for (const auto &pendingCheck : pendingChecks) {
+                check(matcher, pendingCheck.body, pendingCheck.mentioned);
+            }
+        });
+}
+
+void GroupChatMentionDetector::handleUserUpdated(const GroupChatUser &user)
+{
+    if (auto itr = m_ownParticipants.find(ChatKey{user.accountJid, user.chatJid}); itr != m_ownParticipants.end() && itr->id == user.id) {
+        itr->loaded = true;
+        itr->matcher = createMatcher(user);
+    }
+}
+
+void GroupChatMentionDetector::handleUserRemoved(const GroupChatUser &user)
+{
+    if (auto itr = m_ownParticipants.find(ChatKey{user.accountJid, user.chatJid}); itr != m_ownParticipants.end() && itr->id == user.id) {
+        itr->loaded = true;
+        itr->matcher.reset();
+    }
+}
+
+void GroupChatMentionDetector::removeOwnParticipants(const QString &accountJid, const QList<QString> &chatJids)
+{
+    for (const auto &chatJid : chatJids) {
+        m_ownParticipants.remove(ChatKey{accountJid, chatJid});
+    }
+}
+
+void GroupChatMentionDetector::removeOwnParticipants(const QString &accountJid)
+{
+    m_ownParticipants.removeIf([&accountJid](const auto &ownParticipant) {
+        return ownParticipant.key().first == accountJid;
+    });
+}
+
+void GroupChatMentionDetector::check(const std::optional<QRegularExpression> &matcher, const QString &body, const Mentioned &mentioned)
+{
+    if (matcher && body.contains(*matcher)) {
+        mentioned();
+    }
+}
+
+std::optional<QRegularExpression> GroupChatMentionDetector::createMatcher(const GroupChatUser &user)
+{
+    QList<QString> alternatives;
+
+    // Empty values are skipped because they would match every message.
+    for (const auto &value : {user.id, user.jid, user.name}) {
+        if (!value.isEmpty()) {
+            alternatives.append(QRegularExpression::escape(value));
+        }
+    }
+
+    if (alternatives.isEmpty()) {
+        return std::nullopt;
+    }
+
+    QRegularExpression matcher(alternatives.join(u'|'));
+    matcher.optimize();
+
+    return matcher;
+}
+
+#include "moc_GroupChatMentionDetector.cpp"
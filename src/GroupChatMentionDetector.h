@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+// std
+#include <functional>
+#include <optional>
+// Qt
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QRegularExpression>
+
+struct GroupChatUser;
+
+/**
+ * Detects whether messages of group chats mention the user.
+ *
+ * The user's own participant of each group chat is retrieved from the database once and kept
+ * in memory as a precompiled matcher for its ID, JID and nickname.
+ * The cached participant is updated as soon as its stored data changes.
+ * It is removed once the group chat is removed (e.g., after leaving it or removing the account).
+ */
+class GroupChatMentionDetector : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Mentioned = std::function<void()>;
+
+    explicit GroupChatMentionDetector(QObject *parent = nullptr);
+
+    /**
+     * Checks whether a message body mentions the user's own participant.
+     *
+     * @param accountJid JID of the account
+     * @param chatJid JID of the group chat
+     * @param ownParticipantId ID of the user's own participant in the group chat
+     * @param body body of the message
+     * @param mentioned function called if the user is mentioned, possibly after the own
+     *        participant has been retrieved from the database
+     */
+    void checkMention(const QString &accountJid, const QString &chatJid, const QString &ownParticipantId, const QString &body, Mentioned &&mentioned);
+
+private:
+    struct PendingCheck {
+        QString body;
+        Mentioned mentioned;
+    };
+
+    struct OwnParticipant {
+        QString id;
+        bool loaded = false;
+
+        // Matcher for the participant's ID, JID and nickname or std::nullopt if the participant
+        // is not stored
+        std::optional<QRegularExpression> matcher;
+
+        // Checks waiting for the participant to be retrieved from the database
+        QList<PendingCheck> pendingChecks;
+    };
+
+    using ChatKey = std::pair<QString, QString>;
+
+    void requestOwnParticipant(const QString &accountJid, const QString &chatJid, const QString &ownParticipantId);
+    void handleUserUpdated(const GroupChatUser &user);
+    void handleUserRemoved(const GroupChatUser &user);
+    void removeOwnParticipants(const QString &accountJid, const QList<QString> &chatJids);
+    void removeOwnParticipants(const QString &accountJid);
+
+    static void check(const std::optional<QRegularExpression> &matcher, const QString &body, const Mentioned &mentioned);
+    static std::optional<QRegularExpression> createMatcher(const GroupChatUser &user);
+
+    QHash<ChatKey, OwnParticipant> m_ownParticipants;
+};
@@ -74,23 +74,56 @@ std::optional<GroupChatUser> GroupChatUserDb::_user(const QString &accountJid, c
     return users.constFirst();
 }
 
-QFuture<QList<GroupChatUser>> GroupChatUserDb::users(const QString &accountJid, const QString &chatJid, const int offset)
+QFuture<QList<GroupChatUser>>
+GroupChatUserDb::users(const QString &accountJid, const QString &chatJid, const std::optional<GroupChatUser> &lastUser, const QString &searchString)
 {
-    return run([this, accountJid, chatJid, offset]() {
+    return run([this, accountJid, chatJid, lastUser, searchString]() {
         auto query = createQuery();
         query.setForwardOnly(true);
 
-        QMap<QString, QVariant> keyValuePairs = {{ACCOUNT_JID.toString(), accountJid}, {CHAT_JID.toString(), chatJid}};
+        QString statement = QStringLiteral(R"(
+                                              SELECT groupChatUsers.*
+                                              FROM groupChatUsers
+                                          )");
+        QueryBindValues values = {
+            {u":accountJid", accountJid},
+            {u":chatJid", chatJid},
+            {u":limit", DB_QUERY_LIMIT_GROUP_CHAT_USERS},
+        };
+
+        // The names of the users' roster items are searched as well because they are displayed
+        // instead of the names provided by the group chat.
+        if (searchString.isEmpty()) {
+            statement += QStringLiteral(R"(
+                                           WHERE groupChatUsers.accountJid = :accountJid AND groupChatUsers.chatJid = :chatJid
+                                       )");
+        } else {
+            statement += QStringLiteral(R"(
+                                           LEFT JOIN chats ON chats.accountJid = groupChatUsers.accountJid AND chats.jid = groupChatUsers.jid
+                                           WHERE groupChatUsers.accountJid = :accountJid AND groupChatUsers.chatJid = :chatJid
+                                           AND (instr(lower(groupChatUsers.name), :searchString) OR instr(lower(groupChatUsers.jid), :searchString)
+                                                OR instr(lower(chats.name), :searchString))
+                                       )");
+            values.insert(u":searchString", searchString.toLower());
+        }
 
-        execQuery(query,
-                  QStringLiteral("SELECT * FROM " DB_TABLE_GROUP_CHAT_USERS) + simpleWhereStatement(&sqlDriver(), keyValuePairs)
-                      + QStringLiteral(" "
-                                       "ORDER BY ")
-                      + NAME.toString() + QStringLiteral(", ") + STATUS.toString()
-                      + QStringLiteral(" "
-                                       "LIMIT %1, %2")
-                            .arg(offset)
-                            .arg(DB_QUERY_LIMIT_GROUP_CHAT_USERS));
+        if (lastUser) {
+            statement += QStringLiteral(R"(
+                                           AND (groupChatUsers.status, IFNULL(groupChatUsers.name, ''), groupChatUsers.id, IFNULL(groupChatUsers.jid, ''))
+                                               > (:lastStatus, :lastName, :lastId, :lastJid)
+                                       )");
+            values.insert(u":lastStatus", static_cast<int>(lastUser->status));
+            values.insert(u":lastName", lastUser->name.isNull() ? QStringLiteral("") : lastUser->name);
+            values.insert(u":lastId", lastUser->id);
+            values.insert(u":lastJid", lastUser->jid.isNull() ? QStringLiteral("") : lastUser->jid);
+        }
+
+        statement += QStringLiteral(R"(
+                                       ORDER BY groupChatUsers.status, IFNULL(groupChatUsers.name, ''), groupChatUsers.id, IFNULL(groupChatUsers.jid, '')
+                                       LIMIT :limit
+                                   )");
+
+        execQuery(query, statement, values);
 
         QList<GroupChatUser> users;
         parseUsersFromQuery(query, users);
@@ -149,6 +182,59 @@ QFuture<void> GroupChatUserDb::handleUserAllowedOrBanned(const GroupChatUser &us
     });
 }
 
+QFuture<void> GroupChatUserDb::handleUsersAllowedOrBanned(const QList<GroupChatUser> &users)
+{
+    return run([this, users]() {
+        if (users.isEmpty()) {
+            return;
+        }
+
+        const auto accountJid = users.constFirst().accountJid;
+        const auto chatJid = users.constFirst().chatJid;
+
+        // Load the stored users once instead of probing the database for each user.
+        auto storedUsers = _users(accountJid, chatJid);
+        QHash<QString, qsizetype> storedUserIndexesByJid;
+
+        for (qsizetype i = 0; i < storedUsers.size(); ++i) {
+            if (const auto &jid = storedUsers.at(i).jid; !jid.isEmpty()) {
+                storedUserIndexesByJid.insert(jid, i);
+            }
+        }
+
+        QList<GroupChatUser> addedUsers;
+        QList<GroupChatUser> updatedUsers;
+
+        transaction();
+
+        for (const auto &user : users) {
+            Q_ASSERT(user.accountJid == accountJid && user.chatJid == chatJid);
+
+            // If there is a stored user with a different status, update that user.
+            // Otherwise, add a new entry.
+            if (const auto itr = storedUserIndexesByJid.constFind(user.jid); itr != storedUserIndexesByJid.cend()) {
+                if (auto &storedUser = storedUsers[*itr]; storedUser.status != user.status) {
+                    storedUser.status = user.status;
+                    _upsertUser(storedUser);
+                    updatedUsers.append(storedUser);
+                }
+            } else {
+                _upsertUser(user);
+                storedUserIndexesByJid.insert(user.jid, storedUsers.size());
+                storedUsers.append(user);
+                addedUsers.append(user);
+            }
+        }
+
+        commit();
+
+        if (!addedUsers.isEmpty() || !updatedUsers.isEmpty()) {
+            Q_EMIT usersChanged(addedUsers, updatedUsers);
+            Q_EMIT userJidsChanged(accountJid, chatJid);
+        }
+    });
+}
+
 QFuture<void> GroupChatUserDb::handleUserDisallowedOrUnbanned(const GroupChatUser &user)
 {
     return run([this, user]() {
@@ -216,6 +302,94 @@ QFuture<void> GroupChatUserDb::handleParticipantReceived(GroupChatUser participa
     });
 }
 
+QFuture<void> GroupChatUserDb::handleParticipantsReceived(const QList<GroupChatUser> &participants)
+{
+    return run([this, participants]() {
+        if (participants.isEmpty()) {
+            return;
+        }
+
+        const auto accountJid = participants.constFirst().accountJid;
+        const auto chatJid = participants.constFirst().chatJid;
+
+        // Load the stored users once instead of probing the database for each participant.
+        auto storedUsers = _users(accountJid, chatJid);
+        QHash<QString, qsizetype> storedUserIndexesById;
+        QHash<QString, qsizetype> storedUserIndexesByJid;
+
+        for (qsizetype i = 0; i < storedUsers.size(); ++i) {
+            const auto &storedUser = storedUsers.at(i);
+
+            if (!storedUser.id.isEmpty()) {
+                storedUserIndexesById.insert(storedUser.id, i);
+            }
+
+            if (!storedUser.jid.isEmpty()) {
+                storedUserIndexesByJid.insert(storedUser.jid, i);
+            }
+        }
+
+        QList<GroupChatUser> addedUsers;
+        QList<GroupChatUser> updatedUsers;
+
+        transaction();
+
+        for (auto participant : participants) {
+            Q_ASSERT(participant.accountJid == accountJid && participant.chatJid == chatJid);
+
+            participant.status = GroupChatUser::Status::Joined;
+
+            // If the participant was already joined but modified, update the former entry normally.
+            // If the participant was set as allowed to join but not yet joined, transform the former
+            // entry to a joined one.
+            // If the participant was not set as allowed before and joined now, add the participant.
+            auto storedUserIndex = storedUserIndexesById.value(participant.id, -1);
+            const auto foundById = storedUserIndex != -1;
+
+            if (!foundById && !participant.jid.isEmpty()) {
+                storedUserIndex = storedUserIndexesByJid.value(participant.jid, -1);
+            }
+
+            if (storedUserIndex != -1) {
+                auto &storedUser = storedUsers[storedUserIndex];
+                auto updatedUser = storedUser;
+
+                if (!foundById) {
+                    updatedUser.id = participant.id;
+                }
+
+                updatedUser.name = participant.name;
+                updatedUser.status = participant.status;
+
+                if (updatedUser != storedUser || updatedUser.id != storedUser.id) {
+                    _replaceUser(storedUser, updatedUser);
+                    storedUser = updatedUser;
+                    storedUserIndexesById.insert(updatedUser.id, storedUserIndex);
+                    updatedUsers.append(updatedUser);
+                }
+            } else {
+                _upsertUser(participant);
+
+                storedUserIndexesById.insert(participant.id, storedUsers.size());
+
+                if (!participant.jid.isEmpty()) {
+                    storedUserIndexesByJid.insert(participant.jid, storedUsers.size());
+                }
+
+                storedUsers.append(participant);
+                addedUsers.append(participant);
+            }
+        }
+
+        commit();
+
+        if (!addedUsers.isEmpty() || !updatedUsers.isEmpty()) {
+            Q_EMIT usersChanged(addedUsers, updatedUsers);
+            Q_EMIT userJidsChanged(accountJid, chatJid);
+        }
+    });
+}
+
 QFuture<void> GroupChatUserDb::handleParticipantLeft(const GroupChatUser &participant)
 {
     return run([this, participant]() {
@@ -301,6 +475,72 @@ void GroupChatUserDb::_removeUsers(const QString &accountJid, const QString &cha
     execQuery(query, QStringLiteral("DELETE FROM " DB_TABLE_GROUP_CHAT_USERS) + simpleWhereStatement(&sqlDriver(), keyValuePairs));
 }
 
+QList<GroupChatUser> GroupChatUserDb::_users(const QString &accountJid, const QString &chatJid)
+{
+    auto query = createQuery();
+    query.setForwardOnly(true);
+
+    QMap<QString, QVariant> keyValuePairs = {{ACCOUNT_JID.toString(), accountJid}, {CHAT_JID.toString(), chatJid}};
+
+    execQuery(query, QStringLiteral("SELECT * FROM " DB_TABLE_GROUP_CHAT_USERS) + simpleWhereStatement(&sqlDriver(), keyValuePairs));
+
+    QList<GroupChatUser> users;
+    parseUsersFromQuery(query, users);
+
+    return users;
+}
+
+void GroupChatUserDb::_upsertUser(const GroupChatUser &user)
+{
+    thread_local static auto query = [this]() {
+        auto query = createQuery();
+        prepareQuery(query, QStringLiteral(R"(
+                                              INSERT INTO groupChatUsers (accountJid, chatJid, id, jid, name, status)
+                                              VALUES (:accountJid, :chatJid, :id, :jid, :name, :status)
+                                              ON CONFLICT (accountJid, chatJid, id, jid) DO UPDATE SET
+                                                  name = excluded.name,
+                                                  status = excluded.status
+                                          )"));
+        return query;
+    }();
+
+    bindValues(query,
+               {
+                   {u":accountJid", user.accountJid},
+                   {u":chatJid", user.chatJid},
+                   {u":id", user.id},
+                   {u":jid", user.jid},
+                   {u":name", user.name},
+                   {u":status", static_cast<int>(user.status)},
+               });
+    execQuery(query);
+}
+
+void GroupChatUserDb::_replaceUser(const GroupChatUser &oldUser, const GroupChatUser &newUser)
+{
+    thread_local static auto query = [this]() {
+        auto query = createQuery();
+        prepareQuery(query, QStringLiteral(R"(
+                                              UPDATE groupChatUsers
+                                              SET id = :id, name = :name, status = :status
+                                              WHERE accountJid = :accountJid AND chatJid = :chatJid AND id = :oldId AND (:oldId != '' OR jid = :oldJid)
+                                          )"));
+        return query;
+    }();
+
+    bindValues(query,
+               {
+                   {u":accountJid", oldUser.accountJid},
+                   {u":chatJid", oldUser.chatJid},
+                   {u":oldId", oldUser.id},
+                   {u":oldJid", oldUser.jid},
+                   {u":id", newUser.id},
+                   {u":name", newUser.name},
+                   {u":status", static_cast<int>(newUser.status)},
+               });
+    execQuery(query);
+}
+
 void GroupChatUserDb::addUser(const GroupChatUser &user)
 {
     const auto accountJid = user.accountJid;
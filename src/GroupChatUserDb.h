@@ -37,13 +37,23 @@ public:
     std::optional<GroupChatUser> _user(const QString &accountJid, const QString &chatJid, const QString &participantId);
 
     /**
-     * Retrieves users.
+     * Retrieves users ordered by their status, name, ID and JID.
+     *
+     * Pages are retrieved via keyset pagination starting after the last user of the previous page.
+     * That way, the cost of retrieving a page does not depend on the number of preceding users.
+     *
+     * The order only determines which users are retrieved first.
+     * GroupChatUserModel sorts the retrieved users by their display names that may be the names
+     * of roster items.
      *
      * @param accountJid JID of the account
      * @param chatJid JID of the chat
-     * @param offset index of the first user being fetched (used for pagination, optional)
+     * @param lastUser last user of the previous page or std::nullopt to retrieve the first page
+     * @param searchString case-insensitive part of the names, JIDs or roster item names of the
+     *        users being retrieved (optional)
      */
-    QFuture<QList<GroupChatUser>> users(const QString &accountJid, const QString &chatJid, const int offset = 0);
+    QFuture<QList<GroupChatUser>>
+    users(const QString &accountJid, const QString &chatJid, const std::optional<GroupChatUser> &lastUser = std::nullopt, const QString &searchString = {});
 
     /**
      * Retrieves the bare JIDs of all group chat users.
@@ -62,6 +72,16 @@ public:
      */
     QFuture<void> handleUserAllowedOrBanned(const GroupChatUser &user);
 
+    /**
+     * Handles users that are allowed to participate or banned from participating in a specific
+     * group chat at once.
+     *
+     * All users are stored within one transaction and usersChanged() is emitted once.
+     *
+     * @param users allowed or banned users of the same group chat
+     */
+    QFuture<void> handleUsersAllowedOrBanned(const QList<GroupChatUser> &users);
+
     /**
      * Handles a user that is not allowed anymore to participate or not banned anymore from
      * participating in a specific group chat.
@@ -81,6 +101,17 @@ public:
      */
     QFuture<void> handleParticipantReceived(GroupChatUser participant);
 
+    /**
+     * Handles received participants at once.
+     *
+     * New participants are added and existing ones are updated like by
+     * handleParticipantReceived().
+     * All participants are stored within one transaction and usersChanged() is emitted once.
+     *
+     * @param participants new or updated participants of the same group chat
+     */
+    QFuture<void> handleParticipantsReceived(const QList<GroupChatUser> &participants);
+
     /**
      * Handles a left participant.
      *
@@ -104,6 +135,7 @@ public:
     Q_SIGNAL void userAdded(const GroupChatUser &user);
     Q_SIGNAL void userUpdated(const GroupChatUser &user);
     Q_SIGNAL void userRemoved(const GroupChatUser &user);
+    Q_SIGNAL void usersChanged(const QList<GroupChatUser> &addedUsers, const QList<GroupChatUser> &updatedUsers);
 
     /**
      * Removes all users of an account.
@@ -123,6 +155,31 @@ public:
     void _removeUsers(const QString &accountJid, const QString &chatJid);
 
 private:
+    /**
+     * Retrieves all users of a chat.
+     *
+     * @param accountJid JID of the account
+     * @param chatJid JID of the chat
+     */
+    QList<GroupChatUser> _users(const QString &accountJid, const QString &chatJid);
+
+    /**
+     * Inserts a user or updates the name and status of the user with the same key.
+     *
+     * @param user user being inserted or updated
+     */
+    void _upsertUser(const GroupChatUser &user);
+
+    /**
+     * Replaces a stored user including its key by an updated one.
+     *
+     * The stored user is found by its ID or, if it has none, by its JID.
+     *
+     * @param oldUser stored user
+     * @param newUser user replacing the stored one
+     */
+    void _replaceUser(const GroupChatUser &oldUser, const GroupChatUser &newUser);
+
     /**
      * Adds a user.
      *
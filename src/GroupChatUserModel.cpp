@@ -4,6 +4,10 @@
 
 #include "GroupChatUserModel.h"
 
+// std
+#include <algorithm>
+// Qt
+#include <QSet>
 // Kaidan
 #include "Algorithms.h"
 #include "Globals.h"
@@ -11,12 +15,57 @@
 #include "KaidanCoreLog.h"
 #include "RosterModel.h"
 
+bool GroupChatUserModel::Entry::operator<(const Entry &other) const
+{
+    if (user.status == other.user.status) {
+        return displayName < other.displayName;
+    }
+
+    return user.status < other.user.status;
+}
+
 GroupChatUserModel::GroupChatUserModel(QObject *parent)
     : QAbstractListModel(parent)
 {
+    m_userJidsChangedTimer.setSingleShot(true);
+    m_userJidsChangedTimer.setInterval(0);
+    connect(&m_userJidsChangedTimer, &QTimer::timeout, this, &GroupChatUserModel::userJidsChanged);
+
     connect(GroupChatUserDb::instance(), &GroupChatUserDb::userAdded, this, &GroupChatUserModel::addUser);
     connect(GroupChatUserDb::instance(), &GroupChatUserDb::userUpdated, this, &GroupChatUserModel::updateUser);
     connect(GroupChatUserDb::instance(), &GroupChatUserDb::userRemoved, this, &GroupChatUserModel::removeUser);
+    connect(GroupChatUserDb::instance(), &GroupChatUserDb::usersChanged, this, [this](const QList<GroupChatUser> &addedUsers, const QList<GroupChatUser> &updatedUsers) {
+        addUsers(addedUsers);
+
+        for (const auto &user : updatedUsers) {
+            updateUser(user);
+        }
+    });
+
+    // The display names of users in the roster are determined by their roster items.
+    connect(RosterModel::instance(),
+            &RosterModel::dataChanged,
+            this,
+            [this](const QModelIndex &topLeft, const QModelIndex &bottomRight, const QList<int> &roles) {
+                if (roles.isEmpty() || roles.contains(RosterModel::NameRole)) {
+                    const auto &rosterItems = RosterModel::instance()->items();
+
+                    for (int row = topLeft.row(); row <= bottomRight.row(); ++row) {
+                        const auto &rosterItem = rosterItems.at(row);
+                        updateDisplayName(rosterItem.accountJid, rosterItem.jid);
+                    }
+                }
+            });
+    connect(RosterModel::instance(), &RosterModel::itemAdded, this, [this](const RosterItem &item) {
+        updateDisplayName(item.accountJid, item.jid);
+    });
+    connect(RosterModel::instance(), &RosterModel::itemRemoved, this, &GroupChatUserModel::updateDisplayName);
+    connect(RosterModel::instance(), &RosterModel::itemsFetched, this, &GroupChatUserModel::updateDisplayNames);
+    connect(RosterModel::instance(), &RosterModel::itemsRemoved, this, [this](const QString &accountJid) {
+        if (accountJid == m_accountJid) {
+            updateDisplayNames();
+        }
+    });
 }
 
 int GroupChatUserModel::rowCount(const QModelIndex &) const
@@ -39,13 +88,14 @@ QVariant GroupChatUserModel::data(const QModelIndex &index, int role) const
         return {};
     }
 
-    const GroupChatUser &user = m_users.at(index.row());
+    const auto &entry = m_users.at(index.row());
+    const GroupChatUser &user = entry.user;
 
     switch (static_cast<Role>(role)) {
     case Role::Jid:
         return user.jid;
     case Role::Name:
-        return user.displayName();
+        return entry.displayName;
     case Role::Status:
         return QVariant::fromValue(user.status);
     case Role::StatusText:
@@ -88,6 +138,7 @@ void GroupChatUserModel::setAccountJid(const QString &accountJid)
 {
     if (m_accountJid != accountJid) {
         m_accountJid = accountJid;
+        m_rosterItemWatcher.setAccountJid(accountJid);
         Q_EMIT accountJidChanged();
     }
 }
@@ -101,22 +152,42 @@ void GroupChatUserModel::setChatJid(const QString &chatJid)
 {
     if (m_chatJid != chatJid) {
         m_chatJid = chatJid;
+        m_rosterItemWatcher.setJid(chatJid);
         Q_EMIT chatJidChanged();
     }
 }
 
+QString GroupChatUserModel::searchString() const
+{
+    return m_searchString;
+}
+
+void GroupChatUserModel::setSearchString(const QString &searchString)
+{
+    if (m_searchString != searchString) {
+        m_searchString = searchString;
+        removeAllUsers();
+        Q_EMIT searchStringChanged();
+
+        fetchUsers();
+    }
+}
+
 QStringList GroupChatUserModel::userJids() const
 {
-    return transform<QStringList>(m_users, [](const GroupChatUser &user) {
-        return user.jid;
+    return transform<QStringList>(m_users, [](const Entry &entry) {
+        return entry.user.jid;
     });
 }
 
 std::optional<const GroupChatUser> GroupChatUserModel::participant(const QString &accountJid, const QString &chatJid, const QString &participantId) const
 {
-    for (const auto &user : std::as_const(m_users)) {
-        if (user.accountJid == accountJid && user.chatJid == chatJid && user.id == participantId) {
-            return user;
+    if (accountJid == m_accountJid && chatJid == m_chatJid) {
+        if (const auto row = userRow(participantId); row != -1) {
+            // A user without an ID is indexed by its JID.
+            if (const auto &user = m_users.at(row).user; user.id == participantId) {
+                return user;
+            }
         }
     }
 
@@ -134,11 +205,18 @@ QString GroupChatUserModel::participantName(const QString &accountJid, const QSt
 
 void GroupChatUserModel::fetchUsers()
 {
-    GroupChatUserDb::instance()->users(m_accountJid, m_chatJid, m_users.size()).then(this, [this](QList<GroupChatUser> &&users) {
-        for (const auto &user : std::as_const(users)) {
-            addUser(user);
+    GroupChatUserDb::instance()->users(m_accountJid, m_chatJid, m_lastFetchedUser, m_searchString).then(this, [this, searchString = m_searchString](QList<GroupChatUser> &&users) {
+        // Discard the results of a search that has been replaced in the meantime.
+        if (searchString != m_searchString) {
+            return;
+        }
+
+        if (!users.isEmpty()) {
+            m_lastFetchedUser = users.constLast();
         }
 
+        addUsers(users);
+
         if (users.size() < DB_QUERY_LIMIT_GROUP_CHAT_USERS) {
             m_fetchedAll = true;
         }
@@ -147,30 +225,66 @@ void GroupChatUserModel::fetchUsers()
 
 void GroupChatUserModel::addUser(const GroupChatUser &user)
 {
-    if (!shouldUserBeProcessed(user)) {
+    addUsers({user});
+}
+
+void GroupChatUserModel::addUsers(const QList<GroupChatUser> &users)
+{
+    QList<Entry> entries;
+    entries.reserve(users.size());
+    QSet<QString> addedKeys;
+
+    for (const auto &user : users) {
+        const auto key = userKey(user);
+
+        if (shouldUserBeProcessed(user) && storedUserKey(user).isEmpty() && !addedKeys.contains(key)) {
+            if (Entry entry{user, user.displayName()}; matchesSearchString(entry)) {
+                addedKeys.insert(key);
+                entries.append(std::move(entry));
+            }
+        }
+    }
+
+    if (entries.isEmpty()) {
         return;
     }
 
-    for (int i = 0; i < m_users.size(); i++) {
-        const GroupChatUser existingUser = m_users.at(i);
+    std::stable_sort(entries.begin(), entries.end());
 
-        if (user < existingUser) {
-            insertUser(i, user);
-            return;
+    const auto rows = transform(entries, [this](const Entry &entry) {
+        return insertionRow(entry);
+    });
+
+    // Insert each run of users sharing the same insertion row at once.
+    // The rows are determined before any insertion and thus shifted by the number of users
+    // inserted so far.
+    qsizetype insertedCount = 0;
+
+    for (qsizetype begin = 0; begin < entries.size();) {
+        const auto row = rows.at(begin);
+        auto end = begin + 1;
+
+        while (end < entries.size() && rows.at(end) == row) {
+            ++end;
         }
-    }
 
-    // Append the new user to the end of the list.
-    insertUser(m_users.size(), user);
-}
+        const auto first = row + insertedCount;
 
-void GroupChatUserModel::insertUser(int position, const GroupChatUser &user)
-{
-    beginInsertRows(QModelIndex(), position, position);
-    m_users.insert(position, user);
-    endInsertRows();
+        beginInsertRows(QModelIndex(), int(first), int(first + end - begin - 1));
+
+        for (auto i = begin; i < end; ++i) {
+            const auto &entry = entries.at(i);
+            m_users.insert(first + i - begin, entry);
+            indexEntry(entry);
+        }
 
-    Q_EMIT userJidsChanged();
+        endInsertRows();
+
+        insertedCount += end - begin;
+        begin = end;
+    }
+
+    scheduleUserJidsChanged();
 }
 
 void GroupChatUserModel::updateUser(const GroupChatUser &user)
@@ -179,35 +293,52 @@ void GroupChatUserModel::updateUser(const GroupChatUser &user)
         return;
     }
 
-    for (int i = 0; i < m_users.size(); i++) {
-        if (m_users.at(i).accountJid == user.accountJid && m_users.at(i).chatJid == user.chatJid
-            && (m_users.at(i).id == user.id || m_users.at(i).jid == user.jid)) {
-            beginRemoveRows(QModelIndex(), i, i);
-            m_users.removeAt(i);
-            endRemoveRows();
+    const auto key = storedUserKey(user);
 
-            addUser(user);
+    if (key.isEmpty()) {
+        return;
+    }
 
-            break;
-        }
+    Entry entry{user, user.displayName()};
+
+    // A renamed user might not match the search string anymore.
+    if (!matchesSearchString(entry)) {
+        removeUser(user);
+        return;
     }
+
+    const auto oldRow = userRow(key);
+    Q_ASSERT(oldRow != -1);
+
+    unindexEntry(m_users.at(oldRow));
+    indexEntry(entry);
+    replaceEntry(oldRow, std::move(entry));
+
+    scheduleUserJidsChanged();
 }
 
 void GroupChatUserModel::removeUser(const GroupChatUser &user)
 {
-    for (int i = 0; i < m_users.size(); i++) {
-        GroupChatUser &existingUser = m_users[i];
+    if (user.accountJid != m_accountJid || user.chatJid != m_chatJid) {
+        return;
+    }
 
-        if (existingUser.accountJid == user.accountJid && existingUser.chatJid == user.chatJid && existingUser.id.isEmpty() ? existingUser.jid == user.jid
-                                                                                                                            : existingUser.id == user.id) {
-            beginRemoveRows(QModelIndex(), i, i);
-            m_users.remove(i);
-            endRemoveRows();
+    const auto key = storedUserKey(user);
 
-            Q_EMIT userJidsChanged();
-            return;
-        }
+    if (key.isEmpty()) {
+        return;
     }
+
+    const auto row = userRow(key);
+    Q_ASSERT(row != -1);
+
+    unindexEntry(m_users.at(row));
+
+    beginRemoveRows(QModelIndex(), int(row), int(row));
+    m_users.remove(row);
+    endRemoveRows();
+
+    scheduleUserJidsChanged();
 }
 
 void GroupChatUserModel::removeAllUsers()
@@ -218,17 +349,191 @@ void GroupChatUserModel::removeAllUsers()
         endRemoveRows();
     }
 
+    m_sortKeys.clear();
+    m_keysByJid.clear();
+
+    m_lastFetchedUser.reset();
     m_fetchedAll = false;
-    Q_EMIT userJidsChanged();
+    scheduleUserJidsChanged();
 }
 
-bool GroupChatUserModel::shouldUserBeProcessed(const GroupChatUser &user)
+void GroupChatUserModel::updateDisplayName(const QString &accountJid, const QString &jid)
 {
-    if (const auto rosterItem = RosterModel::instance()->item(m_accountJid, m_chatJid)) {
-        return rosterItem->groupChatParticipantId != user.id;
+    if (accountJid != m_accountJid) {
+        return;
+    }
+
+    const auto key = m_keysByJid.value(jid);
+
+    if (key.isEmpty()) {
+        return;
+    }
+
+    const auto row = userRow(key);
+    Q_ASSERT(row != -1);
+
+    auto entry = m_users.at(row);
+
+    if (auto displayName = entry.user.displayName(); displayName != entry.displayName) {
+        entry.displayName = std::move(displayName);
+
+        // A user whose roster item is renamed might not match the search string anymore.
+        if (!matchesSearchString(entry)) {
+            removeUser(entry.user);
+            return;
+        }
+
+        indexEntry(entry);
+        replaceEntry(row, std::move(entry));
+    }
+}
+
+void GroupChatUserModel::updateDisplayNames()
+{
+    const auto displayNames = transform(m_users, [](const Entry &entry) {
+        return entry.user.displayName();
+    });
+
+    if (std::ranges::equal(displayNames, m_users, {}, {}, &Entry::displayName)) {
+        return;
+    }
+
+    beginResetModel();
+
+    for (qsizetype i = 0; i < m_users.size(); ++i) {
+        m_users[i].displayName = displayNames.at(i);
+    }
+
+    // Users whose roster items are renamed might not match the search string anymore.
+    m_users.removeIf([this](const Entry &entry) {
+        if (matchesSearchString(entry)) {
+            indexEntry(entry);
+            return false;
+        }
+
+        unindexEntry(entry);
+        return true;
+    });
+
+    std::stable_sort(m_users.begin(), m_users.end());
+
+    endResetModel();
+}
+
+void GroupChatUserModel::replaceEntry(qsizetype oldRow, Entry &&entry)
+{
+    // Determine the new row among the other users, which are still sorted.
+    const auto begin = m_users.cbegin();
+    const auto oldItr = begin + oldRow;
+    auto newRow = std::upper_bound(begin, oldItr, entry) - begin;
+
+    if (newRow == oldRow) {
+        newRow = std::upper_bound(oldItr + 1, m_users.cend(), entry) - begin - 1;
+    }
+
+    if (newRow != oldRow) {
+        beginMoveRows(QModelIndex(), int(oldRow), int(oldRow), QModelIndex(), int(newRow > oldRow ? newRow + 1 : newRow));
+        m_users.move(oldRow, newRow);
+        m_users[newRow] = std::move(entry);
+        endMoveRows();
+    } else {
+        m_users[newRow] = std::move(entry);
+    }
+
+    const auto modelIndex = index(int(newRow));
+    Q_EMIT dataChanged(modelIndex, modelIndex);
+}
+
+QString GroupChatUserModel::userKey(const GroupChatUser &user)
+{
+    return user.id.isEmpty() ? user.jid : user.id;
+}
+
+QString GroupChatUserModel::storedUserKey(const GroupChatUser &user) const
+{
+    if (!user.id.isEmpty() && m_sortKeys.contains(user.id)) {
+        return user.id;
+    }
+
+    if (!user.jid.isEmpty()) {
+        return m_keysByJid.value(user.jid);
+    }
+
+    return {};
+}
+
+void GroupChatUserModel::indexEntry(const Entry &entry)
+{
+    const auto key = userKey(entry.user);
+
+    m_sortKeys.insert(key, SortKey{entry.user.status, entry.displayName});
+
+    if (!entry.user.jid.isEmpty()) {
+        m_keysByJid.insert(entry.user.jid, key);
+    }
+}
+
+void GroupChatUserModel::unindexEntry(const Entry &entry)
+{
+    m_sortKeys.remove(userKey(entry.user));
+
+    if (!entry.user.jid.isEmpty()) {
+        m_keysByJid.remove(entry.user.jid);
+    }
+}
+
+qsizetype GroupChatUserModel::userRow(const QString &key) const
+{
+    const auto sortKey = m_sortKeys.constFind(key);
+
+    if (sortKey == m_sortKeys.cend()) {
+        return -1;
+    }
+
+    Entry sortedEntry;
+    sortedEntry.user.status = sortKey->status;
+    sortedEntry.displayName = sortKey->displayName;
+
+    const auto [begin, end] = std::equal_range(m_users.cbegin(), m_users.cend(), sortedEntry);
+
+    // Users with the same status and display name are only distinguishable by their keys.
+    const auto itr = std::find_if(begin, end, [&key](const Entry &entry) {
+        return userKey(entry.user) == key;
+    });
+
+    return itr == end ? -1 : itr - m_users.cbegin();
+}
+
+qsizetype GroupChatUserModel::insertionRow(const Entry &entry) const
+{
+    return std::upper_bound(m_users.cbegin(), m_users.cend(), entry) - m_users.cbegin();
+}
+
+void GroupChatUserModel::scheduleUserJidsChanged()
+{
+    if (!m_userJidsChangedTimer.isActive()) {
+        m_userJidsChangedTimer.start();
+    }
+}
+
+bool GroupChatUserModel::shouldUserBeProcessed(const GroupChatUser &user) const
+{
+    if (user.accountJid != m_accountJid || user.chatJid != m_chatJid) {
+        return false;
+    }
+
+    // The roster item is empty if the group chat is not in the roster.
+    if (const auto &rosterItem = m_rosterItemWatcher.item(); !rosterItem.jid.isEmpty()) {
+        return rosterItem.groupChatParticipantId != user.id;
     }
 
     return false;
 }
 
+bool GroupChatUserModel::matchesSearchString(const Entry &entry) const
+{
+    return m_searchString.isEmpty() || entry.user.name.contains(m_searchString, Qt::CaseInsensitive)
+        || entry.user.jid.contains(m_searchString, Qt::CaseInsensitive) || entry.displayName.contains(m_searchString, Qt::CaseInsensitive);
+}
+
 #include "moc_GroupChatUserModel.cpp"
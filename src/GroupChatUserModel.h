@@ -8,9 +8,12 @@
 #include <optional>
 // Qt
 #include <QAbstractListModel>
+#include <QHash>
 #include <QStringList>
+#include <QTimer>
 // Kaidan
 #include "GroupChatUser.h"
+#include "RosterItemWatcher.h"
 
 class GroupChatUserModel : public QAbstractListModel
 {
@@ -18,6 +21,7 @@ class GroupChatUserModel : public QAbstractListModel
 
     Q_PROPERTY(QString accountJid READ accountJid WRITE setAccountJid NOTIFY accountJidChanged)
     Q_PROPERTY(QString chatJid READ chatJid WRITE setChatJid NOTIFY chatJidChanged)
+    Q_PROPERTY(QString searchString READ searchString WRITE setSearchString NOTIFY searchStringChanged)
 
 public:
     enum class Role {
@@ -46,6 +50,19 @@ public:
     void setChatJid(const QString &chatJid);
     Q_SIGNAL void chatJidChanged();
 
+    QString searchString() const;
+
+    /**
+     * Sets the string the names, JIDs or roster item names of the listed users must contain.
+     *
+     * The search is done by the database so that only matching users are fetched.
+     * Setting an empty string lists all users again.
+     *
+     * @param searchString case-insensitive part of the users' names, JIDs or roster item names
+     */
+    void setSearchString(const QString &searchString);
+    Q_SIGNAL void searchStringChanged();
+
     QStringList userJids() const;
     Q_SIGNAL void userJidsChanged();
 
@@ -81,6 +98,28 @@ public:
     Q_INVOKABLE QString participantName(const QString &accountJid, const QString &chatJid, const QString &participantId) const;
 
 private:
+    /**
+     * User with its cached sort key.
+     *
+     * Determining a user's display name requires a roster lookup.
+     * Thus, it is only done once per user instead of on each comparison.
+     * It is done again once the roster item of the user changes.
+     */
+    struct Entry {
+        GroupChatUser user;
+        QString displayName;
+
+        bool operator<(const Entry &other) const;
+    };
+
+    /**
+     * Sort key of a stored user used for finding its row.
+     */
+    struct SortKey {
+        GroupChatUser::Status status;
+        QString displayName;
+    };
+
     void fetchUsers();
 
     /**
@@ -92,38 +131,97 @@ private:
      */
     void addUser(const GroupChatUser &user);
 
-    void insertUser(int i, const GroupChatUser &user);
+    /**
+     * Adds new users at once.
+     *
+     * Users that should not be processed or that are already contained are skipped.
+     * Consecutive users are inserted with a single row insertion.
+     *
+     * @param users new users to add
+     */
+    void addUsers(const QList<GroupChatUser> &users);
+
     void updateUser(const GroupChatUser &user);
     void removeUser(const GroupChatUser &user);
     void removeAllUsers();
 
     /**
-     * Checks if a user should be processed like being added or updated.
+     * Updates the display name of the user with a JID after its roster item changed.
+     */
+    void updateDisplayName(const QString &accountJid, const QString &jid);
+
+    /**
+     * Updates the display names of all users after the roster has been replaced.
+     */
+    void updateDisplayNames();
+
+    /**
+     * Replaces a stored user and moves it to the row that keeps the users sorted.
      *
-     * @param user user being checked
+     * @param oldRow row of the stored user
+     * @param entry new entry of the user
+     */
+    void replaceEntry(qsizetype oldRow, Entry &&entry);
+
+    /**
+     * Returns the key by which a user is indexed (i.e., its ID or its JID if it has no ID).
+     */
+    static QString userKey(const GroupChatUser &user);
+
+    /**
+     * Searches the stored user matching the passed user by its ID or by its JID.
      *
-     * @return true if the passed user should be processed, otherwise false
+     * @return the key of the found user or an empty string if the user is not contained
      */
-    bool shouldUserBeProcessed(const GroupChatUser &user);
+    QString storedUserKey(const GroupChatUser &user) const;
+    void indexEntry(const Entry &entry);
+    void unindexEntry(const Entry &entry);
 
     /**
-     * Determines a suitable name for a user.
+     * Determines the row of a stored user via binary search.
      *
-     * The user name is determined as follows:
+     * @param key key of the stored user
      *
-     *  1. If the user is in the roster and the roster item has a name, that name is returned.
-     *  2. If the group chat provides a name for the user, that name is returned.
-     *  3. If the group chat provides a JID for the user, that JID is returned.
-     *  4. If 1, 2 and 3 are not applicable, the user's ID is returned.
+     * @return the user's row or -1 if the user is not contained
+     */
+    qsizetype userRow(const QString &key) const;
+
+    /**
+     * Determines the row at which a user is inserted to keep the users sorted.
+     */
+    qsizetype insertionRow(const Entry &entry) const;
+
+    /**
+     * Emits userJidsChanged() once for all changes made within the same event loop iteration.
+     */
+    void scheduleUserJidsChanged();
+
+    /**
+     * Checks if a user should be processed like being added or updated.
      *
-     * @param user user for whom a suitable name is determined
+     * @param user user being checked
      *
-     * @return a suitable name for the user
+     * @return true if the passed user should be processed, otherwise false
+     */
+    bool shouldUserBeProcessed(const GroupChatUser &user) const;
+
+    /**
+     * Checks if a user's name, JID or display name contains the search string.
      */
-    QString determineUserName(const GroupChatUser &user) const;
+    bool matchesSearchString(const Entry &entry) const;
 
     QString m_accountJid;
     QString m_chatJid;
-    QList<GroupChatUser> m_users;
+    QString m_searchString;
+    // Users sorted by their status and display name
+    QList<Entry> m_users;
+    // Sort keys of the stored users by their keys
+    QHash<QString, SortKey> m_sortKeys;
+    // Keys of the stored users by their JIDs
+    QHash<QString, QString> m_keysByJid;
+    RosterItemWatcher m_rosterItemWatcher;
+    QTimer m_userJidsChangedTimer;
+    // Last user of the previously fetched page used as the key for fetching the next page.
+    std::optional<GroupChatUser> m_lastFetchedUser;
     bool m_fetchedAll = false;
 };
@@ -42,42 +42,21 @@ void HostCompletionModel::clear()
 
     beginResetModel();
     m_hosts.clear();
+    m_knownHosts.clear();
     endResetModel();
 }
 
 void HostCompletionModel::aggregate(const QStringList &jids)
 {
-    QStringList missing;
-
-    missing.reserve(jids.size());
-
-    for (auto jid : jids) {
-        jid = transform(jid);
-
-        if (!m_hosts.contains(jid) && !missing.contains(jid)) {
-            missing.append(jid);
-        }
-    }
-
-    if (missing.isEmpty()) {
-        return;
-    }
-
-    const auto count = m_hosts.size();
-
-    beginInsertRows({}, count, count + missing.size() - 1);
-    m_hosts.append(missing);
-    endInsertRows();
+    appendHosts(addMissingHosts(jids));
 }
 
 void HostCompletionModel::aggregateKnownProviders()
 {
-    QStringList hosts;
-
-    hosts.append(completionProviders());
-    hosts.append(rosterProviders());
+    auto hosts = addMissingHosts(completionProviders());
+    hosts.append(addMissingHosts(rosterProviders(0, m_rosterModel ? m_rosterModel->rowCount() - 1 : -1)));
 
-    aggregate(hosts);
+    appendHosts(hosts);
 }
 
 RosterModel *HostCompletionModel::rosterModel() const
@@ -92,73 +71,116 @@ void HostCompletionModel::setRosterModel(RosterModel *model)
     }
 
     if (m_rosterModel) {
-        disconnect(m_rosterModel, &RosterModel::rowsInserted, this, &HostCompletionModel::aggregateRoster);
-        disconnect(m_rosterModel, &RosterModel::layoutChanged, this, &HostCompletionModel::aggregateRoster);
+        disconnect(m_rosterModel, &RosterModel::rowsInserted, this, &HostCompletionModel::aggregateInsertedRosterItems);
         disconnect(m_rosterModel, &RosterModel::modelReset, this, &HostCompletionModel::aggregateRoster);
     }
 
     m_rosterModel = model;
 
+    // Moving rows (i.e., a layout change) does not add hosts.
+    // Thus, only inserted rows and all rows after a reset are aggregated.
     if (m_rosterModel) {
-        connect(m_rosterModel, &RosterModel::rowsInserted, this, &HostCompletionModel::aggregateRoster);
-        connect(m_rosterModel, &RosterModel::layoutChanged, this, &HostCompletionModel::aggregateRoster);
+        connect(m_rosterModel, &RosterModel::rowsInserted, this, &HostCompletionModel::aggregateInsertedRosterItems);
         connect(m_rosterModel, &RosterModel::modelReset, this, &HostCompletionModel::aggregateRoster);
     }
 
     Q_EMIT rosterModelChanged(model);
 }
 
+QStringList HostCompletionModel::addMissingHosts(const QStringList &entries)
+{
+    QStringList missing;
+
+    for (const auto &entry : entries) {
+        auto host = transform(entry);
+
+        if (!m_knownHosts.contains(host)) {
+            m_knownHosts.insert(host);
+            missing.append(std::move(host));
+        }
+    }
+
+    return missing;
+}
+
+void HostCompletionModel::appendHosts(const QStringList &hosts)
+{
+    if (hosts.isEmpty()) {
+        return;
+    }
+
+    const auto count = m_hosts.size();
+
+    beginInsertRows({}, count, count + hosts.size() - 1);
+    m_hosts.append(hosts);
+    endInsertRows();
+}
+
 QString HostCompletionModel::transform(const QString &entry) const
 {
     const int index = entry.indexOf(QStringLiteral("@"));
     return (index == -1 ? entry : entry.mid(index + 1)).toLower();
 }
 
-QStringList HostCompletionModel::completionProviders() const
+const QStringList &HostCompletionModel::completionProviders()
 {
-    if (!QFile::exists(PROVIDER_COMPLETION_LIST_FILE_PATH)) {
-        qCWarning(KAIDAN_CORE_LOG, "Can not open known providers file: %ls, file does not exists", qUtf16Printable(PROVIDER_COMPLETION_LIST_FILE_PATH));
-        return {};
-    }
+    // The file is only parsed once because its content does not change.
+    static const QStringList providers = []() -> QStringList {
+        if (!QFile::exists(PROVIDER_COMPLETION_LIST_FILE_PATH)) {
+            qCWarning(KAIDAN_CORE_LOG, "Can not open known providers file: %ls, file does not exists", qUtf16Printable(PROVIDER_COMPLETION_LIST_FILE_PATH));
+            return {};
+        }
 
-    QFile file(PROVIDER_COMPLETION_LIST_FILE_PATH);
+        QFile file(PROVIDER_COMPLETION_LIST_FILE_PATH);
 
-    if (!file.open(QIODevice::ReadOnly)) {
-        qCWarning(KAIDAN_CORE_LOG,
-                  "Can not open known providers file: %ls, %ls",
-                  qUtf16Printable(PROVIDER_COMPLETION_LIST_FILE_PATH),
-                  qUtf16Printable(file.errorString()));
-        return {};
-    }
+        if (!file.open(QIODevice::ReadOnly)) {
+            qCWarning(KAIDAN_CORE_LOG,
+                      "Can not open known providers file: %ls, %ls",
+                      qUtf16Printable(PROVIDER_COMPLETION_LIST_FILE_PATH),
+                      qUtf16Printable(file.errorString()));
+            return {};
+        }
 
-    QJsonParseError error;
-    const auto document = QJsonDocument::fromJson(file.readAll(), &error);
+        QJsonParseError error;
+        const auto document = QJsonDocument::fromJson(file.readAll(), &error);
 
-    if (error.error != QJsonParseError::NoError) {
-        qCWarning(KAIDAN_CORE_LOG, "Can not parse known providers JSON file: %ls, %ls", qUtf16Printable(file.fileName()), qUtf16Printable(error.errorString()));
-        return {};
-    }
+        if (error.error != QJsonParseError::NoError) {
+            qCWarning(KAIDAN_CORE_LOG, "Can not parse known providers JSON file: %ls, %ls", qUtf16Printable(file.fileName()), qUtf16Printable(error.errorString()));
+            return {};
+        }
+
+        return ::transform<QStringList>(document.array(), [](const QJsonValue &value) {
+            return value.toString();
+        });
+    }();
 
-    return ::transform<QStringList>(document.array(), [](const QJsonValue &value) {
-        return value.toString();
-    });
+    return providers;
 }
 
-QStringList HostCompletionModel::rosterProviders() const
+QStringList HostCompletionModel::rosterProviders(int first, int last) const
 {
+    QStringList jids;
+
     if (m_rosterModel) {
-        const auto items = m_rosterModel->items();
-        return ::transform<QStringList>(items, [](const RosterItem &item) {
-            return item.jid;
-        });
+        const auto &items = m_rosterModel->items();
+        jids.reserve(last - first + 1);
+
+        for (int i = first; i <= last; ++i) {
+            jids.append(items.at(i).jid);
+        }
     }
 
-    return {};
+    return jids;
 }
 
 void HostCompletionModel::aggregateRoster()
 {
-    aggregate(rosterProviders());
+    aggregate(rosterProviders(0, m_rosterModel->rowCount() - 1));
+}
+
+void HostCompletionModel::aggregateInsertedRosterItems(const QModelIndex &, int first, int last)
+{
+    aggregate(rosterProviders(first, last));
 }
 
 #include "moc_HostCompletionModel.cpp"
@@ -6,6 +6,7 @@
 
 // Qt
 #include <QAbstractListModel>
+#include <QSet>
 
 class RosterModel;
 
@@ -30,12 +31,20 @@ public:
     Q_SIGNAL void rosterModelChanged(RosterModel *model);
 
 private:
+    /**
+     * Adds the hosts of entries that are not yet known and returns the added hosts.
+     */
+    QStringList addMissingHosts(const QStringList &entries);
+    void appendHosts(const QStringList &hosts);
+
     QString transform(const QString &entry) const;
-    QStringList completionProviders() const;
-    QStringList rosterProviders() const;
+    static const QStringList &completionProviders();
+    QStringList rosterProviders(int first, int last) const;
     void aggregateRoster();
+    void aggregateInsertedRosterItems(const QModelIndex &parent, int first, int last);
 
 private:
     QStringList m_hosts;
+    QSet<QString> m_knownHosts;
     RosterModel *m_rosterModel = nullptr;
 };
@@ -11,7 +11,6 @@
 #include <QGuiApplication>
 #include <QIcon>
 #include <QImageReader>
-#include <QMutex>
 #include <QPointer>
 // KDE
 #include <KFileItem>
@@ -21,20 +20,19 @@
 #include <QXmppBitsOfBinaryContentId.h>
 #include <QXmppBitsOfBinaryData.h>
 // Kaidan
+#include "BitsOfBinaryCache.h"
 #include "FutureUtils.h"
 #include "Globals.h"
 #include "KaidanCoreLog.h"
 #include "MainController.h"
 #include "MediaUtils.h"
 #include "Message.h"
+#include "ThumbnailCache.h"
 
 using namespace Qt::Literals::StringLiterals;
 
 ImageProvider *ImageProvider::s_instance = nullptr;
 
-QMutex m_cacheMutex;
-std::vector<QXmppBitsOfBinaryData> m_cache;
-
 const QString IMAGE_SCHEME = QStringLiteral("image");
 const QString IMAGE_PROVIDER_PREFIX = QStringLiteral("%1://%2/").arg(IMAGE_SCHEME, IMAGE_PROVIDER_NAME);
 const QString LOCAL_FILE_PATH_SEGMENT = QStringLiteral("local-file");
@@ -127,31 +125,16 @@ void ImageProvider::copySourceToClipboard(const QUrl &source, const QSize &size)
 
 bool ImageProvider::addImage(const QXmppBitsOfBinaryData &data)
 {
-    QMutexLocker locker(&m_cacheMutex);
-
     if (!QImageReader::supportedMimeTypes().contains(data.contentType().name().toUtf8())) {
         return false;
     }
 
-    m_cache.push_back(data);
-    return true;
+    return BitsOfBinaryCache::instance().insert(data);
 }
 
 bool ImageProvider::removeImage(const QXmppBitsOfBinaryContentId &cid)
 {
-    QMutexLocker locker(&m_cacheMutex);
-
-    auto itr = std::ranges::remove_if(m_cache, [&](const QXmppBitsOfBinaryData &item) {
-                   return item.cid() == cid;
-               }).begin();
-
-    if (itr == m_cache.end()) {
-        return false;
-    }
-
-    m_cache.erase(itr, m_cache.end());
-
-    return true;
+    return BitsOfBinaryCache::instance().remove(cid);
 }
 
 QUrl ImageProvider::generatedFileImageUrl(const File &file)
@@ -249,14 +232,8 @@ QFuture<QImage> ImageProvider::generateImage(const QString &id, const QSize &req
     };
 
     if (QXmppBitsOfBinaryContentId::isBitsOfBinaryContentId(id, true)) {
-        QMutexLocker locker(&m_cacheMutex);
-
-        const auto item = std::ranges::find_if(m_cache, [&](const QXmppBitsOfBinaryData &item) {
-            return item.cid().toCidUrl() == id;
-        });
-
-        if (item != m_cache.cend()) {
-            return generateBitsOfBinaryImage(*item, requestedEdgePixelCount).then(context, then);
+        if (const auto data = BitsOfBinaryCache::instance().data(id)) {
+            return generateBitsOfBinaryImage(*data, requestedEdgePixelCount).then(context, then);
         }
     }
 
@@ -287,7 +264,13 @@ QFuture<QImage> ImageProvider::generateLocalFileImage(const QString &localFilePa
     promise->start();
 
     if (QFile::exists(localFilePath)) {
-        ImageProvider::generateImageWithDevicePixelRatio(QUrl::fromLocalFile(localFilePath), devicePixelRatio, edgePixelCount)
+        ThumbnailCache::instance()
+            .thumbnail(localFilePath,
+                       edgePixelCount,
+                       devicePixelRatio,
+                       [localFilePath, edgePixelCount, devicePixelRatio]() {
+                           return generateImageWithDevicePixelRatio(QUrl::fromLocalFile(localFilePath), devicePixelRatio, edgePixelCount);
+                       })
             .then(context, [context, promise, localFilePath, edgePixelCount, devicePixelRatio](QImage &&thumbnail) {
                 if (thumbnail.isNull()) {
                     generateIconImage(MediaUtils::iconName(localFilePath), edgePixelCount, devicePixelRatio).then(context, [promise](QImage &&image) {
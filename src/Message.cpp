@@ -29,6 +29,7 @@
 #include "MediaUtils.h"
 #include "QmlUtils.h"
 #include "RosterModel.h"
+#include "TextFormatter.h"
 
 QXmppHash FileHash::toQXmpp() const
 {
@@ -336,6 +337,7 @@ QString Message::body() const
 void Message::setPreparedBody(const QString &preparedBody)
 {
     m_body = preparedBody;
+    classifyBody();
 }
 
 void Message::setUnpreparedBody(const QString &unpreparedBody)
@@ -345,6 +347,8 @@ void Message::setUnpreparedBody(const QString &unpreparedBody)
 
     // Shorten the body to prevent denial-of-service attacks.
     m_body.truncate(MESSAGE_MAX_CHARS);
+
+    classifyBody();
 }
 
 QString Message::text() const
@@ -390,7 +394,12 @@ QString Message::previewText() const
 
 QGeoCoordinate Message::geoCoordinate() const
 {
-    return QmlUtils::geoCoordinate(m_body);
+    return m_geoCoordinate;
+}
+
+TextType Message::bodyTextType() const
+{
+    return m_bodyTextType;
 }
 
 QString Message::formattedTimestamp() const
@@ -470,6 +479,12 @@ QString Message::groupChatInvitationText() const
     return tr("Invitation to group %1", "%1 is the group JID").arg(groupChatInvitation->groupChatJid);
 }
 
+void Message::classifyBody()
+{
+    m_geoCoordinate = QmlUtils::geoCoordinate(m_body);
+    m_bodyTextType = m_geoCoordinate.isValid() ? TextType::Mixed : TextFormatter::determineTextType(m_body);
+}
+
 bool Message::Reply::operator==(const Reply &other) const
 {
     return toJid == other.toJid && toGroupChatParticipantId == other.toGroupChatParticipantId && id == other.id && quote == other.quote;
@@ -9,6 +9,7 @@
 
 // Qt
 #include <QCoreApplication>
+#include <QGeoCoordinate>
 #include <QImage>
 #include <QMimeType>
 #include <QUrl>
@@ -19,8 +20,6 @@
 #include "Encryption.h"
 #include "Enums.h"
 
-class QGeoCoordinate;
-
 using namespace Enums;
 
 struct FileHash {
@@ -294,6 +293,9 @@ public:
 
     QGeoCoordinate geoCoordinate() const;
 
+    // Type of the body determining how its emojis are displayed
+    TextType bodyTextType() const;
+
     TrustLevel trustLevel() const;
 
     [[nodiscard]] QString formattedTimestamp() const;
@@ -304,7 +306,14 @@ private:
     static bool addFileFallbackMessageBase(QXmppMessage &message, const File &file);
     QString groupChatInvitationText() const;
 
+    /**
+     * Classifies the body's content once it is set instead of each time it is displayed.
+     */
+    void classifyBody();
+
     QString m_body;
+    QGeoCoordinate m_geoCoordinate;
+    TextType m_bodyTextType = TextType::Mixed;
 };
 
 enum class MessageOrigin : quint8 {
@@ -68,6 +68,7 @@ MessageController::MessageController(AccountSettings *accountSettings,
     , m_client(client)
     , m_mamManager(mamManager)
     , m_messageReceiptManager(messageReceiptManager)
+    , m_chatMarkerBatcher(new ChatMarkerBatcher(std::bind(&MessageController::storeReadMarkers, this, _1), this))
 {
     connect(RosterDb::instance(), &RosterDb::itemsReplaced, this, &MessageController::handleRosterReceived);
 
@@ -542,7 +543,7 @@ void MessageController::handleMessage(const QXmppMessage &msg, MessageOrigin ori
     // stanza ID is used for retrieving offline (i.e., catch up) messages once connected.
     updateLatestMessage(chatJid, stanzaId, timestamp, receivedFromGroupChat);
 
-    if (handleReadMarker(msg, senderJid, recipientJid, isOwn) || handleReaction(msg, chatJid, senderId) || handleFileSourcesAttachments(msg, chatJid)) {
+    if (handleReadMarker(msg, senderJid, recipientJid, isOwn, timestamp) || handleReaction(msg, chatJid, senderId) || handleFileSourcesAttachments(msg, chatJid)) {
         return;
     }
 
@@ -715,21 +716,17 @@ void MessageController::updateLatestMessage(const QString &chatJid, const QStrin
     }
 }
 
-bool MessageController::handleReadMarker(const QXmppMessage &message, const QString &senderJid, const QString &recipientJid, bool isOwnMessage)
+bool MessageController::handleReadMarker(const QXmppMessage &message,
+                                         const QString &senderJid,
+                                         const QString &recipientJid,
+                                         bool isOwnMessage,
+                                         const QDateTime &timestamp)
 {
     if (message.marker() == QXmppMessage::Displayed) {
-        const auto markedId = message.markedId();
         if (isOwnMessage) {
-            Q_EMIT contactMessageRead(senderJid, recipientJid);
-
-            RosterDb::instance()->updateItem(m_accountSettings->jid(), recipientJid, [=](RosterItem &item) {
-                item.lastReadContactMessageId = markedId;
-                item.readMarkerPending = false;
-            });
+            m_chatMarkerBatcher->addOwnMarker(recipientJid, message.markedId(), timestamp);
         } else {
-            RosterDb::instance()->updateItem(m_accountSettings->jid(), senderJid, [markedId](RosterItem &item) {
-                item.lastReadOwnMessageId = markedId;
-            });
+            m_chatMarkerBatcher->addContactMarker(senderJid, message.markedId(), timestamp);
         }
 
         return true;
@@ -738,49 +735,38 @@ bool MessageController::handleReadMarker(const QXmppMessage &message, const QStr
     return false;
 }
 
+void MessageController::storeReadMarkers(const ChatMarkerBatcher::ChatMarkers &markers)
+{
+    const auto accountJid = m_accountSettings->jid();
+    const auto &ownMarker = markers.ownMarker;
+    const auto &contactMarker = markers.contactMarker;
+
+    if (ownMarker.isValid()) {
+        Q_EMIT contactMessageRead(accountJid, markers.chatJid);
+    }
+
+    RosterDb::instance()->updateItem(accountJid, markers.chatJid, [ownMarker, contactMarker](RosterItem &item) {
+        if (ownMarker.isValid()) {
+            item.lastReadContactMessageId = ownMarker.markedId;
+            item.readMarkerPending = false;
+        }
+
+        if (contactMarker.isValid()) {
+            item.lastReadOwnMessageId = contactMarker.markedId;
+        }
+    });
+}
+
 bool MessageController::handleReaction(const QXmppMessage &message, const QString &chatJid, const QString &senderId)
 {
     if (const auto receivedReaction = message.reaction()) {
-        MessageDb::instance()->updateMessage(m_accountSettings->jid(),
-                                             chatJid,
-                                             message.reaction()->messageId(),
-                                             [senderId, receivedEmojis = receivedReaction->emojis(), receivedTimestamp = message.stamp()](Message &m) {
-                                                 auto &reactionSenders = m.reactionSenders;
-                                                 auto &reactionSender = reactionSenders[senderId];
-
-                                                 // Process only newer reactions.
-                                                 if (reactionSender.latestTimestamp.isNull() || reactionSender.latestTimestamp < receivedTimestamp) {
-                                                     reactionSender.latestTimestamp = receivedTimestamp;
-                                                     auto &reactions = reactionSender.reactions;
-
-                                                     // Add new reactions.
-                                                     for (const auto &receivedEmoji : std::as_const(receivedEmojis)) {
-                                                         const auto reactionNew = std::ranges::none_of(reactions, [&](const MessageReaction &reaction) {
-                                                             return reaction.emoji == receivedEmoji;
-                                                         });
-
-                                                         if (reactionNew) {
-                                                             MessageReaction reaction;
-                                                             reaction.emoji = receivedEmoji;
-
-                                                             reactions.append(reaction);
-                                                         }
-                                                     }
-
-                                                     // Remove existing reactions.
-                                                     reactions.erase(std::ranges::remove_if(reactions,
-                                                                                            [receivedEmojis](MessageReaction &reaction) {
-                                                                                                return !receivedEmojis.contains(reaction.emoji);
-                                                                                            })
-                                                                         .begin(),
-                                                                     reactions.end());
-
-                                                     // Remove the reaction sender if it has no reactions anymore.
-                                                     if (reactions.isEmpty()) {
-                                                         reactionSenders.remove(senderId);
-                                                     }
-                                                 }
-                                             });
+        // Only the sender's reactions are stored instead of loading and updating the whole message.
+        MessageDb::instance()->updateReactions(m_accountSettings->jid(),
+                                               chatJid,
+                                               receivedReaction->messageId(),
+                                               senderId,
+                                               receivedReaction->emojis(),
+                                               message.stamp());
 
         return true;
     }
@@ -12,6 +12,7 @@
 // QXmpp
 #include <QXmppMessageReceiptManager.h>
 // Kaidan
+#include "ChatMarkerBatcher.h"
 #include "Message.h"
 
 class AccountSettings;
@@ -104,9 +105,16 @@ private:
     /**
      * Handles a message that may contain a read marker.
      *
+     * Read markers are folded per chat and stored once the event loop is entered again.
+     *
      * @return whether the message is handled because it contains a read marker
      */
-    bool handleReadMarker(const QXmppMessage &message, const QString &senderJid, const QString &recipientJid, bool isOwnMessage);
+    bool handleReadMarker(const QXmppMessage &message, const QString &senderJid, const QString &recipientJid, bool isOwnMessage, const QDateTime &timestamp);
+
+    /**
+     * Stores the folded read markers of a chat via one roster update.
+     */
+    void storeReadMarkers(const ChatMarkerBatcher::ChatMarkers &markers);
 
     bool handleReaction(const QXmppMessage &message, const QString &chatJid, const QString &senderJid);
     bool handleFileSourcesAttachments(const QXmppMessage &message, const QString &chatJid);
@@ -138,4 +146,5 @@ private:
     QXmppClient *const m_client;
     QXmppMamManager *const m_mamManager;
     QXmppMessageReceiptManager *const m_messageReceiptManager;
+    ChatMarkerBatcher *const m_chatMarkerBatcher;
 };
@@ -958,6 +958,25 @@ QFuture<void> MessageDb::attachFileSources(const QString &accountJid,
     });
 }
 
+QFuture<void> MessageDb::updateFiles(const QList<FileUpdate> &updates)
+{
+    return run([this, updates]() {
+        _updateFiles(updates);
+    });
+}
+
+QFuture<void> MessageDb::updateReactions(const QString &accountJid,
+                                         const QString &chatJid,
+                                         const QString &messageId,
+                                         const QString &senderId,
+                                         const QList<QString> &emojis,
+                                         const QDateTime &timestamp)
+{
+    return run([this, accountJid, chatJid, messageId, senderId, emojis, timestamp]() {
+        _updateReactions(accountJid, chatJid, messageId, senderId, emojis, timestamp);
+    });
+}
+
 QFuture<std::optional<Message>> MessageDb::fetchDraftMessage(const QString &accountJid, const QString &chatJid)
 {
     return run([this, accountJid, chatJid]() {
@@ -1324,6 +1343,268 @@ void MessageDb::_setFiles(const QList<File> &files)
     }
 }
 
+void MessageDb::_updateFiles(const QList<FileUpdate> &updates)
+{
+    if (updates.isEmpty()) {
+        return;
+    }
+
+    thread_local static auto transferStateQuery = [this]() {
+        auto query = createQuery();
+        prepareQuery(query, QStringLiteral(R"(
+                                              UPDATE files
+                                              SET transferState = :transferState
+                                              WHERE id = :id
+                                          )"));
+        return query;
+    }();
+
+    thread_local static auto transferStateAndLocalFilePathQuery = [this]() {
+        auto query = createQuery();
+        prepareQuery(query, QStringLiteral(R"(
+                                              UPDATE files
+                                              SET transferState = :transferState, localFilePath = :localFilePath
+                                              WHERE id = :id
+                                          )"));
+        return query;
+    }();
+
+    // Reset the error text of the message whose files are all transferred.
+    thread_local static auto errorResetQuery = [this]() {
+        auto query = createQuery();
+        prepareQuery(query, QStringLiteral(R"(
+                                              UPDATE messages
+                                              SET errorText = NULL
+                                              WHERE
+                                                  errorText IS NOT NULL AND
+                                                  fileGroupId = (SELECT fileGroupId FROM files WHERE id = :id) AND
+                                                  NOT EXISTS (
+                                                      SELECT 1
+                                                      FROM files
+                                                      WHERE fileGroupId = messages.fileGroupId AND transferState != :transferState
+                                                  )
+                                          )"));
+        return query;
+    }();
+
+    transaction();
+
+    for (const auto &update : updates) {
+        if (update.localFilePath) {
+            bindValues(transferStateAndLocalFilePathQuery,
+                       {
+                           {u":id", update.fileId},
+                           {u":transferState", Enums::toIntegral(update.transferState)},
+                           {u":localFilePath", *update.localFilePath},
+                       });
+            execQuery(transferStateAndLocalFilePathQuery);
+        } else {
+            bindValues(transferStateQuery,
+                       {
+                           {u":id", update.fileId},
+                           {u":transferState", Enums::toIntegral(update.transferState)},
+                       });
+            execQuery(transferStateQuery);
+        }
+
+        if (update.transferState == File::TransferState::Done) {
+            bindValues(errorResetQuery,
+                       {
+                           {u":id", update.fileId},
+                           {u":transferState", Enums::toIntegral(File::TransferState::Done)},
+                       });
+            execQuery(errorResetQuery);
+        }
+    }
+
+    commit();
+
+    Q_EMIT filesUpdated(updates);
+}
+
+void MessageDb::_updateReactions(const QString &accountJid,
+                                 const QString &chatJid,
+                                 const QString &messageId,
+                                 const QString &senderId,
+                                 const QList<QString> &emojis,
+                                 const QDateTime &timestamp)
+{
+    enum {
+        IsOwn,
+        GroupChatSenderId,
+        Id,
+        OriginId,
+        StanzaId,
+        ReplaceId,
+    };
+
+    auto query = createQuery();
+
+    // Load only the columns needed to determine how the reactions are stored.
+    execQuery(query,
+              QStringLiteral(R"(
+                                SELECT isOwn, groupChatSenderId, id, originId, stanzaId, replaceId
+                                FROM chatMessages
+                                WHERE
+                                    accountJid = :accountJid AND
+                                    chatJid = :chatJid AND
+                                    (replaceId = :id OR stanzaId = :id OR originId = :id OR id = :id)
+                                LIMIT 1
+                            )"),
+              {
+                  {u":accountJid", accountJid},
+                  {u":chatJid", chatJid},
+                  {u":id", messageId},
+              });
+
+    if (!query.next()) {
+        return;
+    }
+
+    Message message;
+    message.accountJid = accountJid;
+    message.chatJid = chatJid;
+    message.isOwn = query.value(IsOwn).toBool();
+    message.groupChatSenderId = query.value(GroupChatSenderId).toString();
+    message.id = query.value(Id).toString();
+    message.originId = query.value(OriginId).toString();
+    message.stanzaId = query.value(StanzaId).toString();
+    message.replaceId = query.value(ReplaceId).toString();
+
+    const auto referenceId = message.referenceId();
+    const auto messageSenderId = message.isOwn ? accountJid : (message.isGroupChatMessage() ? message.groupChatSenderId : chatJid);
+
+    // Own reactions are stored without a sender ID.
+    const auto storedSenderId = senderId == accountJid ? QVariant{} : QVariant(senderId);
+
+    const auto bindKey = [&]() {
+        QueryBindValues values;
+        values.insert(u":accountJid", accountJid);
+        values.insert(u":chatJid", chatJid);
+        values.insert(u":messageSenderId", messageSenderId);
+        values.insert(u":messageId", referenceId);
+        values.insert(u":senderId", storedSenderId);
+        return values;
+    };
+
+    // Process only reactions that are newer than the stored ones.
+    // A reaction without a timestamp is only processed if the stored ones have none either.
+    {
+        auto values = bindKey();
+        values.insert(u":timestamp", timestamp);
+
+        execQuery(query,
+                  QStringLiteral(R"(
+                                    SELECT 1
+                                    FROM messageReactions
+                                    WHERE
+                                        accountJid = :accountJid AND chatJid = :chatJid AND messageSenderId = :messageSenderId AND messageId = :messageId AND
+                                        senderId IS :senderId AND
+                                        (timestamp >= :timestamp OR (:timestamp IS NULL AND timestamp IS NOT NULL))
+                                    LIMIT 1
+                                )"),
+                  values);
+
+        if (query.next()) {
+            return;
+        }
+    }
+
+    execQuery(query,
+              QStringLiteral(R"(
+                                SELECT emoji, deliveryState
+                                FROM messageReactions
+                                WHERE
+                                    accountJid = :accountJid AND chatJid = :chatJid AND messageSenderId = :messageSenderId AND messageId = :messageId AND
+                                    senderId IS :senderId
+                            )"),
+              bindKey());
+
+    MessageReactionSender reactionSender;
+    reactionSender.latestTimestamp = timestamp;
+
+    QList<QString> removedEmojis;
+
+    while (query.next()) {
+        MessageReaction reaction;
+        reaction.emoji = query.value(0).toString();
+        reaction.deliveryState = query.value(1).value<MessageReactionDeliveryState::Enum>();
+
+        // Keep existing reactions (including their delivery states) that are still received.
+        if (emojis.contains(reaction.emoji)) {
+            reactionSender.reactions.append(reaction);
+        } else {
+            removedEmojis.append(reaction.emoji);
+        }
+    }
+
+    const auto existingReactionCount = reactionSender.reactions.size();
+    QList<QString> addedEmojis;
+
+    for (const auto &emoji : emojis) {
+        if (std::ranges::none_of(reactionSender.reactions, [&emoji](const MessageReaction &reaction) {
+                return reaction.emoji == emoji;
+            })) {
+            MessageReaction reaction;
+            reaction.emoji = emoji;
+            reactionSender.reactions.append(reaction);
+            addedEmojis.append(emoji);
+        }
+    }
+
+    transaction();
+
+    for (const auto &emoji : std::as_const(removedEmojis)) {
+        auto values = bindKey();
+        values.insert(u":emoji", emoji);
+
+        execQuery(query,
+                  QStringLiteral(R"(
+                                    DELETE FROM messageReactions
+                                    WHERE
+                                        accountJid = :accountJid AND chatJid = :chatJid AND messageSenderId = :messageSenderId AND messageId = :messageId AND
+                                        senderId IS :senderId AND emoji = :emoji
+                                )"),
+                  values);
+    }
+
+    // Store the new timestamp for the kept reactions to process only newer ones afterwards.
+    if (existingReactionCount) {
+        auto values = bindKey();
+        values.insert(u":timestamp", timestamp);
+
+        execQuery(query,
+                  QStringLiteral(R"(
+                                    UPDATE messageReactions
+                                    SET timestamp = :timestamp
+                                    WHERE
+                                        accountJid = :accountJid AND chatJid = :chatJid AND messageSenderId = :messageSenderId AND messageId = :messageId AND
+                                        senderId IS :senderId
+                                )"),
+                  values);
+    }
+
+    for (const auto &emoji : std::as_const(addedEmojis)) {
+        insert(QString::fromLatin1(DB_TABLE_MESSAGE_REACTIONS),
+               {
+                   {u"accountJid", accountJid},
+                   {u"chatJid", chatJid},
+                   {u"messageSenderId", messageSenderId},
+                   {u"messageId", referenceId},
+                   {u"senderId", storedSenderId},
+                   {u"timestamp", timestamp},
+                   {u"deliveryState", static_cast<int>(MessageReactionDeliveryState::Delivered)},
+                   {u"emoji", emoji},
+               });
+    }
+
+    commit();
+
+    if (!removedEmojis.isEmpty() || !addedEmojis.isEmpty()) {
+        Q_EMIT reactionsChanged(accountJid, chatJid, referenceId, senderId, reactionSender);
+    }
+}
+
 void MessageDb::_setFileHashes(const QList<FileHash> &fileHashes)
 {
     thread_local static auto query = [this]() {
@@ -43,6 +43,15 @@ public:
         File file;
     };
 
+    /**
+     * Change of a file's transfer state and optionally of its local file path.
+     */
+    struct FileUpdate {
+        qint64 fileId = 0;
+        File::TransferState transferState = File::TransferState::Pending;
+        std::optional<QString> localFilePath;
+    };
+
     explicit MessageDb(QObject *parent = nullptr);
     ~MessageDb() override;
 
@@ -270,6 +279,50 @@ public:
                                     const QList<HttpSource> &httpSources,
                                     const QList<EncryptedSource> &encryptedSources);
 
+    /**
+     * Updates the transfer states and local file paths of files without loading their messages.
+     *
+     * Once all files of a message are transferred, the message's error text is reset.
+     * Instead of messageUpdated(), filesUpdated() is emitted once for all updates.
+     *
+     * @param updates changes of the files
+     */
+    QFuture<void> updateFiles(const QList<FileUpdate> &updates);
+    Q_SIGNAL void filesUpdated(const QList<MessageDb::FileUpdate> &updates);
+
+    /**
+     * Replaces the reactions of one sender to a message if they are newer than the stored ones.
+     *
+     * In contrast to updateMessage(), the message is not loaded and only the reactions of the
+     * sender are written.
+     * Instead of messageUpdated(), reactionsChanged() is emitted if the reactions changed.
+     *
+     * @param accountJid JID of the account
+     * @param chatJid JID of the chat
+     * @param messageId ID of the message being reacted to
+     * @param senderId ID of the reactions' sender
+     * @param emojis all emojis the sender currently reacts with
+     * @param timestamp time of the reactions
+     */
+    QFuture<void> updateReactions(const QString &accountJid,
+                                  const QString &chatJid,
+                                  const QString &messageId,
+                                  const QString &senderId,
+                                  const QList<QString> &emojis,
+                                  const QDateTime &timestamp);
+
+    /**
+     * Emitted when the reactions of one sender to a message changed.
+     *
+     * @param messageId reference ID of the message (see Message::referenceId())
+     * @param reactionSender all reactions of the sender (empty if the sender removed all reactions)
+     */
+    Q_SIGNAL void reactionsChanged(const QString &accountJid,
+                                   const QString &chatJid,
+                                   const QString &messageId,
+                                   const QString &senderId,
+                                   const MessageReactionSender &reactionSender);
+
     /**
      * Fetches a draft message from the database.
      */
@@ -302,6 +355,13 @@ private:
     void _fetchLatestFileId();
     void _fetchLatestFileGroupId();
     void _setFiles(const QList<File> &files);
+    void _updateFiles(const QList<FileUpdate> &updates);
+    void _updateReactions(const QString &accountJid,
+                          const QString &chatJid,
+                          const QString &messageId,
+                          const QString &senderId,
+                          const QList<QString> &emojis,
+                          const QDateTime &timestamp);
     void _setFileHashes(const QList<FileHash> &fileHashes);
     void _setHttpSources(const QList<HttpSource> &sources);
     void _setEncryptedSources(const QList<EncryptedSource> &sources);
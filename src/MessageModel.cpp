@@ -55,13 +55,21 @@ MessageModel::MessageModel(AccountSettings *accountSettings,
     , m_chatController(chatController)
     , m_messageController(messageController)
     , m_notificationController(notificationController)
+    , m_chatJid(chatController->jid())
 {
+    // The roster item is watched separately from the one of the chat controller because the model
+    // is kept up to date while it is cached and another chat is open.
+    m_rosterItemWatcher.setAccountJid(m_accountSettings->jid());
+    m_rosterItemWatcher.setJid(m_chatJid);
+
     connect(MessageDb::instance(), &MessageDb::messageAdded, this, &MessageModel::handleMessage);
     connect(MessageDb::instance(), &MessageDb::messageUpdated, this, &MessageModel::handleMessageUpdated);
+    connect(MessageDb::instance(), &MessageDb::filesUpdated, this, &MessageModel::handleFilesUpdated);
+    connect(MessageDb::instance(), &MessageDb::reactionsChanged, this, &MessageModel::handleReactionsChanged);
     connect(MessageDb::instance(), &MessageDb::messagesRemoved, this, &MessageModel::removeMessages);
 
-    connect(m_chatController, &ChatController::rosterItemChanged, this, [this]() {
-        if (m_lastReadOwnMessageId != m_chatController->rosterItem().lastReadOwnMessageId) {
+    connect(&m_rosterItemWatcher, &RosterItemWatcher::itemChanged, this, [this]() {
+        if (m_lastReadOwnMessageId != m_rosterItemWatcher.item().lastReadOwnMessageId) {
             updateLastReadOwnMessageId();
         }
     });
@@ -108,6 +116,7 @@ QHash<int, QByteArray> MessageModel::roleNames() const
     roles[OwnReactionsFailed] = QByteArrayLiteral("ownReactionsFailed");
     roles[GroupChatInvitationJid] = QByteArrayLiteral("groupChatInvitationJid");
     roles[GeoCoordinate] = QByteArrayLiteral("geoCoordinate");
+    roles[BodyTextType] = QByteArrayLiteral("bodyTextType");
     roles[Marked] = QByteArrayLiteral("marked");
     roles[ErrorText] = QByteArrayLiteral("errorText");
     return roles;
@@ -378,6 +387,9 @@ QVariant MessageModel::data(const QModelIndex &index, int role) const
     }
     case GeoCoordinate:
         return QVariant::fromValue(msg.geoCoordinate());
+    case BodyTextType:
+        // The text of an invitation is never displayed as emojis.
+        return QVariant::fromValue(msg.groupChatInvitation ? TextType::Mixed : msg.bodyTextType());
     case Marked:
         return msg.marked;
     case ErrorText:
@@ -395,31 +407,31 @@ void MessageModel::fetchMore(const QModelIndex &)
             // If there are unread messages, all messages until the first unread message are
             // fetched.
             // Otherwise, the messages are fetched by their regular limit.
-            if (m_chatController->rosterItem().unreadMessageCount) {
-                const auto lastReadContactMessageId = m_chatController->rosterItem().lastReadContactMessageId;
+            if (m_rosterItemWatcher.item().unreadMessageCount) {
+                const auto lastReadContactMessageId = m_rosterItemWatcher.item().lastReadContactMessageId;
 
                 // lastReadContactMessageId can be empty if there is no contact message stored or
                 // the oldest stored contact message is marked as first unread.
                 if (lastReadContactMessageId.isEmpty()) {
                     MessageDb::instance()
-                        ->fetchMessagesUntilFirstContactMessage(accountJid, m_chatController->jid(), 0)
+                        ->fetchMessagesUntilFirstContactMessage(accountJid, m_chatJid, 0)
                         .then(this, [this](QList<Message> &&messages) {
                             handleMessagesFetched(messages);
                         });
                 } else {
                     MessageDb::instance()
-                        ->fetchMessagesUntilId(accountJid, m_chatController->jid(), 0, lastReadContactMessageId)
+                        ->fetchMessagesUntilId(accountJid, m_chatJid, 0, lastReadContactMessageId)
                         .then(this, [this](MessageDb::MessageResult &&result) {
                             handleMessagesFetched(result.messages);
                         });
                 }
             } else {
-                MessageDb::instance()->fetchMessages(accountJid, m_chatController->jid(), 0).then(this, [this](QList<Message> &&messages) {
+                MessageDb::instance()->fetchMessages(accountJid, m_chatJid, 0).then(this, [this](QList<Message> &&messages) {
                     handleMessagesFetched(messages);
                 });
             }
         } else {
-            MessageDb::instance()->fetchMessages(accountJid, m_chatController->jid(), m_messages.size()).then(this, [this](QList<Message> &&messages) {
+            MessageDb::instance()->fetchMessages(accountJid, m_chatJid, m_messages.size()).then(this, [this](QList<Message> &&messages) {
                 handleMessagesFetched(messages);
             });
         }
@@ -429,8 +441,8 @@ void MessageModel::fetchMore(const QModelIndex &)
         if (!m_mamLoading) {
             setMamLoading(true);
 
-            const auto chatJid = m_chatController->jid();
-            const auto isGroupChat = m_chatController->rosterItem().isGroupChat();
+            const auto chatJid = m_chatJid;
+            const auto isGroupChat = m_rosterItemWatcher.item().isGroupChat();
 
             if (m_messages.isEmpty()) {
                 m_messageController->retrieveBacklogMessages(chatJid, isGroupChat).then([this](bool complete) {
@@ -460,7 +472,7 @@ void MessageModel::resendMessage(int index)
 
     const auto message = m_messages.at(index);
 
-    MessageDb::instance()->updateMessage(m_accountSettings->jid(), m_chatController->jid(), message.referenceId(), [](Message &message) {
+    MessageDb::instance()->updateMessage(m_accountSettings->jid(), m_chatJid, message.referenceId(), [](Message &message) {
         message.deliveryState = DeliveryState::Pending;
     });
 
@@ -474,7 +486,7 @@ void MessageModel::handleMessageRead(int readMessageIndex)
         return;
     }
 
-    const auto &lastReadContactMessageId = m_chatController->rosterItem().lastReadContactMessageId;
+    const auto &lastReadContactMessageId = m_rosterItemWatcher.item().lastReadContactMessageId;
 
     // Skip messages that are read but older than the last read message.
     for (int i = 0; i != m_messages.size(); ++i) {
@@ -511,18 +523,18 @@ void MessageModel::handleMessageRead(int readMessageIndex)
     const auto isApplicationActive = QGuiApplication::applicationState() == Qt::ApplicationActive;
 
     if (lastReadContactMessageId != readMessageId && isApplicationActive) {
-        m_notificationController->closeMessageNotification(m_chatController->jid());
+        m_notificationController->closeMessageNotification(m_chatJid);
 
         bool readMarkerPending = true;
         if (Enums::ConnectionState(m_connection->state()) == Enums::ConnectionState::StateConnected) {
-            if (m_chatController->rosterItem().readMarkerSendingEnabled) {
-                m_messageController->sendReadMarker(m_chatController->jid(), readMessageId);
+            if (m_rosterItemWatcher.item().readMarkerSendingEnabled) {
+                m_messageController->sendReadMarker(m_chatJid, readMessageId);
             }
 
             readMarkerPending = false;
         }
 
-        RosterDb::instance()->updateItem(m_accountSettings->jid(), m_chatController->jid(), [=](RosterItem &item) {
+        RosterDb::instance()->updateItem(m_accountSettings->jid(), m_chatJid, [=](RosterItem &item) {
             item.lastReadContactMessageId = readMessageId;
             item.readMarkerPending = readMarkerPending;
         });
@@ -536,7 +548,7 @@ int MessageModel::firstUnreadContactMessageIndex() const
 
 void MessageModel::setMessageMarked(int index, bool marked)
 {
-    MessageDb::instance()->updateMessage(m_accountSettings->jid(), m_chatController->jid(), m_messages.at(index).id, [marked](Message &message) {
+    MessageDb::instance()->updateMessage(m_accountSettings->jid(), m_chatJid, m_messages.at(index).id, [marked](Message &message) {
         message.marked = marked;
     });
 }
@@ -548,7 +560,7 @@ void MessageModel::addMessageReaction(const QString &messageId, const QString &e
     });
 
     if (itr != m_messages.cend()) {
-        const auto rosterItem = m_chatController->rosterItem();
+        const auto rosterItem = m_rosterItemWatcher.item();
         const auto senderId = m_accountSettings->jid();
         const auto reactions = itr->reactionSenders.value(senderId).reactions;
 
@@ -557,8 +569,8 @@ void MessageModel::addMessageReaction(const QString &messageId, const QString &e
         }
 
         auto addReaction = [this, messageId, senderId, emoji](MessageReactionDeliveryState::Enum deliveryState) -> QFuture<void> {
-            return MessageDb::instance()->updateMessage(m_chatController->account()->settings()->jid(),
-                                                        m_chatController->jid(),
+            return MessageDb::instance()->updateMessage(m_accountSettings->jid(),
+                                                        m_chatJid,
                                                         messageId,
                                                         [senderId, emoji, deliveryState](Message &message) {
                                                             auto &reactionSender = message.reactionSenders[senderId];
@@ -574,7 +586,7 @@ void MessageModel::addMessageReaction(const QString &messageId, const QString &e
         };
 
         auto future = addReaction(MessageReactionDeliveryState::PendingAddition);
-        future.then(this, [=, this, chatJid = m_chatController->jid()]() {
+        future.then(this, [=, this, chatJid = m_chatJid]() {
             if (ConnectionState(m_connection->state()) == Enums::ConnectionState::StateConnected) {
                 QList<QString> emojis;
 
@@ -596,7 +608,7 @@ void MessageModel::addMessageReaction(const QString &messageId, const QString &e
                 m_messageController
                     ->sendMessageReaction(chatJid,
                                           messageId,
-                                          m_chatController->rosterItem().isGroupChat(),
+                                          m_rosterItemWatcher.item().isGroupChat(),
                                           emojis,
                                           m_chatController->activeEncryption(),
                                           m_chatController->groupChatUserJids())
@@ -605,8 +617,8 @@ void MessageModel::addMessageReaction(const QString &messageId, const QString &e
                             Q_EMIT MainController::instance()->passiveNotificationRequested(
                                 tr("Reaction could not be sent: %1", "%1 is an error message").arg(error->description));
 
-                            MessageDb::instance()->updateMessage(m_chatController->account()->settings()->jid(),
-                                                                 m_chatController->jid(),
+                            MessageDb::instance()->updateMessage(m_accountSettings->jid(),
+                                                                 m_chatJid,
                                                                  messageId,
                                                                  [senderId, emoji](Message &message) {
                                                                      auto &reactionSender = message.reactionSenders[senderId];
@@ -622,7 +634,7 @@ void MessageModel::addMessageReaction(const QString &messageId, const QString &e
                                                                      }
                                                                  });
                         } else {
-                            m_messageController->updateMessageReactionsAfterSending(m_chatController->jid(), messageId, senderId);
+                            m_messageController->updateMessageReactionsAfterSending(m_chatJid, messageId, senderId);
                         }
                     });
             }
@@ -637,7 +649,7 @@ void MessageModel::removeMessageReaction(const QString &messageId, const QString
     });
 
     if (itr != m_messages.cend()) {
-        const auto rosterItem = m_chatController->rosterItem();
+        const auto rosterItem = m_rosterItemWatcher.item();
         const auto senderId = m_accountSettings->jid();
         const auto &reactions = itr->reactionSenders.value(senderId).reactions;
 
@@ -645,8 +657,8 @@ void MessageModel::removeMessageReaction(const QString &messageId, const QString
             return;
         }
 
-        auto future = MessageDb::instance()->updateMessage(m_chatController->account()->settings()->jid(),
-                                                           m_chatController->jid(),
+        auto future = MessageDb::instance()->updateMessage(m_accountSettings->jid(),
+                                                           m_chatJid,
                                                            messageId,
                                                            [senderId, emoji](Message &message) {
                                                                auto &reactionSenders = message.reactionSenders;
@@ -668,7 +680,7 @@ void MessageModel::removeMessageReaction(const QString &messageId, const QString
                                                                }
                                                            });
 
-        future.then(this, [this, messageId, senderId, emoji, itr, chatJid = m_chatController->jid()]() {
+        future.then(this, [this, messageId, senderId, emoji, itr, chatJid = m_chatJid]() {
             if (ConnectionState(m_connection->state()) == Enums::ConnectionState::StateConnected) {
                 const auto &reactionSenders = itr->reactionSenders;
                 const auto &reactions = reactionSenders[senderId].reactions;
@@ -693,7 +705,7 @@ void MessageModel::removeMessageReaction(const QString &messageId, const QString
                 m_messageController
                     ->sendMessageReaction(chatJid,
                                           messageId,
-                                          m_chatController->rosterItem().isGroupChat(),
+                                          m_rosterItemWatcher.item().isGroupChat(),
                                           emojis,
                                           m_chatController->activeEncryption(),
                                           m_chatController->groupChatUserJids())
@@ -702,8 +714,8 @@ void MessageModel::removeMessageReaction(const QString &messageId, const QString
                             Q_EMIT MainController::instance()->passiveNotificationRequested(
                                 tr("Reaction could not be sent: %1", "%1 is an error message").arg(error->description));
 
-                            MessageDb::instance()->updateMessage(m_chatController->account()->settings()->jid(),
-                                                                 m_chatController->jid(),
+                            MessageDb::instance()->updateMessage(m_accountSettings->jid(),
+                                                                 m_chatJid,
                                                                  messageId,
                                                                  [senderId, emoji](Message &message) {
                                                                      auto &reactions = message.reactionSenders[senderId].reactions;
@@ -724,7 +736,7 @@ void MessageModel::removeMessageReaction(const QString &messageId, const QString
                                                                      }
                                                                  });
                         } else {
-                            m_messageController->updateMessageReactionsAfterSending(m_chatController->jid(), messageId, senderId);
+                            m_messageController->updateMessageReactionsAfterSending(m_chatJid, messageId, senderId);
                         }
                     });
             }
@@ -739,10 +751,10 @@ void MessageModel::resendMessageReactions(const QString &messageId)
     });
 
     if (itr != m_messages.cend()) {
-        const auto rosterItem = m_chatController->rosterItem();
+        const auto rosterItem = m_rosterItemWatcher.item();
         const auto senderId = m_accountSettings->jid();
 
-        MessageDb::instance()->updateMessage(m_chatController->account()->settings()->jid(), m_chatController->jid(), messageId, [senderId](Message &message) {
+        MessageDb::instance()->updateMessage(m_accountSettings->jid(), m_chatJid, messageId, [senderId](Message &message) {
             auto &reactionSender = message.reactionSenders[senderId];
             reactionSender.latestTimestamp = QDateTime::currentDateTimeUtc();
 
@@ -776,9 +788,9 @@ void MessageModel::resendMessageReactions(const QString &messageId)
             }
 
             m_messageController
-                ->sendMessageReaction(m_chatController->jid(),
+                ->sendMessageReaction(m_chatJid,
                                       messageId,
-                                      m_chatController->rosterItem().isGroupChat(),
+                                      m_rosterItemWatcher.item().isGroupChat(),
                                       emojis,
                                       m_chatController->activeEncryption(),
                                       m_chatController->groupChatUserJids())
@@ -787,8 +799,8 @@ void MessageModel::resendMessageReactions(const QString &messageId)
                         Q_EMIT MainController::instance()->passiveNotificationRequested(
                             tr("Reactions could not be sent: %1", "%1 is an error message").arg(error->description));
 
-                        MessageDb::instance()->updateMessage(m_chatController->account()->settings()->jid(),
-                                                             m_chatController->jid(),
+                        MessageDb::instance()->updateMessage(m_accountSettings->jid(),
+                                                             m_chatJid,
                                                              messageId,
                                                              [senderId](Message &message) {
                                                                  auto &reactionSender = message.reactionSenders[senderId];
@@ -811,7 +823,7 @@ void MessageModel::resendMessageReactions(const QString &messageId)
                                                                  }
                                                              });
                     } else {
-                        m_messageController->updateMessageReactionsAfterSending(m_chatController->jid(), messageId, senderId);
+                        m_messageController->updateMessageReactionsAfterSending(m_chatJid, messageId, senderId);
                     }
                 });
         }
@@ -874,7 +886,7 @@ bool MessageModel::canCorrectMessage(int index) const
 
 void MessageModel::deleteFile(const QString &messageId, const File &file)
 {
-    MessageDb::instance()->updateMessage(m_accountSettings->jid(), m_chatController->jid(), messageId, [fileId = file.id](Message &message) {
+    MessageDb::instance()->updateMessage(m_accountSettings->jid(), m_chatJid, messageId, [fileId = file.id](Message &message) {
         auto it = std::ranges::find_if(message.files, [fileId](const auto &file) {
             return file.id == fileId;
         });
@@ -898,8 +910,8 @@ void MessageModel::removeMessage(const QString &messageId)
     if (itr != m_messages.cend()) {
         int readMessageIndex = std::ranges::distance(m_messages.cbegin(), itr);
 
-        const QString &lastReadContactMessageId = m_chatController->rosterItem().lastReadContactMessageId;
-        const QString &lastReadOwnMessageId = m_chatController->rosterItem().lastReadOwnMessageId;
+        const QString &lastReadContactMessageId = m_rosterItemWatcher.item().lastReadContactMessageId;
+        const QString &lastReadOwnMessageId = m_rosterItemWatcher.item().lastReadOwnMessageId;
 
         if (lastReadContactMessageId == messageId || lastReadOwnMessageId == messageId) {
             handleMessageRead(readMessageIndex);
@@ -912,14 +924,14 @@ void MessageModel::removeMessage(const QString &messageId)
                 isNewLastReadMessageIdValid && newLastReadMessageIndex < m_messages.size() ? m_messages.at(newLastReadMessageIndex).id : QString()};
 
             if (newLastReadMessageId.isEmpty()) {
-                RosterDb::instance()->updateItem(m_accountSettings->jid(), m_chatController->jid(), [=](RosterItem &item) {
+                RosterDb::instance()->updateItem(m_accountSettings->jid(), m_chatJid, [=](RosterItem &item) {
                     item.lastReadContactMessageId.clear();
                     item.lastReadOwnMessageId.clear();
                     item.lastMessage.clear();
                     item.lastMessageGroupChatSenderName.clear();
                 });
             } else {
-                RosterDb::instance()->updateItem(m_accountSettings->jid(), m_chatController->jid(), [=](RosterItem &item) {
+                RosterDb::instance()->updateItem(m_accountSettings->jid(), m_chatJid, [=](RosterItem &item) {
                     if (itr->isOwn) {
                         item.lastReadOwnMessageId = newLastReadMessageId;
                     } else {
@@ -962,6 +974,46 @@ void MessageModel::removeAllMessages()
     setMamLoading(false);
 }
 
+QString MessageModel::chatJid() const
+{
+    return m_chatJid;
+}
+
+bool MessageModel::reactivate()
+{
+    if (m_messages.isEmpty()) {
+        return false;
+    }
+
+    if (const auto &rosterItem = m_rosterItemWatcher.item(); rosterItem.unreadMessageCount) {
+        const auto &lastReadContactMessageId = rosterItem.lastReadContactMessageId;
+
+        // lastReadContactMessageId is empty if the oldest stored contact message is the first
+        // unread one.
+        const auto allUnreadMessagesLoaded = lastReadContactMessageId.isEmpty()
+            ? m_fetchedAllFromDb
+            : std::ranges::any_of(m_messages, [&lastReadContactMessageId](const Message &message) {
+                  return !message.isOwn && message.id == lastReadContactMessageId;
+              });
+
+        if (!allUnreadMessagesLoaded) {
+            return false;
+        }
+    }
+
+    updateFirstUnreadContactMessageIndex();
+
+    // The view is positioned once the model is set for it as if the messages were fetched.
+    QMetaObject::invokeMethod(
+        this,
+        [this]() {
+            Q_EMIT messageFetchingFinished();
+        },
+        Qt::QueuedConnection);
+
+    return true;
+}
+
 int MessageModel::searchMessageById(const QString &messageId)
 {
     int i = 0;
@@ -973,7 +1025,7 @@ int MessageModel::searchMessageById(const QString &messageId)
     }
 
     MessageDb::instance()
-        ->fetchMessagesUntilId(m_accountSettings->jid(), m_chatController->jid(), i, messageId, 0)
+        ->fetchMessagesUntilId(m_accountSettings->jid(), m_chatJid, i, messageId, 0)
         .then(this, [this](MessageDb::MessageResult &&result) {
             if (const auto messages = result.messages; !messages.isEmpty()) {
                 handleMessagesFetched(messages);
@@ -997,7 +1049,7 @@ int MessageModel::searchForMessageFromNewToOld(const QString &searchString, int
         }
 
         MessageDb::instance()
-            ->fetchMessagesUntilQueryString(m_accountSettings->jid(), m_chatController->jid(), foundIndex, searchString)
+            ->fetchMessagesUntilQueryString(m_accountSettings->jid(), m_chatJid, foundIndex, searchString)
             .then(this, [this](MessageDb::MessageResult &&result) {
                 handleMessagesFetched(result.messages);
                 Q_EMIT messageSearchFinished(result.queryIndex);
@@ -1071,10 +1123,10 @@ void MessageModel::handleMamBacklogRetrieved(bool complete)
         m_fetchedAllFromMam = true;
     }
 
-    if (m_chatController->rosterItem().lastReadContactMessageId.isEmpty()) {
+    if (m_rosterItemWatcher.item().lastReadContactMessageId.isEmpty()) {
         for (const auto &message : std::as_const(m_messages)) {
             if (!message.isOwn) {
-                RosterDb::instance()->updateItem(m_accountSettings->jid(), m_chatController->jid(), [=, messageId = message.id](RosterItem &item) {
+                RosterDb::instance()->updateItem(m_accountSettings->jid(), m_chatJid, [=, messageId = message.id](RosterItem &item) {
                     item.lastReadContactMessageId = messageId;
                 });
                 break;
@@ -1087,7 +1139,7 @@ void MessageModel::handleMamBacklogRetrieved(bool complete)
 
 void MessageModel::handleMessage(Message msg, MessageOrigin)
 {
-    if (msg.accountJid == m_accountSettings->jid() && msg.chatJid == m_chatController->jid()) {
+    if (msg.accountJid == m_accountSettings->jid() && msg.chatJid == m_chatJid) {
         addMessage(std::move(msg));
     }
 }
@@ -1115,6 +1167,71 @@ void MessageModel::handleMessageUpdated(Message message)
     }
 }
 
+void MessageModel::handleFilesUpdated(const QList<MessageDb::FileUpdate> &updates)
+{
+    QHash<qint64, const MessageDb::FileUpdate *> updatesByFileId;
+    updatesByFileId.reserve(updates.size());
+
+    for (const auto &update : updates) {
+        updatesByFileId.insert(update.fileId, &update);
+    }
+
+    for (int i = 0; i < m_messages.size() && !updatesByFileId.isEmpty(); i++) {
+        auto &message = m_messages[i];
+        QList<int> changedRoles;
+
+        for (auto &file : message.files) {
+            if (const auto update = updatesByFileId.take(file.id)) {
+                file.transferState = update->transferState;
+
+                if (update->localFilePath) {
+                    file.localFilePath = *update->localFilePath;
+                }
+
+                changedRoles = {Files};
+            }
+        }
+
+        if (!changedRoles.isEmpty()) {
+            // Reset the error text in the same way as MessageDb once all files are transferred.
+            if (!message.errorText.isEmpty() && std::ranges::all_of(message.files, [](const File &file) {
+                    return file.transferState == File::TransferState::Done;
+                })) {
+                message.errorText.clear();
+                changedRoles.append(ErrorText);
+            }
+
+            const auto modelIndex = index(i);
+            Q_EMIT dataChanged(modelIndex, modelIndex, changedRoles);
+        }
+    }
+}
+
+void MessageModel::handleReactionsChanged(const QString &accountJid,
+                                          const QString &chatJid,
+                                          const QString &messageId,
+                                          const QString &senderId,
+                                          const MessageReactionSender &reactionSender)
+{
+    if (accountJid != m_accountSettings->jid() || chatJid != m_chatJid) {
+        return;
+    }
+
+    for (int i = 0; i < m_messages.size(); i++) {
+        if (auto &message = m_messages[i]; message.referenceId() == messageId) {
+            if (reactionSender.reactions.isEmpty()) {
+                message.reactionSenders.remove(senderId);
+            } else {
+                message.reactionSenders.insert(senderId, reactionSender);
+            }
+
+            const auto modelIndex = index(i);
+            Q_EMIT dataChanged(modelIndex, modelIndex, {DisplayedReactions, DetailedReactions, OwnReactionsFailed});
+            break;
+        }
+    }
+}
+
 void MessageModel::handleDevicesChanged(QList<QString> jids)
 {
     // TODO: Search through all messages and only fetch trust levels for relevant keys, set those collected trust levels afterwards via another loop through all
@@ -1166,7 +1283,7 @@ void MessageModel::insertMessage(int idx, const Message &msg)
 
 void MessageModel::removeMessages(const QString &accountJid, const QString &chatJid)
 {
-    if (accountJid == m_accountSettings->jid() && chatJid == m_chatController->jid()) {
+    if (accountJid == m_accountSettings->jid() && chatJid == m_chatJid) {
         removeAllMessages();
     }
 }
@@ -1174,7 +1291,7 @@ void MessageModel::removeMessages(const QString &accountJid, const QString &chat
 void MessageModel::updateLastReadOwnMessageId()
 {
     const auto formerLastReadOwnMessageId = m_lastReadOwnMessageId;
-    m_lastReadOwnMessageId = m_chatController->rosterItem().lastReadOwnMessageId;
+    m_lastReadOwnMessageId = m_rosterItemWatcher.item().lastReadOwnMessageId;
     emitMessagesUpdated({formerLastReadOwnMessageId, m_lastReadOwnMessageId}, IsLastReadOwnMessage);
 }
 
@@ -1185,7 +1302,7 @@ void MessageModel::updateFirstUnreadContactMessageIndex()
     for (auto i = 0; i < m_messages.size(); ++i) {
         const auto &message = m_messages.at(i);
         const auto &messageId = message.id;
-        const auto lastReadContactMessageId = m_chatController->rosterItem().lastReadContactMessageId;
+        const auto lastReadContactMessageId = m_rosterItemWatcher.item().lastReadContactMessageId;
 
         // lastReadContactMessageId can be empty if there is no contact message stored or the oldest
         // stored contact message is marked as first unread.
@@ -1233,8 +1350,8 @@ bool MessageModel::undoMessageReactionRemoval(const QString &messageId, const QS
     });
 
     if (reactionItr != reactions.end()) {
-        MessageDb::instance()->updateMessage(m_chatController->account()->settings()->jid(),
-                                             m_chatController->jid(),
+        MessageDb::instance()->updateMessage(m_accountSettings->jid(),
+                                             m_chatJid,
                                              messageId,
                                              [senderJid, emoji](Message &message) {
                                                  auto &reactions = message.reactionSenders[senderJid].reactions;
@@ -1275,8 +1392,8 @@ bool MessageModel::undoMessageReactionAddition(const QString &messageId,
     });
 
     if (reactionItr != reactions.end()) {
-        MessageDb::instance()->updateMessage(m_chatController->account()->settings()->jid(),
-                                             m_chatController->jid(),
+        MessageDb::instance()->updateMessage(m_accountSettings->jid(),
+                                             m_chatJid,
                                              messageId,
                                              [senderJid, emoji](Message &message) {
                                                  auto &reactionSenders = message.reactionSenders;
@@ -16,6 +16,8 @@
 #include <QXmppStanzaId.h>
 // Kaidan
 #include "Message.h"
+#include "MessageDb.h"
+#include "RosterItemWatcher.h"
 
 class AccountSettings;
 class AtmController;
@@ -90,6 +92,7 @@ public:
         OwnReactionsFailed,
         GroupChatInvitationJid,
         GeoCoordinate,
+        BodyTextType,
         Marked,
         ErrorText,
     };
@@ -162,6 +165,21 @@ public:
 
     void removeAllMessages();
 
+    /**
+     * Returns the JID of the chat whose messages are loaded.
+     */
+    QString chatJid() const;
+
+    /**
+     * Prepares the model for being displayed again after it was cached while another chat was
+     * open.
+     *
+     * @return whether the loaded messages can be displayed without fetching them again, which is
+     *         not the case if they do not include the last read contact message while there are
+     *         unread messages
+     */
+    bool reactivate();
+
     /**
      * Searches a message locally by its ID.
      *
@@ -220,6 +238,12 @@ private:
 
     void handleMessage(Message msg, MessageOrigin);
     void handleMessageUpdated(Message message);
+    void handleFilesUpdated(const QList<MessageDb::FileUpdate> &updates);
+    void handleReactionsChanged(const QString &accountJid,
+                                const QString &chatJid,
+                                const QString &messageId,
+                                const QString &senderId,
+                                const MessageReactionSender &reactionSender);
 
     void handleDevicesChanged(QList<QString> jids);
 
@@ -296,6 +320,9 @@ private:
     MessageController *const m_messageController;
     NotificationController *const m_notificationController;
 
+    const QString m_chatJid;
+    RosterItemWatcher m_rosterItemWatcher;
+
     QList<Message> m_messages;
     QString m_lastReadOwnMessageId;
     int m_firstUnreadContactMessageIndex = -1;
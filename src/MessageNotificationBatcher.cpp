@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "MessageNotificationBatcher.h"
+
+MessageNotificationBatcher::MessageNotificationBatcher(Flush &&flush, std::chrono::milliseconds flushInterval, QObject *parent)
+    : ChatBatcher(flushInterval, parent)
+    , m_flush(std::move(flush))
+{
+}
+
+void MessageNotificationBatcher::addMessage(const QString &chatJid, const QString &messageId, const QString &text)
+{
+    m_notificationTexts[chatJid].append(messageId, text);
+    addPendingChat(chatJid);
+}
+
+void MessageNotificationBatcher::removeChat(const QString &chatJid)
+{
+    m_notificationTexts.remove(chatJid);
+    removePendingChat(chatJid);
+}
+
+void MessageNotificationBatcher::flushChat(const QString &chatJid)
+{
+    if (const auto itr = m_notificationTexts.constFind(chatJid); itr != m_notificationTexts.cend()) {
+        m_flush({chatJid, itr->latestMessageId, itr->text()});
+    }
+}
+
+void MessageNotificationBatcher::NotificationText::append(const QString &messageId, const QString &text)
+{
+    latestMessageId = messageId;
+
+    if (++messageCount == 1) {
+        firstMessageText = text;
+    } else {
+        firstMessageText.clear();
+    }
+
+    lines.append(text.split(u'\n'));
+
+    // If not all lines fit, the first displayed line is an ellipsis followed by the last lines.
+    if (lines.size() > (truncated ? MaximumTextLineCount - 1 : MaximumTextLineCount)) {
+        lines.remove(0, lines.size() - (MaximumTextLineCount - 1));
+        truncated = true;
+    }
+}
+
+QString MessageNotificationBatcher::NotificationText::text() const
+{
+    // A single message is displayed completely.
+    if (messageCount == 1) {
+        return firstMessageText;
+    }
+
+    if (truncated) {
+        return QStringLiteral("…\n") + lines.join(u'\n');
+    }
+
+    return lines.join(u'\n');
+}
+
+#include "moc_MessageNotificationBatcher.cpp"
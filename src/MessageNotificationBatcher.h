@@ -0,0 +1,80 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+// std
+#include <functional>
+// Qt
+#include <QHash>
+// Kaidan
+#include "ChatBatcher.h"
+
+/**
+ * Collects the messages to be notified about per chat and flushes them as notification updates.
+ *
+ * Many messages of the same chat can arrive back to back (e.g., during MAM catch-up) while
+ * updating a notification for each of them would rewrite it many times per second.
+ * Thus, the messages received until the event loop is entered again are flushed together.
+ * Afterwards, updates are flushed at most once per flush interval.
+ *
+ * The text of each chat's notification is limited to its last lines.
+ * It is updated incrementally by only splitting the new messages into lines.
+ */
+class MessageNotificationBatcher : public ChatBatcher
+{
+    Q_OBJECT
+
+public:
+    static constexpr std::chrono::milliseconds DefaultFlushInterval{500};
+    static constexpr int MaximumTextLineCount = 6;
+
+    struct Update {
+        QString chatJid;
+        QString latestMessageId;
+        QString text;
+    };
+
+    using Flush = std::function<void(const Update &update)>;
+
+    MessageNotificationBatcher(Flush &&flush, std::chrono::milliseconds flushInterval = DefaultFlushInterval, QObject *parent = nullptr);
+
+    /**
+     * Adds a message whose text is appended to the chat's notification.
+     *
+     * @param chatJid JID of the message's chat
+     * @param messageId ID of the message
+     * @param text text of the message to be displayed
+     */
+    void addMessage(const QString &chatJid, const QString &messageId, const QString &text);
+
+    /**
+     * Removes the text and the pending update of a chat's notification (e.g., once it is closed).
+     */
+    void removeChat(const QString &chatJid);
+
+protected:
+    void flushChat(const QString &chatJid) override;
+
+private:
+    struct NotificationText {
+        // Text of the only message as long as there is only one
+        QString firstMessageText;
+        qsizetype messageCount = 0;
+
+        // Last lines of all messages
+        QList<QString> lines;
+
+        // Whether older lines have been removed
+        bool truncated = false;
+
+        QString latestMessageId;
+
+        void append(const QString &messageId, const QString &text);
+        QString text() const;
+    };
+
+    const Flush m_flush;
+    QHash<QString, NotificationText> m_notificationTexts;
+};
@@ -280,9 +280,9 @@ void MixController::requestChannelUsers(const QString &channelJid)
                                 .arg(channelJid, error->description));
                     } else {
                         const auto jids = std::get<QList<QXmppMixManager::Jid>>(result);
-                        for (const auto &jid : jids) {
-                            handleJidAllowed(channelJid, jid);
-                        }
+                        Q_EMIT m_groupChatController->usersAllowedOrBanned(transform(jids, [this, &channelJid](const QXmppMixManager::Jid &jid) {
+                            return allowedOrBannedUser(channelJid, jid, GroupChatUser::Status::Allowed);
+                        }));
                     }
                 });
             }
@@ -295,9 +295,9 @@ void MixController::requestChannelUsers(const QString &channelJid)
                                 .arg(channelJid, error->description));
                     } else {
                         const auto jids = std::get<QList<QXmppMixManager::Jid>>(result);
-                        for (const auto &jid : jids) {
-                            handleJidBanned(channelJid, jid);
-                        }
+                        Q_EMIT m_groupChatController->usersAllowedOrBanned(transform(jids, [this, &channelJid](const QXmppMixManager::Jid &jid) {
+                            return allowedOrBannedUser(channelJid, jid, GroupChatUser::Status::Banned);
+                        }));
                     }
                 });
             }
@@ -310,9 +310,9 @@ void MixController::requestChannelUsers(const QString &channelJid)
                 tr("Joined users of %1 could not be retrieved: %2", "%1 is a channel JID, %2 an error message").arg(channelJid, error->description));
         } else {
             const auto participants = std::get<QList<QXmppMixParticipantItem>>(result);
-            for (const auto &participant : participants) {
-                handleParticipantReceived(channelJid, participant);
-            }
+            Q_EMIT m_groupChatController->participantsReceived(transform(participants, [this, &channelJid](const QXmppMixParticipantItem &participantItem) {
+                return participant(channelJid, participantItem);
+            }));
         }
     });
 }
@@ -413,13 +413,7 @@ void MixController::handleChannelAccessibilityReceived(const QString &channelJid
 
 void MixController::handleJidAllowed(const QString &channelJid, const QString &jid)
 {
-    GroupChatUser user;
-    user.accountJid = m_accountSettings->jid();
-    user.chatJid = channelJid;
-    user.jid = jid;
-    user.status = GroupChatUser::Status::Allowed;
-
-    Q_EMIT m_groupChatController->userAllowedOrBanned(user);
+    Q_EMIT m_groupChatController->userAllowedOrBanned(allowedOrBannedUser(channelJid, jid, GroupChatUser::Status::Allowed));
 }
 
 void MixController::handleJidDisallowed(const QString &channelJid, const QString &jid)
@@ -435,13 +429,7 @@ void MixController::handleJidDisallowed(const QString &channelJid, const QString
 
 void MixController::handleJidBanned(const QString &channelJid, const QString &jid)
 {
-    GroupChatUser user;
-    user.accountJid = m_accountSettings->jid();
-    user.chatJid = channelJid;
-    user.jid = jid;
-    user.status = GroupChatUser::Status::Banned;
-
-    Q_EMIT m_groupChatController->userAllowedOrBanned(user);
+    Q_EMIT m_groupChatController->userAllowedOrBanned(allowedOrBannedUser(channelJid, jid, GroupChatUser::Status::Banned));
 }
 
 void MixController::handleJidUnbanned(const QString &channelJid, const QString &jid)
@@ -456,25 +444,39 @@ void MixController::handleJidUnbanned(const QString &channelJid, const QString &
 }
 
 void MixController::handleParticipantReceived(const QString &channelJid, const QXmppMixParticipantItem &participantItem)
+{
+    Q_EMIT m_groupChatController->participantReceived(participant(channelJid, participantItem));
+}
+
+void MixController::handleParticipantLeft(const QString &channelJid, const QString &participantId)
 {
     GroupChatUser user;
     user.accountJid = m_accountSettings->jid();
     user.chatJid = channelJid;
-    user.id = participantItem.id();
-    user.jid = participantItem.jid();
-    user.name = participantItem.nick();
+    user.id = participantId;
 
-    Q_EMIT m_groupChatController->participantReceived(user);
+    Q_EMIT m_groupChatController->participantLeft(user);
 }
 
-void MixController::handleParticipantLeft(const QString &channelJid, const QString &participantId)
+GroupChatUser MixController::allowedOrBannedUser(const QString &channelJid, const QString &jid, GroupChatUser::Status status) const
 {
     GroupChatUser user;
     user.accountJid = m_accountSettings->jid();
     user.chatJid = channelJid;
-    user.id = participantId;
+    user.jid = jid;
+    user.status = status;
+    return user;
+}
 
-    Q_EMIT m_groupChatController->participantLeft(user);
+GroupChatUser MixController::participant(const QString &channelJid, const QXmppMixParticipantItem &participantItem) const
+{
+    GroupChatUser user;
+    user.accountJid = m_accountSettings->jid();
+    user.chatJid = channelJid;
+    user.id = participantItem.id();
+    user.jid = participantItem.jid();
+    user.name = participantItem.nick();
+    return user;
 }
 
 void MixController::handleChannelDeleted(const QString &channelJid)
@@ -12,6 +12,8 @@
 #include <QXmppMixManager.h>
 #include <QXmppMixParticipantItem.h>
 #include <QXmppStanza.h>
+// Kaidan
+#include "GroupChatUser.h"
 
 // QXmpp
 class QXmppMixInfoItem;
@@ -70,6 +72,9 @@ private:
     void handleParticipantReceived(const QString &channelJid, const QXmppMixParticipantItem &participantItem);
     void handleParticipantLeft(const QString &channelJid, const QString &participantId);
 
+    GroupChatUser allowedOrBannedUser(const QString &channelJid, const QString &jid, GroupChatUser::Status status) const;
+    GroupChatUser participant(const QString &channelJid, const QXmppMixParticipantItem &participantItem) const;
+
     /**
      * Called after a channel is deleted.
      *
@@ -19,7 +19,7 @@
 #include "AvatarCache.h"
 #include "Call.h"
 #include "ChatController.h"
-#include "GroupChatUserDb.h"
+#include "GroupChatMentionDetector.h"
 #include "MainController.h"
 #include "MessageController.h"
 #include "MessageDb.h"
@@ -43,7 +43,6 @@ constexpr QStringView PRESENCE_SUBSCRIPTION_REQUEST_EVENT_ID = u"presence-subscr
 constexpr QStringView NEW_CALL_EVENT_ID = u"new-call";
 
 constexpr auto SUBSEQUENT_MESSAGE_INTERVAL = 5s;
-constexpr int MAXIMUM_NOTIFICATION_TEXT_LINE_COUNT = 6;
 
 #ifdef DESKTOP_LINUX_ALIKE_OS
 static bool IS_USING_GNOME = qEnvironmentVariable("XDG_CURRENT_DESKTOP").contains(QStringLiteral("GNOME"), Qt::CaseInsensitive);
@@ -58,6 +57,10 @@ NotificationController::NotificationController(AccountSettings *accountSettings,
     , m_accountSettings(accountSettings)
     , m_avatarCache(avatarCache)
     , m_messageController(messageController)
+    , m_groupChatMentionDetector(new GroupChatMentionDetector(this))
+    , m_messageNotificationBatcher(new MessageNotificationBatcher(std::bind(&NotificationController::sendMessageNotification, this, std::placeholders::_1),
+                                                                  MessageNotificationBatcher::DefaultFlushInterval,
+                                                                  this))
 {
     connect(MessageDb::instance(), &MessageDb::messageAdded, this, &NotificationController::handleMessage);
     connect(MessageDb::instance(), &MessageDb::messageUpdated, this, [this](const Message &message) {
@@ -72,6 +75,9 @@ NotificationController::NotificationController(AccountSettings *accountSettings,
 
 void NotificationController::closeMessageNotification(const QString &chatJid)
 {
+    // Pending messages are not notified anymore.
+    m_messageNotificationBatcher->removeChat(chatJid);
+
     const auto notificationWrapperItr = std::ranges::find_if(m_openMessageNotifications, [chatJid](const MessageNotificationWrapper &notificationWrapper) {
         return notificationWrapper.chatJid == chatJid;
     });
@@ -173,7 +179,7 @@ void NotificationController::handleMessage(const Message &message, MessageOrigin
             const auto notificationBody = message.isGroupChatMessage() ? message.groupChatSenderName + QStringLiteral(": ") + previewText : previewText;
 
             if (!checkChatActive(chatJid)) {
-                sendMessageNotification(chatJid, message.id, notificationBody);
+                m_messageNotificationBatcher->addMessage(chatJid, message.id, notificationBody);
             }
         };
 
@@ -183,13 +189,7 @@ void NotificationController::handleMessage(const Message &message, MessageOrigin
                 return;
             }
 
-            GroupChatUserDb::instance()
-                ->user(accountJid, chatJid, rosterItem->groupChatParticipantId)
-                .then(this, [body = message.body(), sendNotification](const std::optional<GroupChatUser> user) {
-                    if (user && (body.contains(user->id) || body.contains(user->jid) || body.contains(user->name))) {
-                        sendNotification();
-                    }
-                });
+            m_groupChatMentionDetector->checkMention(accountJid, chatJid, rosterItem->groupChatParticipantId, message.body(), sendNotification);
         };
 
         switch (rosterItem->effectiveNotificationRule()) {
@@ -215,8 +215,17 @@ void NotificationController::handlePresenceSubscriptionRequestReceived(const QXm
     }
 }
 
-void NotificationController::sendMessageNotification(const QString &chatJid, const QString &messageId, const QString &messageBody)
+void NotificationController::sendMessageNotification(const MessageNotificationBatcher::Update &update)
 {
+    const auto &chatJid = update.chatJid;
+    const auto &messageId = update.latestMessageId;
+
+    // Messages queued before their chat became active are not notified anymore.
+    if (checkChatActive(chatJid)) {
+        closeMessageNotification(chatJid);
+        return;
+    }
+
     KNotification *notification = nullptr;
 
     auto notificationWrapperItr = std::ranges::find_if(m_openMessageNotifications, [&chatJid](const auto &notificationWrapper) {
@@ -225,50 +234,6 @@ void NotificationController::sendMessageNotification(const QString &chatJid, con
 
     // Update an existing notification or create a new one.
     if (notificationWrapperItr != m_openMessageNotifications.end()) {
-        auto &messages = notificationWrapperItr->messages;
-        messages.append(messageBody);
-
-        // Initialize variables by known values.
-        notificationWrapperItr->latestMessageId = messageId;
-
-        QList<QString> notificationTextLines;
-
-        // Append the message's body to the text of existing notifications.
-        // If the text of the existing notifications and messageBody contain together more than
-        // MAXIMUM_NOTIFICATION_TEXT_LINE_COUNT of lines, keep only the last
-        // MAXIMUM_NOTIFICATION_TEXT_LINE_COUNT - 1 of them and replace the first one by an
-        // ellipse.
-        //
-        // The loop exits in the following cases:
-        // 1. The message of the current iteration has lines that would result in more
-        // lines than MAXIMUM_NOTIFICATION_TEXT_LINE_COUNT when prepended to
-        // notificationTextLines.
-        // 2. notificationTextLines would have more lines than
-        // MAXIMUM_NOTIFICATION_TEXT_LINE_COUNT when the next message was being prepended.
-        for (auto messageItr = messages.end() - 1; messageItr != messages.begin() - 1; --messageItr) {
-            auto messageNotificationTextLines = (*messageItr).split(u'\n');
-            const auto overflowingMessageLineCount = messageNotificationTextLines.size() + notificationTextLines.size() - MAXIMUM_NOTIFICATION_TEXT_LINE_COUNT;
-
-            if (overflowingMessageLineCount > 0) {
-                messageNotificationTextLines = messageNotificationTextLines.mid(overflowingMessageLineCount + 1);
-                messageNotificationTextLines.prepend(QStringLiteral("…"));
-
-                *messageItr = messageNotificationTextLines.join(u'\n');
-                messages.erase(messages.begin(), messageItr);
-
-                notificationTextLines = messageNotificationTextLines << notificationTextLines;
-                break;
-            } else {
-                notificationTextLines = messageNotificationTextLines << notificationTextLines;
-
-                if (notificationTextLines.size() == MAXIMUM_NOTIFICATION_TEXT_LINE_COUNT && messageItr - 1 != messages.begin() - 1) {
-                    notificationTextLines[0] = QStringLiteral("…");
-                    messages.erase(messages.begin(), messageItr);
-                    break;
-                }
-            }
-        }
-
         const auto previousTimestamp = notificationWrapperItr->previousTimestamp;
         const auto currentTimestamp = QDateTime::currentDateTimeUtc();
 
@@ -282,20 +247,16 @@ void NotificationController::sendMessageNotification(const QString &chatJid, con
             notification = new KNotification(NEW_SUBSEQUENT_MESSAGE_EVENT_ID.toString());
         }
 
-        notification->setText(notificationTextLines.join(u'\n'));
+        notification->setText(update.text);
 
         notificationWrapperItr->isDeletionEnabled = false;
         notificationWrapperItr->notification->close();
         notificationWrapperItr->notification = notification;
     } else {
         notification = new KNotification(NEW_MESSAGE_EVENT_ID.toString());
-        notification->setText(messageBody);
+        notification->setText(update.text);
 
-        MessageNotificationWrapper notificationWrapper{.chatJid = chatJid,
-                                                       .previousTimestamp = QDateTime::currentDateTimeUtc(),
-                                                       .latestMessageId = messageId,
-                                                       .messages = {messageBody},
-                                                       .notification = notification};
+        MessageNotificationWrapper notificationWrapper{.chatJid = chatJid, .previousTimestamp = QDateTime::currentDateTimeUtc(), .notification = notification};
         m_openMessageNotifications.append(notificationWrapper);
     }
 
@@ -336,6 +297,7 @@ void NotificationController::sendMessageNotification(const QString &chatJid, con
         if (notificationWrapperItr != m_openMessageNotifications.end()) {
             if (notificationWrapperItr->isDeletionEnabled) {
                 m_openMessageNotifications.erase(notificationWrapperItr);
+                m_messageNotificationBatcher->removeChat(chatJid);
             } else {
                 notificationWrapperItr->isDeletionEnabled = true;
             }
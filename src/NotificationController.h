@@ -13,6 +13,7 @@
 #include <QObject>
 // Kaidan
 #include "Message.h"
+#include "MessageNotificationBatcher.h"
 
 // KDE
 class KNotification;
@@ -23,6 +24,7 @@ class AccountSettings;
 class AvatarCache;
 class Call;
 class ChatController;
+class GroupChatMentionDetector;
 class MessageController;
 class RosterController;
 struct RosterItem;
@@ -35,8 +37,6 @@ public:
     struct MessageNotificationWrapper {
         QString chatJid;
         QDateTime previousTimestamp;
-        QString latestMessageId;
-        QList<QString> messages;
         bool isDeletionEnabled = true;
         KNotification *notification = nullptr;
     };
@@ -76,13 +76,11 @@ private:
     void handlePresenceSubscriptionRequestReceived(const QXmppPresence &request);
 
     /**
-     * Sends a system notification for a chat message.
+     * Sends or updates the system notification for the messages of a chat.
      *
-     * @param chatJid JID of the message's chat
-     * @param messageId ID of the message
-     * @param messageBody body of the message to display as the notification's text
+     * @param update text of the chat's notification and ID of the latest message
      */
-    void sendMessageNotification(const QString &chatJid, const QString &messageId, const QString &messageBody);
+    void sendMessageNotification(const MessageNotificationBatcher::Update &update);
 
     void sendPresenceSubscriptionRequestNotification(const QString &chatJid);
 
@@ -97,6 +95,8 @@ private:
     AccountSettings *const m_accountSettings;
     AvatarCache *const m_avatarCache;
     MessageController *const m_messageController;
+    GroupChatMentionDetector *const m_groupChatMentionDetector;
+    MessageNotificationBatcher *const m_messageNotificationBatcher;
 
     ChatController *m_chatController = nullptr;
 
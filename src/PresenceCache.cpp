@@ -76,30 +76,22 @@ PresenceCache::PresenceCache(QObject *parent)
 
 QString PresenceCache::pickIdealResource(const QString &jid)
 {
-    if (!m_presences.contains(jid))
-        return {};
-
-    const auto &userPresences = m_presences[jid];
-    if (userPresences.isEmpty())
-        return {};
-    if (userPresences.size() == 1)
-        return userPresences.firstKey();
-
-    auto result = userPresences.cbegin();
-    for (auto itr = std::next(result); itr != userPresences.cend(); itr++) {
-        if (presenceMoreImportant(*itr, *result))
-            result = itr;
+    if (const auto itr = m_presences.constFind(jid); itr != m_presences.cend()) {
+        return itr->idealResource;
     }
 
-    return result.key();
+    return {};
 }
 
 QList<QString> PresenceCache::resources(const QString &jid)
 {
-    if (!m_presences.contains(jid))
-        return {};
+    if (const auto itr = m_presences.constFind(jid); itr != m_presences.cend()) {
+        auto resources = itr->presences.keys();
+        std::ranges::sort(resources);
+        return resources;
+    }
 
-    return m_presences.value(jid).keys();
+    return {};
 }
 
 /**
@@ -110,18 +102,26 @@ QList<QString> PresenceCache::resources(const QString &jid)
  */
 int PresenceCache::resourcesCount(const QString &jid)
 {
-    return m_presences.value(jid).size();
+    if (const auto itr = m_presences.constFind(jid); itr != m_presences.cend()) {
+        return itr->presences.size();
+    }
+
+    return 0;
 }
 
 std::optional<QXmppPresence> PresenceCache::presence(const QString &jid)
 {
-    return presence(jid, pickIdealResource(jid));
+    if (const auto itr = m_presences.constFind(jid); itr != m_presences.cend()) {
+        return itr->idealPresence;
+    }
+
+    return std::nullopt;
 }
 
 std::optional<QXmppPresence> PresenceCache::presence(const QString &jid, const QString &resource)
 {
     if (const auto itr = m_presences.constFind(jid); itr != m_presences.cend()) {
-        if (const auto resourceItr = itr->constFind(resource); resourceItr != itr->cend()) {
+        if (const auto resourceItr = itr->presences.constFind(resource); resourceItr != itr->presences.cend()) {
             return *resourceItr;
         }
     }
@@ -136,11 +136,6 @@ void PresenceCache::updatePresence(const QXmppPresence &presence)
     const auto jid = QXmppUtils::jidToBareJid(presence.from());
     const auto resource = QXmppUtils::jidToResource(presence.from());
 
-    if (!m_presences.contains(jid))
-        m_presences.insert(jid, {});
-
-    auto &userPresences = m_presences[jid];
-
     //
     // Presence updates can only go this way:
     //                  /---------------------------v
@@ -150,23 +145,37 @@ void PresenceCache::updatePresence(const QXmppPresence &presence)
     //                          ^_______/
     //
 
-    if (userPresences.contains(resource)) {
+    auto itr = m_presences.find(jid);
+
+    if (itr != m_presences.end() && itr->presences.contains(resource)) {
         if (presence.type() == QXmppPresence::Available) {
-            m_presences[jid][resource] = presence;
-            Q_EMIT presenceChanged(Updated, jid, resource);
+            itr->presences.insert(resource, presence);
+            const auto idealPresenceChanged = updateIdealResource(*itr, resource);
+
+            Q_EMIT presenceChanged(Updated, jid, resource, idealPresenceChanged);
         } else {
             // presence is 'Unavailable'
-            userPresences.remove(resource);
-            if (userPresences.isEmpty())
-                m_presences.remove(jid);
-
-            Q_EMIT presenceChanged(Disconnected, jid, resource);
+            itr->presences.remove(resource);
+
+            if (itr->presences.isEmpty()) {
+                m_presences.erase(itr);
+                Q_EMIT presenceChanged(Disconnected, jid, resource, true);
+            } else {
+                const auto idealPresenceChanged = updateIdealResource(*itr, resource);
+                Q_EMIT presenceChanged(Disconnected, jid, resource, idealPresenceChanged);
+            }
         }
     } else {
         // client is unknown (hasn't been cached yet)
         if (presence.type() == QXmppPresence::Available) {
-            userPresences.insert(resource, presence);
-            Q_EMIT presenceChanged(Connected, jid, resource);
+            if (itr == m_presences.end()) {
+                itr = m_presences.insert(jid, {});
+            }
+
+            itr->presences.insert(resource, presence);
+            const auto idealPresenceChanged = updateIdealResource(*itr, resource);
+
+            Q_EMIT presenceChanged(Connected, jid, resource, idealPresenceChanged);
         }
 
         // presences from unknown clients that are unavailable are ignored
@@ -179,6 +188,39 @@ void PresenceCache::clear()
     Q_EMIT presencesCleared();
 }
 
+bool PresenceCache::updateIdealResource(UserPresences &userPresences, const QString &changedResource)
+{
+    const auto &presences = userPresences.presences;
+
+    if (const auto changedItr = presences.constFind(changedResource); changedItr != presences.cend() && changedResource != userPresences.idealResource) {
+        // A presence of another resource than the ideal one only needs to be compared with the
+        // ideal presence.
+        if (userPresences.idealResource.isEmpty()
+            || resourceMoreImportant(changedResource, *changedItr, userPresences.idealResource, userPresences.idealPresence)) {
+            userPresences.idealResource = changedResource;
+            userPresences.idealPresence = *changedItr;
+            return true;
+        }
+
+        return false;
+    } else if (changedItr == presences.cend() && changedResource != userPresences.idealResource) {
+        // A removed resource that is not the ideal one does not affect the ideal presence.
+        return false;
+    }
+
+    // The presence of the ideal resource changed or it was removed.
+    // Thus, all resources need to be compared.
+    auto result = presences.cbegin();
+    for (auto itr = std::next(result); itr != presences.cend(); itr++) {
+        if (resourceMoreImportant(itr.key(), *itr, result.key(), *result))
+            result = itr;
+    }
+
+    userPresences.idealResource = result.key();
+    userPresences.idealPresence = *result;
+    return true;
+}
+
 constexpr qint8 PresenceCache::availabilityPriority(QXmppPresence::AvailableStatusType type)
 {
     switch (type) {
@@ -209,6 +251,17 @@ bool PresenceCache::presenceMoreImportant(const QXmppPresence &a, const QXmppPre
     return !a.statusText().isEmpty() > !b.statusText().isEmpty();
 }
 
+bool PresenceCache::resourceMoreImportant(const QString &resourceA, const QXmppPresence &a, const QString &resourceB, const QXmppPresence &b)
+{
+    if (presenceMoreImportant(a, b))
+        return true;
+    if (presenceMoreImportant(b, a))
+        return false;
+
+    // Equally important resources are ordered by their names to get a stable result.
+    return resourceA < resourceB;
+}
+
 UserResourcesWatcher::UserResourcesWatcher(QObject *parent)
     : QObject(parent)
 {
@@ -223,8 +276,11 @@ void UserResourcesWatcher::setPresenceCache(PresenceCache *presenceCache)
 
         m_presenceCache = presenceCache;
 
-        connect(m_presenceCache, &PresenceCache::presenceChanged, this, [this](PresenceCache::ChangeType, const QString &, const QString &) {
-            Q_EMIT resourcesCountChanged();
+        connect(m_presenceCache, &PresenceCache::presenceChanged, this, [this](PresenceCache::ChangeType type, const QString &jid) {
+            // Updated presences do not change the count of resources.
+            if (type != PresenceCache::Updated && jid == m_jid) {
+                Q_EMIT resourcesCountChanged();
+            }
         });
 
         connect(m_presenceCache, &PresenceCache::presencesCleared, this, &UserResourcesWatcher::resourcesCountChanged);
@@ -10,6 +10,7 @@
 #include <optional>
 // Qt
 #include <QColor>
+#include <QHash>
 #include <QObject>
 // QXmpp
 #include <QXmppPresence.h>
@@ -86,15 +87,32 @@ public:
 
     /**
      * Notifies about changed presences
+     *
+     * @param idealPresenceChanged whether the presence of the ideal resource (i.e., the one
+     *        returned by presence(jid)) changed
      */
-    Q_SIGNAL void presenceChanged(PresenceCache::ChangeType type, const QString &jid, const QString &resource);
+    Q_SIGNAL void presenceChanged(PresenceCache::ChangeType type, const QString &jid, const QString &resource, bool idealPresenceChanged);
     Q_SIGNAL void presencesCleared();
 
 private:
+    struct UserPresences {
+        QHash<QString, QXmppPresence> presences;
+        QString idealResource;
+        QXmppPresence idealPresence;
+    };
+
+    /**
+     * Updates the ideal resource of a JID after a presence of the passed resource changed.
+     *
+     * @return whether the presence of the ideal resource changed
+     */
+    bool updateIdealResource(UserPresences &userPresences, const QString &changedResource);
+
     constexpr qint8 availabilityPriority(QXmppPresence::AvailableStatusType type);
     bool presenceMoreImportant(const QXmppPresence &a, const QXmppPresence &b);
+    bool resourceMoreImportant(const QString &resourceA, const QXmppPresence &a, const QString &resourceB, const QXmppPresence &b);
 
-    QMap<QString, QMap<QString, QXmppPresence>> m_presences;
+    QHash<QString, UserPresences> m_presences;
 };
 
 class UserResourcesWatcher : public QObject
@@ -0,0 +1,271 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+// std
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <optional>
+#include <tuple>
+#include <utility>
+// Qt
+#include <QFuture>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+
+/**
+ * Schedules tasks so that each task runs only once at a time and only a limited number of tasks
+ * runs in parallel.
+ *
+ * Queued tasks are started in the following order:
+ * 1. Tasks with higher priorities
+ * 2. Tasks of the preferred group (e.g., the open chat)
+ * 3. Tasks enqueued earlier
+ *
+ * Tasks enqueued until the event loop is entered again are ranked together before the next ones
+ * are started.
+ *
+ * @tparam Key type identifying a task
+ * @tparam Priority enumeration whose values are declared in ascending order of priority
+ */
+template<typename Key, typename Priority>
+class PriorityScheduler
+{
+public:
+    // Starts a task and returns a future that finishes once the task is finished.
+    using Start = std::function<QFuture<void>()>;
+
+    // Handles a finished task after it is not running anymore.
+    using HandleFinished = std::function<void(const Key &key)>;
+
+    explicit PriorityScheduler(int maxRunningTaskCount)
+        : m_maxRunningTaskCount(maxRunningTaskCount)
+    {
+    }
+
+    void setFinishedHandler(HandleFinished &&handleFinished)
+    {
+        m_handleFinished = std::move(handleFinished);
+    }
+
+    /**
+     * Enqueues a task.
+     *
+     * If the task is already queued, its priority is raised if the passed one is higher.
+     * If the task is already running, nothing is done.
+     */
+    void enqueue(const Key &key, Priority priority, Start &&start, const QString &group = {})
+    {
+        if (m_runningTasks.contains(key)) {
+            return;
+        }
+
+        if (auto itr = m_queuedTasks.find(key); itr != m_queuedTasks.end()) {
+            itr->start = std::move(start);
+            updatePriority(key, *itr, std::max(itr->priority, priority));
+        } else {
+            QueuedTask task{group, priority, m_nextSequenceNumber++, std::move(start)};
+            m_queue.emplace(rank(task), key);
+            m_queuedTasks.insert(key, std::move(task));
+        }
+
+        scheduleStartingNextTasks();
+    }
+
+    /**
+     * Changes the priority of a queued task.
+     */
+    void setPriority(const Key &key, Priority priority)
+    {
+        if (auto itr = m_queuedTasks.find(key); itr != m_queuedTasks.end()) {
+            updatePriority(key, *itr, priority);
+        }
+    }
+
+    /**
+     * Returns the priority of a queued task or std::nullopt if it is not queued.
+     */
+    std::optional<Priority> priority(const Key &key) const
+    {
+        if (const auto itr = m_queuedTasks.constFind(key); itr != m_queuedTasks.cend()) {
+            return itr->priority;
+        }
+
+        return std::nullopt;
+    }
+
+    /**
+     * Removes a queued task.
+     *
+     * Running tasks are not affected.
+     *
+     * @return whether a queued task was removed
+     */
+    bool cancel(const Key &key)
+    {
+        if (const auto itr = m_queuedTasks.constFind(key); itr != m_queuedTasks.cend()) {
+            m_queue.erase(rank(*itr));
+            m_queuedTasks.erase(itr);
+            return true;
+        }
+
+        return false;
+    }
+
+    /**
+     * Removes all queued tasks.
+     *
+     * Running tasks are not affected.
+     */
+    void clear()
+    {
+        m_queuedTasks.clear();
+        m_queue.clear();
+    }
+
+    bool isQueued(const Key &key) const
+    {
+        return m_queuedTasks.contains(key);
+    }
+
+    bool isRunning(const Key &key) const
+    {
+        return m_runningTasks.contains(key);
+    }
+
+    int queuedTaskCount() const
+    {
+        return m_queuedTasks.size();
+    }
+
+    int runningTaskCount() const
+    {
+        return m_runningTasks.size();
+    }
+
+    /**
+     * Sets the group whose tasks are started before the ones of other groups with the same
+     * priority.
+     */
+    void setPreferredGroup(const QString &group)
+    {
+        if (m_preferredGroup == group) {
+            return;
+        }
+
+        const auto previousGroup = std::exchange(m_preferredGroup, group);
+
+        // Only the tasks of the previous and the new preferred group change their ranks.
+        for (auto itr = m_queuedTasks.cbegin(); itr != m_queuedTasks.cend(); ++itr) {
+            if (const auto &taskGroup = itr->group; !taskGroup.isEmpty() && (taskGroup == previousGroup || taskGroup == group)) {
+                auto node = m_queue.extract(rank(*itr, previousGroup));
+                node.key() = rank(*itr);
+                m_queue.insert(std::move(node));
+            }
+        }
+    }
+
+private:
+    struct QueuedTask {
+        QString group;
+        Priority priority;
+        // Number increasing with each enqueued task so that earlier tasks are started first
+        quint64 sequenceNumber;
+        Start start;
+    };
+
+    // Rank of a queued task, ordered so that the task to be started next comes first
+    struct Rank {
+        Priority priority;
+        bool inPreferredGroup;
+        quint64 sequenceNumber;
+
+        bool operator<(const Rank &other) const
+        {
+            return std::tie(other.priority, other.inPreferredGroup, sequenceNumber)
+                < std::tie(priority, inPreferredGroup, other.sequenceNumber);
+        }
+    };
+
+    Rank rank(const QueuedTask &task) const
+    {
+        return rank(task, m_preferredGroup);
+    }
+
+    static Rank rank(const QueuedTask &task, const QString &preferredGroup)
+    {
+        return {task.priority, !preferredGroup.isEmpty() && task.group == preferredGroup, task.sequenceNumber};
+    }
+
+    void updatePriority(const Key &key, QueuedTask &task, Priority priority)
+    {
+        if (task.priority != priority) {
+            m_queue.erase(rank(task));
+            task.priority = priority;
+            m_queue.emplace(rank(task), key);
+        }
+    }
+
+    void scheduleStartingNextTasks()
+    {
+        if (!m_startingScheduled) {
+            m_startingScheduled = true;
+            QMetaObject::invokeMethod(
+                &m_context,
+                [this]() {
+                    startNextTasks();
+                },
+                Qt::QueuedConnection);
+        }
+    }
+
+    void startNextTasks()
+    {
+        m_startingScheduled = false;
+
+        while (m_runningTasks.size() < m_maxRunningTaskCount && !m_queue.empty()) {
+            // The task with the highest rank is started.
+            const auto key = m_queue.begin()->second;
+            m_queue.erase(m_queue.begin());
+
+            auto start = m_queuedTasks.take(key).start;
+            m_runningTasks.insert(key);
+
+            const auto handleTaskFinished = [this, key]() {
+                m_runningTasks.remove(key);
+
+                if (m_handleFinished) {
+                    m_handleFinished(key);
+                }
+
+                scheduleStartingNextTasks();
+            };
+
+            // The continuation taking the future is run if the task succeeded or failed.
+            // A canceled task is handled separately because continuations are not run for it.
+            start()
+                .then(&m_context,
+                      [handleTaskFinished](QFuture<void>) {
+                          handleTaskFinished();
+                      })
+                .onCanceled(&m_context, handleTaskFinished);
+        }
+    }
+
+    // Receiver of deferred calls that are discarded once the scheduler is destroyed
+    QObject m_context;
+
+    const int m_maxRunningTaskCount;
+    HandleFinished m_handleFinished;
+    QString m_preferredGroup;
+    QHash<Key, QueuedTask> m_queuedTasks;
+    // Keys of the queued tasks ordered by their ranks
+    std::map<Rank, Key> m_queue;
+    quint64 m_nextSequenceNumber = 0;
+    QSet<Key> m_runningTasks;
+    bool m_startingScheduled = false;
+};
@@ -0,0 +1,165 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ProviderCatalog.h"
+
+// Qt
+#include <QDateTime>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+// Kaidan
+#include "Algorithms.h"
+#include "Globals.h"
+#include "KaidanCoreLog.h"
+
+const ProviderCatalog &ProviderCatalog::instance()
+{
+    static const ProviderCatalog catalog(PROVIDER_LIST_FILE_PATH);
+    return catalog;
+}
+
+ProviderCatalog::ProviderCatalog(const QString &filePath)
+{
+    m_providers.append(Provider{});
+    readItemsFromJsonFile(filePath);
+
+    initializeIndexes();
+    initializeAvailabilities();
+    initializeAvailableFlags();
+    initializeMaximumBusFactor();
+    initializeAvailableOrganizations();
+}
+
+const QList<Provider> &ProviderCatalog::providers() const
+{
+    return m_providers;
+}
+
+const Provider &ProviderCatalog::provider(int index) const
+{
+    return m_providers.at(index);
+}
+
+int ProviderCatalog::indexOf(const QString &jid) const
+{
+    return m_indexesByJid.value(jid, -1);
+}
+
+int ProviderCatalog::availability(int index) const
+{
+    return m_availabilities.at(index);
+}
+
+const QList<QString> &ProviderCatalog::availableFlags() const
+{
+    return m_availableFlags;
+}
+
+int ProviderCatalog::maximumBusFactor() const
+{
+    return m_maximumBusFactor;
+}
+
+const QList<QString> &ProviderCatalog::availableOrganizations() const
+{
+    return m_availableOrganizations;
+}
+
+void ProviderCatalog::readItemsFromJsonFile(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.exists()) {
+        qCWarning(KAIDAN_CORE_LOG) << "Could not parse provider list:" << filePath << "- file does not exist!";
+        return;
+    }
+
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCWarning(KAIDAN_CORE_LOG) << "Could not open file for reading:" << filePath;
+        return;
+    }
+
+    QByteArray content = file.readAll();
+
+    QJsonParseError parseError;
+    QJsonArray jsonProviderArray = QJsonDocument::fromJson(content, &parseError).array();
+    if (jsonProviderArray.isEmpty()) {
+        qCWarning(KAIDAN_CORE_LOG) << "Could not parse provider list JSON file or no providers defined.";
+        qCWarning(KAIDAN_CORE_LOG) << "QJsonParseError:" << parseError.errorString() << "at" << parseError.offset;
+        return;
+    }
+
+    m_providers.reserve(jsonProviderArray.size() + 1);
+
+    for (auto jsonProvider : jsonProviderArray) {
+        if (!jsonProvider.isNull() && jsonProvider.isObject()) {
+            m_providers.append(Provider(jsonProvider.toObject()));
+        }
+    }
+}
+
+void ProviderCatalog::initializeIndexes()
+{
+    m_indexesByJid.reserve(m_providers.size());
+
+    // The search starts at index 1 to exclude the custom provider.
+    for (int i = 1; i < m_providers.size(); ++i) {
+        m_indexesByJid.insert(m_providers.at(i).jid(), i);
+    }
+}
+
+void ProviderCatalog::initializeAvailabilities()
+{
+    const auto today = QDateTime::currentDateTimeUtc().date();
+
+    m_availabilities = transform(m_providers, [today](const Provider &provider) {
+        const auto since = provider.since();
+
+        if (const auto years = today.year() - since.year()) {
+            if (since.month() < today.month() || since.day() < today.day()) {
+                return years;
+            }
+
+            return years - 1;
+        }
+
+        return 0;
+    });
+}
+
+void ProviderCatalog::initializeAvailableFlags()
+{
+    std::ranges::for_each(transform(m_providers,
+                                    [](const Provider &provider) {
+                                        return provider.flags();
+                                    }),
+                          [this](const QList<QString> &flags) {
+                              m_availableFlags.append(flags);
+                          });
+
+    makeUnique(m_availableFlags);
+    m_availableFlags.prepend(NO_SELECTION_TEXT);
+}
+
+void ProviderCatalog::initializeMaximumBusFactor()
+{
+    m_maximumBusFactor = std::ranges::max(transform(m_providers, [](const Provider &provider) {
+        return provider.busFactor();
+    }));
+}
+
+void ProviderCatalog::initializeAvailableOrganizations()
+{
+    m_availableOrganizations = transformFilter(m_providers, [](const Provider &provider) -> std::optional<QString> {
+        if (const auto organization = provider.organization(); !organization.isEmpty()) {
+            return organization;
+        }
+
+        return {};
+    });
+
+    makeUnique(m_availableOrganizations);
+    m_availableOrganizations.prepend(NO_SELECTION_TEXT);
+}
@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+// Qt
+#include <QHash>
+#include <QList>
+// Kaidan
+#include "Provider.h"
+
+/**
+ * Immutable list of the providers that can be chosen for account creation.
+ *
+ * The provider list file is parsed once when the shared catalog is used for the first time.
+ * Afterwards, the catalog is used by all provider models.
+ *
+ * The first provider is always the custom provider.
+ */
+class ProviderCatalog
+{
+public:
+    static const ProviderCatalog &instance();
+
+    explicit ProviderCatalog(const QString &filePath);
+
+    const QList<Provider> &providers() const;
+    const Provider &provider(int index) const;
+
+    /**
+     * Returns the index of the provider with the given JID or -1 if there is no such provider.
+     */
+    int indexOf(const QString &jid) const;
+
+    /**
+     * Returns the number of full years the provider has existed when the catalog was loaded.
+     */
+    int availability(int index) const;
+
+    const QList<QString> &availableFlags() const;
+    int maximumBusFactor() const;
+    const QList<QString> &availableOrganizations() const;
+
+private:
+    void readItemsFromJsonFile(const QString &filePath);
+
+    void initializeIndexes();
+    void initializeAvailabilities();
+    void initializeAvailableFlags();
+    void initializeMaximumBusFactor();
+    void initializeAvailableOrganizations();
+
+    QList<Provider> m_providers;
+    QHash<QString, int> m_indexesByJid;
+    QList<int> m_availabilities;
+    QList<QString> m_availableFlags;
+    int m_maximumBusFactor = -1;
+    QList<QString> m_availableOrganizations;
+};
@@ -4,9 +4,8 @@
 
 #include "ProviderFilterModel.h"
 
-// Qt
-#include <QDateTime>
 // Kaidan
+#include "Provider.h"
 #include "ProviderModel.h"
 
 const QList<int> AVAILABILITIES = {1, 3, 5, 10, 15};
@@ -25,45 +24,31 @@ ProviderFilterModel::ProviderFilterModel(QObject *parent)
     setMinimumMessageStorageDuration(MESSAGE_STORAGE_DURATIONS.first());
 }
 
-bool ProviderFilterModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
+bool ProviderFilterModel::filterAcceptsRow(int sourceRow, const QModelIndex &) const
 {
+    // The providers are accessed directly instead of via their roles to avoid converting all
+    // filtered values into QVariants.
     const auto model = static_cast<ProviderModel *>(sourceModel());
-    QModelIndex index = model->index(sourceRow, 0, sourceParent);
+    const auto &provider = model->provider(sourceRow);
 
-    if (model->data(index, ProviderModel::Role::IsCustomProvider).toBool()) {
+    if (provider.isCustomProvider()) {
         return true;
     }
 
-    const auto since = model->data(index, ProviderModel::Role::Since).toDate();
-    const auto today = QDateTime::currentDateTimeUtc().date();
-    int existence = 0;
-
-    if (const auto years = today.year() - since.year()) {
-        if (since.month() < today.month()) {
-            existence = years;
-        } else if (since.day() < today.day()) {
-            existence = years;
-        } else {
-            existence = years - 1;
-        }
-    }
+    const auto httpUploadFileSize = provider.httpUploadFileSize();
+    const auto httpUploadTotalSize = provider.httpUploadTotalSize();
+    const auto httpUploadStorageDuration = provider.httpUploadStorageDuration();
+    const auto messageStorageDuration = provider.messageStorageDuration();
 
-    const auto httpUploadFileSize = model->data(index, ProviderModel::Role::HttpUploadFileSize).toInt();
-    const auto httpUploadTotalSize = model->data(index, ProviderModel::Role::HttpUploadTotalSize).toInt();
-    const auto httpUploadStorageDuration = model->data(index, ProviderModel::Role::HttpUploadStorageDuration).toInt();
-    const auto messageStorageDuration = model->data(index, ProviderModel::Role::MessageStorageDuration).toInt();
-
-    return (!m_supportsInBandRegistrationOnly || model->data(index, ProviderModel::Role::SupportsInBandRegistration).toBool())
-        && (m_flag == NO_SELECTION_TEXT || model->data(index, ProviderModel::Role::Flags).toList().contains(m_flag))
-        && model->data(index, ProviderModel::Role::BusFactor).toInt() >= m_mininumBusFactor
-        && (m_organization == NO_SELECTION_TEXT || model->data(index, ProviderModel::Role::Organization).toString() == m_organization)
-        && (!m_supportsPasswordResetOnly || model->data(index, ProviderModel::Role::SupportsPasswordReset).toBool())
-        && (!m_hostedGreenOnly || model->data(index, ProviderModel::Role::HostedGreen).toBool()) && (existence >= m_minimumAvailability)
-        && (httpUploadFileSize == 0 || httpUploadFileSize >= m_minimumHttpUploadFileSize)
+    return (!m_supportsInBandRegistrationOnly || provider.supportsInBandRegistration())
+        && (m_flag == NO_SELECTION_TEXT || provider.flags().contains(m_flag)) && provider.busFactor() >= m_mininumBusFactor
+        && (m_organization == NO_SELECTION_TEXT || provider.organization() == m_organization)
+        && (!m_supportsPasswordResetOnly || provider.supportsPasswordReset()) && (!m_hostedGreenOnly || provider.hostedGreen())
+        && model->availability(sourceRow) >= m_minimumAvailability && (httpUploadFileSize == 0 || httpUploadFileSize >= m_minimumHttpUploadFileSize)
         && (httpUploadTotalSize == 0 || httpUploadTotalSize >= m_minimumHttpUploadTotalSize)
         && (httpUploadStorageDuration == 0 || httpUploadStorageDuration >= m_minimumHttpUploadStorageDuration)
         && (messageStorageDuration == 0 || messageStorageDuration >= m_minimumMessageStorageDuration)
-        && (!m_freeOfChargeOnly || model->data(index, ProviderModel::Role::FreeOfCharge).toBool());
+        && (!m_freeOfChargeOnly || provider.freeOfCharge());
 }
 
 void ProviderFilterModel::setSupportsInBandRegistrationOnly(bool supportsInBandRegistrationOnly)
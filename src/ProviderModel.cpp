@@ -7,28 +7,19 @@
 #include "ProviderModel.h"
 
 // Qt
-#include <QFile>
-#include <QJsonArray>
-#include <QJsonDocument>
-#include <QJsonObject>
 #include <QRandomGenerator>
 // QXmpp
 #include <QXmppUtils.h>
 // Kaidan
-#include "Algorithms.h"
 #include "Globals.h"
-#include "KaidanCoreLog.h"
 #include "Provider.h"
+#include "ProviderCatalog.h"
 #include "QmlUtils.h"
 
 ProviderModel::ProviderModel(QObject *parent)
     : QAbstractListModel(parent)
+    , m_catalog(ProviderCatalog::instance())
 {
-    m_providers.append(Provider{});
-    readItemsFromJsonFile(PROVIDER_LIST_FILE_PATH);
-    initializeAvailableFlags();
-    initializeMaximumBusFactor();
-    initializeAvailableOrganizations();
 }
 
 QHash<int, QByteArray> ProviderModel::roleNames() const
@@ -59,14 +50,14 @@ QHash<int, QByteArray> ProviderModel::roleNames() const
 
 int ProviderModel::rowCount(const QModelIndex &parent) const
 {
-    return parent == QModelIndex() ? m_providers.size() : 0;
+    return parent == QModelIndex() ? m_catalog.providers().size() : 0;
 }
 
 QVariant ProviderModel::data(const QModelIndex &index, int role) const
 {
     Q_ASSERT(checkIndex(index, QAbstractItemModel::CheckIndexOption::IndexIsValid | QAbstractItemModel::CheckIndexOption::ParentIsInvalid));
 
-    const Provider &item = m_providers.at(index.row());
+    const Provider &item = m_catalog.provider(index.row());
 
     switch (static_cast<Role>(role)) {
     case Role::Display:
@@ -149,9 +140,20 @@ QVariant ProviderModel::data(int row, ProviderModel::Role role) const
     return data(index(row), static_cast<int>(role));
 }
 
+const Provider &ProviderModel::provider(int row) const
+{
+    return m_catalog.provider(row);
+}
+
+int ProviderModel::availability(int row) const
+{
+    return m_catalog.availability(row);
+}
+
 Provider ProviderModel::providerFromBareJid(const QString &jid) const
 {
-    return provider(QXmppUtils::jidToDomain(jid));
+    const auto index = m_catalog.indexOf(QXmppUtils::jidToDomain(jid));
+    return index == -1 ? Provider{} : m_catalog.provider(index);
 }
 
 int ProviderModel::randomlyChooseIndex(const QList<int> &excludedIndexes, bool providersMatchingSystemLocaleOnly) const
@@ -176,69 +178,19 @@ int ProviderModel::providersMatchingSystemLocaleMinimumCount()
     return PROVIDER_LIST_MIN_PROVIDERS_FROM_COUNTRY;
 }
 
-void ProviderModel::readItemsFromJsonFile(const QString &filePath)
+int ProviderModel::maximumBusFactor() const
 {
-    QFile file(filePath);
-    if (!file.exists()) {
-        qCWarning(KAIDAN_CORE_LOG) << "Could not parse provider list:" << filePath << "- file does not exist!";
-        return;
-    }
-
-    if (!file.open(QIODevice::ReadOnly)) {
-        qCWarning(KAIDAN_CORE_LOG) << "Could not open file for reading:" << filePath;
-        return;
-    }
-
-    QByteArray content = file.readAll();
-
-    QJsonParseError parseError;
-    QJsonArray jsonProviderArray = QJsonDocument::fromJson(content, &parseError).array();
-    if (jsonProviderArray.isEmpty()) {
-        qCWarning(KAIDAN_CORE_LOG) << "Could not parse provider list JSON file or no providers defined.";
-        qCWarning(KAIDAN_CORE_LOG) << "QJsonParseError:" << parseError.errorString() << "at" << parseError.offset;
-        return;
-    }
-
-    for (auto jsonProvider : jsonProviderArray) {
-        if (!jsonProvider.isNull() && jsonProvider.isObject()) {
-            m_providers.append(Provider(jsonProvider.toObject()));
-        }
-    }
+    return m_catalog.maximumBusFactor();
 }
 
-void ProviderModel::initializeAvailableFlags()
+QList<QString> ProviderModel::availableFlags() const
 {
-    std::ranges::for_each(transform(m_providers,
-                                    [](const Provider &provider) {
-                                        return provider.flags();
-                                    }),
-                          [this](const QList<QString> &flags) {
-                              m_availableFlags.append(flags);
-                          });
-
-    makeUnique(m_availableFlags);
-    m_availableFlags.prepend(NO_SELECTION_TEXT);
+    return m_catalog.availableFlags();
 }
 
-void ProviderModel::initializeMaximumBusFactor()
+QList<QString> ProviderModel::availableOrganizations() const
 {
-    m_maximumBusFactor = std::ranges::max(transform(m_providers, [](const Provider &provider) {
-        return provider.busFactor();
-    }));
-}
-
-void ProviderModel::initializeAvailableOrganizations()
-{
-    m_availableOrganizations = transformFilter(m_providers, [](const Provider &provider) -> std::optional<QString> {
-        if (const auto organization = provider.organization(); !organization.isEmpty()) {
-            return organization;
-        }
-
-        return {};
-    });
-
-    makeUnique(m_availableOrganizations);
-    m_availableOrganizations.prepend(NO_SELECTION_TEXT);
+    return m_catalog.availableOrganizations();
 }
 
 QList<Provider> ProviderModel::providersSupportingInBandRegistration() const
@@ -246,7 +198,7 @@ QList<Provider> ProviderModel::providersSupportingInBandRegistration() const
     QList<Provider> providers;
 
     // The search starts at index 1 to exclude the custom provider.
-    std::copy_if(m_providers.begin() + 1, m_providers.end(), std::back_inserter(providers), [](const Provider &item) {
+    std::copy_if(m_catalog.providers().begin() + 1, m_catalog.providers().end(), std::back_inserter(providers), [](const Provider &item) {
         return item.supportsInBandRegistration();
     });
 
@@ -267,21 +219,12 @@ QList<Provider> ProviderModel::providersWithSystemLocale(const QList<Provider> &
     return providers;
 }
 
-Provider ProviderModel::provider(const QString &jid) const
-{
-    auto item = std::ranges::find_if(m_providers, [&jid](const auto &it) {
-        return it.jid() == jid;
-    });
-
-    return item == m_providers.end() ? Provider{} : *item;
-}
-
 int ProviderModel::indexOfRandomlySelectedProvider(const QList<Provider> &preSelectedProviders, const QList<int> &excludedIndexes) const
 {
     int index;
 
     do {
-        index = m_providers.indexOf(preSelectedProviders.at(QRandomGenerator::global()->generate() % preSelectedProviders.size()));
+        index = m_catalog.indexOf(preSelectedProviders.at(QRandomGenerator::global()->generate() % preSelectedProviders.size()).jid());
     } while (!excludedIndexes.isEmpty() && excludedIndexes.contains(index));
 
     return index;
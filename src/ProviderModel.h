@@ -10,14 +10,15 @@
 #include <QAbstractListModel>
 
 class Provider;
+class ProviderCatalog;
 
 class ProviderModel : public QAbstractListModel
 {
     Q_OBJECT
     Q_PROPERTY(int providersMatchingSystemLocaleMinimumCount READ providersMatchingSystemLocaleMinimumCount CONSTANT)
-    Q_PROPERTY(int maximumBusFactor MEMBER m_maximumBusFactor CONSTANT)
-    Q_PROPERTY(QList<QString> availableFlags MEMBER m_availableFlags CONSTANT)
-    Q_PROPERTY(QList<QString> availableOrganizations MEMBER m_availableOrganizations CONSTANT)
+    Q_PROPERTY(int maximumBusFactor READ maximumBusFactor CONSTANT)
+    Q_PROPERTY(QList<QString> availableFlags READ availableFlags CONSTANT)
+    Q_PROPERTY(QList<QString> availableOrganizations READ availableOrganizations CONSTANT)
 
 public:
     enum class Role {
@@ -58,26 +59,24 @@ public:
     // Overloaded method for QML.
     Q_INVOKABLE QVariant data(int row, ProviderModel::Role role) const;
 
+    // Direct access for ProviderFilterModel.
+    const Provider &provider(int row) const;
+    int availability(int row) const;
+
     Q_INVOKABLE Provider providerFromBareJid(const QString &jid) const;
 
     Q_INVOKABLE int randomlyChooseIndex(const QList<int> &excludedIndexes = {}, bool providersMatchingSystemLocaleOnly = true) const;
     static int providersMatchingSystemLocaleMinimumCount();
 
-private:
-    void readItemsFromJsonFile(const QString &filePath);
-
-    void initializeAvailableFlags();
-    void initializeMaximumBusFactor();
-    void initializeAvailableOrganizations();
+    int maximumBusFactor() const;
+    QList<QString> availableFlags() const;
+    QList<QString> availableOrganizations() const;
 
+private:
     QList<Provider> providersSupportingInBandRegistration() const;
     QList<Provider> providersWithSystemLocale(const QList<Provider> &preSelectedProviders) const;
 
-    Provider provider(const QString &jid) const;
     int indexOfRandomlySelectedProvider(const QList<Provider> &preSelectedProviders, const QList<int> &excludedIndexes) const;
 
-    QList<Provider> m_providers;
-    QList<QString> m_availableFlags;
-    int m_maximumBusFactor;
-    QList<QString> m_availableOrganizations;
+    const ProviderCatalog &m_catalog;
 };
@@ -4,6 +4,11 @@
 
 #include "PublicGroupChatModel.h"
 
+// Qt
+#include <QSet>
+// Kaidan
+#include "Algorithms.h"
+
 PublicGroupChatModel::PublicGroupChatModel(QObject *parent)
     : QAbstractListModel(parent)
 {
@@ -65,31 +70,36 @@ const PublicGroupChats &PublicGroupChatModel::groupChats() const
 
 void PublicGroupChatModel::setGroupChats(const PublicGroupChats &groupChats)
 {
-    if (m_groupChats != groupChats) {
+    if (m_groupChats == groupChats) {
+        return;
+    }
+
+    if (m_groupChats.isEmpty()) {
         beginResetModel();
         m_groupChats = groupChats;
-        m_languages.clear();
-        m_users = {0, 0};
-
-        for (const PublicGroupChat &groupChat : groupChats) {
-            const QStringList &groupChatLanguages = groupChat.languages();
-
-            for (const QString &language : groupChatLanguages) {
-                if (!language.isEmpty() && !m_languages.contains(language)) {
-                    m_languages.append(language);
-                }
-            }
+        m_searchEntries = transform(m_groupChats, [this](const PublicGroupChat &groupChat) {
+            return searchEntry(groupChat);
+        });
+        updateRowsByAddress();
+        updateStatistics();
+        endResetModel();
 
-            m_users.min = qMin(m_users.min, groupChat.users());
-            m_users.max = qMax(m_users.max, groupChat.users());
-        }
+        Q_EMIT groupChatsChanged(m_groupChats);
+        return;
+    }
 
-        m_languages.sort(Qt::CaseInsensitive);
-        // Empty entry for *all*
-        m_languages.prepend(QString());
+    const auto groupChatsRemoved = removeMissingGroupChats(groupChats);
 
-        endResetModel();
+    if (mergeGroupChats(groupChats) || groupChatsRemoved) {
+        updateStatistics();
+        Q_EMIT groupChatsChanged(m_groupChats);
+    }
+}
 
+void PublicGroupChatModel::addGroupChats(const PublicGroupChats &groupChats)
+{
+    if (mergeGroupChats(groupChats)) {
+        updateStatistics();
         Q_EMIT groupChatsChanged(m_groupChats);
     }
 }
@@ -114,4 +124,161 @@ int PublicGroupChatModel::maxUsers() const
     return m_users.max;
 }
 
+const QString &PublicGroupChatModel::searchKey(int row) const
+{
+    return m_searchEntries.at(row).key;
+}
+
+const QList<int> &PublicGroupChatModel::languageIds(int row) const
+{
+    return m_searchEntries.at(row).languageIds;
+}
+
+int PublicGroupChatModel::languageId(const QString &language) const
+{
+    return m_languageIds.value(language, -1);
+}
+
+QString PublicGroupChatModel::normalizedSearchText(const QString &text)
+{
+    return text.normalized(QString::NormalizationForm_KC).toCaseFolded();
+}
+
+PublicGroupChatModel::SearchEntry PublicGroupChatModel::searchEntry(const PublicGroupChat &groupChat)
+{
+    // The fields are separated by line breaks, which are not part of a search text entered in a single-line field.
+    const auto key = normalizedSearchText(groupChat.name() + u'\n' + groupChat.description() + u'\n' + groupChat.address());
+
+    const auto languageIds = transform(groupChat.languages(), [this](const QString &language) {
+        if (const auto itr = m_languageIds.constFind(language); itr != m_languageIds.cend()) {
+            return *itr;
+        }
+
+        const auto id = int(m_languageIds.size());
+        m_languageIds.insert(language, id);
+
+        return id;
+    });
+
+    return {key, languageIds};
+}
+
+bool PublicGroupChatModel::mergeGroupChats(const PublicGroupChats &groupChats)
+{
+    const auto oldCount = m_groupChats.size();
+    PublicGroupChats addedGroupChats;
+    bool groupChatsUpdated = false;
+
+    for (const auto &groupChat : groupChats) {
+        const auto row = m_rowsByAddress.value(groupChat.address(), -1);
+
+        if (row == -1) {
+            m_rowsByAddress.insert(groupChat.address(), oldCount + addedGroupChats.size());
+            addedGroupChats.append(groupChat);
+        } else if (row >= oldCount) {
+            // The group chat is contained multiple times in the new group chats.
+            addedGroupChats[row - oldCount] = groupChat;
+        } else if (m_groupChats.at(row) != groupChat) {
+            m_groupChats[row] = groupChat;
+            m_searchEntries[row] = searchEntry(groupChat);
+            groupChatsUpdated = true;
+
+            const auto modelIndex = index(row);
+            Q_EMIT dataChanged(modelIndex, modelIndex);
+        }
+    }
+
+    if (addedGroupChats.isEmpty()) {
+        return groupChatsUpdated;
+    }
+
+    auto addedSearchEntries = transform(addedGroupChats, [this](const PublicGroupChat &groupChat) {
+        return searchEntry(groupChat);
+    });
+
+    beginInsertRows({}, oldCount, oldCount + addedGroupChats.size() - 1);
+    m_groupChats.append(addedGroupChats);
+    m_searchEntries.append(std::move(addedSearchEntries));
+    endInsertRows();
+
+    return true;
+}
+
+bool PublicGroupChatModel::removeMissingGroupChats(const PublicGroupChats &groupChats)
+{
+    QSet<QString> addresses;
+    addresses.reserve(groupChats.size());
+
+    for (const auto &groupChat : groupChats) {
+        addresses.insert(groupChat.address());
+    }
+
+    const auto isMissing = [&addresses](const PublicGroupChat &groupChat) {
+        return !addresses.contains(groupChat.address());
+    };
+
+    bool groupChatsRemoved = false;
+
+    // Remove consecutive missing group chats at once, starting at the end to keep the rows in front valid.
+    for (auto last = m_groupChats.size() - 1; last >= 0; --last) {
+        if (!isMissing(m_groupChats.at(last))) {
+            continue;
+        }
+
+        auto first = last;
+
+        while (first > 0 && isMissing(m_groupChats.at(first - 1))) {
+            --first;
+        }
+
+        beginRemoveRows({}, first, last);
+        m_groupChats.remove(first, last - first + 1);
+        m_searchEntries.remove(first, last - first + 1);
+        endRemoveRows();
+
+        groupChatsRemoved = true;
+        last = first;
+    }
+
+    if (groupChatsRemoved) {
+        updateRowsByAddress();
+    }
+
+    return groupChatsRemoved;
+}
+
+void PublicGroupChatModel::updateRowsByAddress()
+{
+    m_rowsByAddress.clear();
+    m_rowsByAddress.reserve(m_groupChats.size());
+
+    for (int i = 0; i < m_groupChats.size(); ++i) {
+        m_rowsByAddress.insert(m_groupChats.at(i).address(), i);
+    }
+}
+
+void PublicGroupChatModel::updateStatistics()
+{
+    QSet<QString> languages;
+    m_users = {0, 0};
+
+    for (const PublicGroupChat &groupChat : std::as_const(m_groupChats)) {
+        const QStringList &groupChatLanguages = groupChat.languages();
+
+        for (const QString &language : groupChatLanguages) {
+            if (!language.isEmpty()) {
+                languages.insert(language);
+            }
+        }
+
+        m_users.min = qMin(m_users.min, groupChat.users());
+        m_users.max = qMax(m_users.max, groupChat.users());
+    }
+
+    m_languages = QStringList(languages.cbegin(), languages.cend());
+    m_languages.sort(Qt::CaseInsensitive);
+    // Empty entry for *all*
+    m_languages.prepend(QString());
+}
+
 #include "moc_PublicGroupChatModel.cpp"
@@ -39,7 +39,23 @@ public:
     QHash<int, QByteArray> roleNames() const override;
 
     const PublicGroupChats &groupChats() const;
+
+    /**
+     * Sets the group chats.
+     *
+     * If there are already group chats, the new ones are merged into them by their addresses.
+     * That way, only the rows whose group chats have been updated, added or removed are changed
+     * instead of resetting the whole model.
+     */
     void setGroupChats(const PublicGroupChats &groupChats);
+
+    /**
+     * Adds group chats or updates the ones with the same addresses.
+     *
+     * That is used for merging a received page of group chats while the other ones are kept.
+     */
+    Q_INVOKABLE void addGroupChats(const PublicGroupChats &groupChats);
+
     Q_SIGNAL void groupChatsChanged(const PublicGroupChats &groupChats);
 
     int count() const;
@@ -47,8 +63,46 @@ public:
     int minUsers() const;
     int maxUsers() const;
 
+    /**
+     * Returns the normalized and case-folded text of the group chat's name, description and address.
+     *
+     * The search key is created once when the group chat is added or updated.
+     * It can be searched via normalizedSearchText() without converting the group chat's data for each search.
+     */
+    const QString &searchKey(int row) const;
+
+    /**
+     * Returns the IDs of the group chat's languages.
+     */
+    const QList<int> &languageIds(int row) const;
+
+    /**
+     * Returns the ID of a language or -1 if no group chat has that language.
+     */
+    int languageId(const QString &language) const;
+
+    /**
+     * Normalizes a text the same way as the search keys so that it can be searched within them.
+     */
+    static QString normalizedSearchText(const QString &text);
+
 private:
+    struct SearchEntry {
+        QString key;
+        QList<int> languageIds;
+    };
+
+    SearchEntry searchEntry(const PublicGroupChat &groupChat);
+
+    bool mergeGroupChats(const PublicGroupChats &groupChats);
+    bool removeMissingGroupChats(const PublicGroupChats &groupChats);
+    void updateRowsByAddress();
+    void updateStatistics();
+
     PublicGroupChats m_groupChats;
+    QList<SearchEntry> m_searchEntries;
+    QHash<QString, int> m_rowsByAddress;
+    QHash<QString, int> m_languageIds;
     QStringList m_languages;
     struct {
         int min;
@@ -21,7 +21,27 @@ PublicGroupChatProxyModel::PublicGroupChatProxyModel(QObject *parent)
 void PublicGroupChatProxyModel::setSourceModel(QAbstractItemModel *sourceModel)
 {
     Q_ASSERT(!sourceModel || qobject_cast<PublicGroupChatModel *>(sourceModel));
+
+    for (const auto &connection : std::as_const(m_sourceModelConnections)) {
+        disconnect(connection);
+    }
+
+    m_sourceModelConnections.clear();
+    invalidateSearchTextMatches();
+
     QSortFilterProxyModel::setSourceModel(sourceModel);
+
+    // The rows of previous search text matches cannot be used anymore once the source model's rows are changed.
+    if (sourceModel) {
+        m_sourceModelConnections = {
+            connect(sourceModel, &QAbstractItemModel::rowsInserted, this, &PublicGroupChatProxyModel::invalidateSearchTextMatches),
+            connect(sourceModel, &QAbstractItemModel::rowsRemoved, this, &PublicGroupChatProxyModel::invalidateSearchTextMatches),
+            connect(sourceModel, &QAbstractItemModel::rowsMoved, this, &PublicGroupChatProxyModel::invalidateSearchTextMatches),
+            connect(sourceModel, &QAbstractItemModel::dataChanged, this, &PublicGroupChatProxyModel::invalidateSearchTextMatches),
+            connect(sourceModel, &QAbstractItemModel::layoutChanged, this, &PublicGroupChatProxyModel::invalidateSearchTextMatches),
+            connect(sourceModel, &QAbstractItemModel::modelReset, this, &PublicGroupChatProxyModel::invalidateSearchTextMatches),
+        };
+    }
 }
 
 void PublicGroupChatProxyModel::sort(int column, Qt::SortOrder order)
@@ -29,6 +49,33 @@ void PublicGroupChatProxyModel::sort(int column, Qt::SortOrder order)
     QSortFilterProxyModel::sort(column, order);
 }
 
+const QString &PublicGroupChatProxyModel::searchText() const
+{
+    return m_searchText;
+}
+
+void PublicGroupChatProxyModel::setSearchText(const QString &searchText)
+{
+    if (m_searchText == searchText) {
+        return;
+    }
+
+    const auto normalizedSearchText = PublicGroupChatModel::normalizedSearchText(searchText);
+
+    // A group chat that does not contain the old search text cannot contain a longer search text containing the old one.
+    m_narrowingSearch = m_searchTextMatchesValid && normalizedSearchText.contains(m_normalizedSearchText);
+
+    beginFilterChange();
+    m_searchText = searchText;
+    m_normalizedSearchText = normalizedSearchText;
+    endFilterChange(QSortFilterProxyModel::Direction::Rows);
+
+    m_narrowingSearch = false;
+    m_searchTextMatchesValid = filterRole() == static_cast<int>(PublicGroupChatModel::CustomRole::GlobalSearch);
+
+    Q_EMIT searchTextChanged(m_searchText);
+}
+
 const QString &PublicGroupChatProxyModel::languageFilter() const
 {
     return m_languageFilter;
@@ -39,6 +86,7 @@ void PublicGroupChatProxyModel::setLanguageFilter(const QString &language)
     if (m_languageFilter != language) {
         beginFilterChange();
         m_languageFilter = language;
+        m_languageFilterId = -1;
         endFilterChange(QSortFilterProxyModel::Direction::Rows);
 
         Q_EMIT languageFilterChanged(m_languageFilter);
@@ -52,19 +100,53 @@ int PublicGroupChatProxyModel::count() const
 
 bool PublicGroupChatProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
 {
-    const QModelIndex sourceIndex = sourceModel()->index(sourceRow, 0, sourceParent);
-    const PublicGroupChat groupChat = sourceIndex.data(static_cast<int>(PublicGroupChatModel::CustomRole::GroupChat)).value<PublicGroupChat>();
+    const auto *model = static_cast<PublicGroupChatModel *>(sourceModel());
 
-    if (!(m_languageFilter.isEmpty() || groupChat.languages().contains(m_languageFilter))) {
-        return false;
+    if (filterRole() == static_cast<int>(PublicGroupChatModel::CustomRole::GlobalSearch)) {
+        if (!matchesSearchText(sourceRow)) {
+            return false;
+        }
+    }
+
+    if (!m_languageFilter.isEmpty()) {
+        // The ID is looked up again as long as no group chat with the language has been added.
+        if (m_languageFilterId == -1) {
+            m_languageFilterId = model->languageId(m_languageFilter);
+        }
+
+        if (!model->languageIds(sourceRow).contains(m_languageFilterId)) {
+            return false;
+        }
     }
 
     if (filterRole() == static_cast<int>(PublicGroupChatModel::CustomRole::GlobalSearch)) {
-        return groupChat.name().contains(filterRegularExpression()) || groupChat.description().contains(filterRegularExpression())
-            || groupChat.address().contains(filterRegularExpression());
+        return filterRegularExpression().pattern().isEmpty() || model->searchKey(sourceRow).contains(filterRegularExpression());
     }
 
     return QSortFilterProxyModel::filterAcceptsRow(sourceRow, sourceParent);
 }
 
+bool PublicGroupChatProxyModel::matchesSearchText(int sourceRow) const
+{
+    if (m_narrowingSearch && !m_searchTextMatches.value(sourceRow)) {
+        return false;
+    }
+
+    const auto matches = static_cast<PublicGroupChatModel *>(sourceModel())->searchKey(sourceRow).contains(m_normalizedSearchText);
+
+    if (sourceRow >= m_searchTextMatches.size()) {
+        m_searchTextMatches.resize(sourceModel()->rowCount());
+    }
+
+    m_searchTextMatches[sourceRow] = matches;
+
+    return matches;
+}
+
+void PublicGroupChatProxyModel::invalidateSearchTextMatches()
+{
+    m_searchTextMatches.clear();
+    m_searchTextMatchesValid = false;
+}
+
 #include "moc_PublicGroupChatProxyModel.cpp"
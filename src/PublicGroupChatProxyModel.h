@@ -11,6 +11,7 @@ class PublicGroupChatProxyModel : public QSortFilterProxyModel
 {
     Q_OBJECT
 
+    Q_PROPERTY(QString searchText READ searchText WRITE setSearchText NOTIFY searchTextChanged)
     Q_PROPERTY(QString languageFilter READ languageFilter WRITE setLanguageFilter NOTIFY languageFilterChanged)
     Q_PROPERTY(int count READ count NOTIFY countChanged)
 
@@ -20,6 +21,22 @@ public:
     void setSourceModel(QAbstractItemModel *sourceModel) override;
     Q_INVOKABLE void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
 
+    /**
+     * Returns the text searched for within the name, description and address of each group chat.
+     *
+     * The search text is used for filtering if the filter role is PublicGroupChatModel::CustomRole::GlobalSearch.
+     */
+    const QString &searchText() const;
+
+    /**
+     * Sets the search text.
+     *
+     * If the new search text contains the old one, only the group chats matching the old search text
+     * are searched again.
+     */
+    void setSearchText(const QString &searchText);
+    Q_SIGNAL void searchTextChanged(const QString &searchText);
+
     const QString &languageFilter() const;
     void setLanguageFilter(const QString &language);
     Q_SIGNAL void languageFilterChanged(const QString &language);
@@ -31,5 +48,19 @@ protected:
     bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
 
 private:
+    bool matchesSearchText(int sourceRow) const;
+    void invalidateSearchTextMatches();
+
+    QString m_searchText;
+    QString m_normalizedSearchText;
+    bool m_narrowingSearch = false;
+
+    // Whether each source row matched the normalized search text when it was filtered the last time
+    mutable QList<bool> m_searchTextMatches;
+    bool m_searchTextMatchesValid = false;
+
+    QList<QMetaObject::Connection> m_sourceModelConnections;
+
     QString m_languageFilter;
+    mutable int m_languageFilterId = -1;
 };
@@ -5,7 +5,9 @@
 #include "PublicGroupChatSearchController.h"
 
 // Qt
+#include <QDataStream>
 #include <QDir>
+#include <QFileInfo>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -13,17 +15,30 @@
 #include <QNetworkReply>
 #include <QSaveFile>
 #include <QStandardPaths>
+#include <QTimeZone>
 #include <QTimer>
 #include <QUrlQuery>
 // Kaidan
+#include "Algorithms.h"
 #include "KaidanCoreLog.h"
 
 #define NEXT_TIMEOUT 0
 
+// HTTP status code of a conditional request for a page that has not been modified
+constexpr int NOT_MODIFIED_STATUS_CODE = 304;
+
+// Header of the cache file: "KPGC" followed by the format version
+constexpr quint32 CACHE_FILE_MAGIC = 0x4B504743;
+constexpr quint32 CACHE_FILE_VERSION = 1;
+constexpr QDataStream::Version CACHE_FILE_STREAM_VERSION = QDataStream::Qt_6_0;
+// Position of the refresh time which directly follows the magic and the format version
+constexpr qint64 CACHE_FILE_REFRESH_TIME_POSITION = 2 * sizeof(quint32);
+
 PublicGroupChatSearchController::PublicGroupChatSearchController(QNetworkAccessManager *manager, QObject *parent)
     : QObject(parent)
     , m_throttler(new QTimer(this))
     , m_manager(manager)
+    , m_serviceUrl(QStringLiteral("https://search.jabber.network/api/1.0/rooms"))
 {
     Q_ASSERT(m_manager);
 
@@ -47,10 +62,21 @@ PublicGroupChatSearchController::~PublicGroupChatSearchController()
 void PublicGroupChatSearchController::requestAll()
 {
     cancel();
+    loadCache();
 
-    setIsRunning(true);
+    if (!isCacheOutdated()) {
+        qCDebug(KAIDAN_CORE_LOG, "Cached public group chats are up to date");
+        return;
+    }
 
-    requestFrom();
+    startRefresh();
+}
+
+void PublicGroupChatSearchController::refresh()
+{
+    cancel();
+    loadCache();
+    startRefresh();
 }
 
 void PublicGroupChatSearchController::cancel()
@@ -61,7 +87,7 @@ void PublicGroupChatSearchController::cancel()
         m_lastReply->abort();
     }
 
-    m_groupChats.clear();
+    clearRefresh();
 
     setIsRunning(false);
 }
@@ -84,13 +110,48 @@ PublicGroupChats PublicGroupChatSearchController::cachedGroupChats() const
     return m_groupChats;
 }
 
+void PublicGroupChatSearchController::setServiceUrl(const QUrl &serviceUrl)
+{
+    m_serviceUrl = serviceUrl;
+}
+
+void PublicGroupChatSearchController::setCacheLifetime(std::chrono::milliseconds cacheLifetime)
+{
+    m_cacheLifetime = cacheLifetime;
+}
+
+void PublicGroupChatSearchController::loadCache()
+{
+    if (m_cacheRead) {
+        return;
+    }
+
+    m_cacheRead = true;
+
+    // Remove the file used by previous versions for storing the group chats as JSON.
+    if (const auto filePath = saveFilePath(); !filePath.isEmpty()) {
+        QFile::remove(QFileInfo(filePath).dir().absoluteFilePath(QStringLiteral("public-group-chats.json")));
+    }
+
+    if (readGroupChats() && !m_groupChats.isEmpty()) {
+        Q_EMIT groupChatsReceived(m_groupChats);
+    }
+}
+
+void PublicGroupChatSearchController::startRefresh()
+{
+    setIsRunning(true);
+
+    requestFrom();
+}
+
 QNetworkRequest PublicGroupChatSearchController::newRequest(const QString &previousAddress) const
 {
     // GET /api/1.0/rooms
     // 400 - param error
     // 429 - throttled
 
-    QUrl url(QStringLiteral("https://search.jabber.network/api/1.0/rooms"));
+    QUrl url(m_serviceUrl);
     QUrlQuery query;
 
     if (!previousAddress.isEmpty()) {
@@ -104,6 +165,19 @@ QNetworkRequest PublicGroupChatSearchController::newRequest(const QString &previ
     QNetworkRequest request(url);
     request.setRawHeader(QByteArrayLiteral("Accept-Encoding"), QByteArrayLiteral("gzip, deflate"));
 
+    // Request the page only if it has been modified since it was cached.
+    if (const auto pageIndex = m_pageIndexesByPreviousAddress.value(previousAddress, -1); pageIndex != -1) {
+        const auto &page = m_pages.at(pageIndex);
+
+        if (!page.entityTag.isEmpty()) {
+            request.setRawHeader(QByteArrayLiteral("If-None-Match"), page.entityTag);
+        }
+
+        if (!page.lastModified.isEmpty()) {
+            request.setRawHeader(QByteArrayLiteral("If-Modified-Since"), page.lastModified);
+        }
+    }
+
     qCDebug(KAIDAN_CORE_LOG, "Requesting groupChats: %s", qUtf8Printable(url.toString()));
 
     return request;
@@ -111,12 +185,13 @@ QNetworkRequest PublicGroupChatSearchController::newRequest(const QString &previ
 
 void PublicGroupChatSearchController::requestFrom(const QString &previousAddress)
 {
+    m_requestedPreviousAddress = previousAddress;
     m_lastReply = m_manager->get(newRequest(previousAddress));
 }
 
 void PublicGroupChatSearchController::wakeUp()
 {
-    requestFrom(m_groupChats.isEmpty() ? QString() : m_groupChats.constLast().address());
+    requestFrom(m_refreshedGroupChats.isEmpty() ? QString() : m_refreshedGroupChats.constLast().address());
 }
 
 void PublicGroupChatSearchController::replyFinished(QNetworkReply *reply)
@@ -147,32 +222,103 @@ void PublicGroupChatSearchController::replyFinished(QNetworkReply *reply)
 
         qCWarning(KAIDAN_CORE_LOG, "Search request error: %s", qUtf8Printable(reply->errorString()));
 
-        if (readGroupChats()) {
-            Q_EMIT groupChatsReceived(m_groupChats);
-        } else {
+        // The cached group chats are kept in case of an error.
+        if (m_groupChats.isEmpty()) {
             Q_EMIT error(reply->errorString());
         }
 
+        clearRefresh();
+
         setIsRunning(false);
         return;
     }
 
-    const QByteArray data = reply->readAll();
-    const QJsonDocument doc = QJsonDocument::fromJson(data);
-    const PublicGroupChats newGroupChats = PublicGroupChat::fromJson(doc.object().value(QStringLiteral("items")).toArray());
+    Page page{
+        .previousAddress = m_requestedPreviousAddress,
+        .offset = int(m_refreshedGroupChats.size()),
+        .entityTag = reply->rawHeader(QByteArrayLiteral("ETag")),
+        .lastModified = reply->rawHeader(QByteArrayLiteral("Last-Modified")),
+    };
+
+    PublicGroupChats newGroupChats;
 
-    m_groupChats.append(newGroupChats);
+    if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() == NOT_MODIFIED_STATUS_CODE) {
+        // Only pages that are cached are requested conditionally.
+        const auto &cachedPage = m_pages.at(m_pageIndexesByPreviousAddress.value(m_requestedPreviousAddress));
+        newGroupChats = m_groupChats.mid(cachedPage.offset, cachedPage.count);
+
+        if (page.entityTag.isEmpty()) {
+            page.entityTag = cachedPage.entityTag;
+        }
+
+        if (page.lastModified.isEmpty()) {
+            page.lastModified = cachedPage.lastModified;
+        }
+    } else {
+        const QByteArray data = reply->readAll();
+        const QJsonDocument doc = QJsonDocument::fromJson(data);
+        newGroupChats = PublicGroupChat::fromJson(doc.object().value(QStringLiteral("items")).toArray());
+
+        if (!newGroupChats.isEmpty()) {
+            m_groupChatsModified = true;
+            Q_EMIT groupChatsPageReceived(newGroupChats);
+        }
+    }
 
     if (newGroupChats.isEmpty()) {
-        saveGroupChats();
-        Q_EMIT groupChatsReceived(m_groupChats);
-        setIsRunning(false);
+        finishRefresh();
     } else {
+        page.count = newGroupChats.size();
+        m_refreshedPages.append(page);
+        m_refreshedGroupChats.append(newGroupChats);
+
         qCDebug(KAIDAN_CORE_LOG, "Search request fast throttled");
         m_throttler->start(NEXT_TIMEOUT);
     }
 }
 
+void PublicGroupChatSearchController::finishRefresh()
+{
+    // The directory has been modified if pages have been added or removed even if none of the cached pages has been modified.
+    if (m_refreshedPages.size() != m_pages.size()) {
+        m_groupChatsModified = true;
+    }
+
+    m_refreshTime = QDateTime::currentDateTimeUtc();
+
+    if (m_groupChatsModified) {
+        m_groupChats = std::move(m_refreshedGroupChats);
+        m_pages = std::move(m_refreshedPages);
+
+        m_pageIndexesByPreviousAddress.clear();
+
+        for (int i = 0; i < m_pages.size(); ++i) {
+            m_pageIndexesByPreviousAddress.insert(m_pages.at(i).previousAddress, i);
+        }
+
+        saveGroupChats();
+        Q_EMIT groupChatsReceived(m_groupChats);
+    } else {
+        saveRefreshTime();
+    }
+
+    clearRefresh();
+
+    setIsRunning(false);
+}
+
+void PublicGroupChatSearchController::clearRefresh()
+{
+    m_refreshedGroupChats.clear();
+    m_refreshedPages.clear();
+    m_groupChatsModified = false;
+}
+
+bool PublicGroupChatSearchController::isCacheOutdated() const
+{
+    return !m_refreshTime.isValid() || m_refreshTime.msecsTo(QDateTime::currentDateTimeUtc()) >= m_cacheLifetime.count();
+}
+
 QString PublicGroupChatSearchController::saveFilePath() const
 {
     // Don't bother to do checks, Database already do them.
@@ -184,7 +330,7 @@ QString PublicGroupChatSearchController::saveFilePath() const
         return {};
     }
 
-    return dir.absoluteFilePath(QStringLiteral("public-group-chats.json"));
+    return dir.absoluteFilePath(QStringLiteral("public-group-chats.cache"));
 }
 
 bool PublicGroupChatSearchController::saveGroupChats()
@@ -197,9 +343,49 @@ bool PublicGroupChatSearchController::saveGroupChats()
         return false;
     }
 
-    const auto json = QJsonDocument(PublicGroupChat::toJson(m_groupChats)).toJson();
+    // Each language is only stored once and referenced by its index.
+    QStringList languages;
+    QHash<QString, quint16> languageIndexes;
+
+    const auto languageIndex = [&](const QString &language) {
+        if (const auto itr = languageIndexes.constFind(language); itr != languageIndexes.cend()) {
+            return *itr;
+        }
+
+        const auto index = quint16(languages.size());
+        languages.append(language);
+        languageIndexes.insert(language, index);
+
+        return index;
+    };
+
+    QList<QList<quint16>> groupChatLanguageIndexes;
+    groupChatLanguageIndexes.reserve(m_groupChats.size());
+
+    for (const auto &groupChat : std::as_const(m_groupChats)) {
+        groupChatLanguageIndexes.append(transform(groupChat.languages(), languageIndex));
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(CACHE_FILE_STREAM_VERSION);
 
-    if (file.write(json) == -1) {
+    stream << CACHE_FILE_MAGIC << CACHE_FILE_VERSION << m_refreshTime.toMSecsSinceEpoch() << languages;
+
+    stream << qint32(m_pages.size());
+
+    for (const auto &page : std::as_const(m_pages)) {
+        stream << page.previousAddress << qint32(page.count) << page.entityTag << page.lastModified;
+    }
+
+    stream << qint32(m_groupChats.size());
+
+    for (int i = 0; i < m_groupChats.size(); ++i) {
+        const auto &groupChat = m_groupChats.at(i);
+        stream << groupChat.address() << qint32(groupChat.users()) << groupChat.isOpen() << groupChat.name() << groupChat.description()
+               << groupChatLanguageIndexes.at(i);
+    }
+
+    if (stream.status() != QDataStream::Ok) {
         qCWarning(KAIDAN_CORE_LOG, "Cannot save public group chats: %ls, %ls", qUtf16Printable(file.fileName()), qUtf16Printable(file.errorString()));
         file.cancelWriting();
         return false;
@@ -208,6 +394,23 @@ bool PublicGroupChatSearchController::saveGroupChats()
     return file.commit();
 }
 
+bool PublicGroupChatSearchController::saveRefreshTime()
+{
+    QFile file(saveFilePath());
+
+    // Only the refresh time is overwritten if the cached group chats are still up to date.
+    if (!file.exists() || !file.open(QIODevice::ReadWrite) || !file.seek(CACHE_FILE_REFRESH_TIME_POSITION)) {
+        qCWarning(KAIDAN_CORE_LOG, "Cannot update refresh time of public group chats: %ls, %ls", qUtf16Printable(file.fileName()), qUtf16Printable(file.errorString()));
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(CACHE_FILE_STREAM_VERSION);
+    stream << m_refreshTime.toMSecsSinceEpoch();
+
+    return stream.status() == QDataStream::Ok;
+}
+
 bool PublicGroupChatSearchController::readGroupChats()
 {
     const auto filePath = saveFilePath();
@@ -223,15 +426,80 @@ bool PublicGroupChatSearchController::readGroupChats()
         return false;
     }
 
-    QJsonParseError error;
-    const auto document = QJsonDocument::fromJson(file.readAll(), &error);
+    QDataStream stream(&file);
+    stream.setVersion(CACHE_FILE_STREAM_VERSION);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+
+    if (magic != CACHE_FILE_MAGIC || version != CACHE_FILE_VERSION) {
+        qCWarning(KAIDAN_CORE_LOG, "Cannot read public group chats of unknown format: %ls", qUtf16Printable(file.fileName()));
+        return false;
+    }
+
+    qint64 refreshTime = 0;
+    QStringList languages;
+    qint32 pageCount = 0;
+    stream >> refreshTime >> languages >> pageCount;
+
+    QList<Page> pages;
+    int offset = 0;
+
+    for (qint32 i = 0; i < pageCount && stream.status() == QDataStream::Ok; ++i) {
+        Page page;
+        qint32 count = 0;
+        stream >> page.previousAddress >> count >> page.entityTag >> page.lastModified;
+
+        page.offset = offset;
+        page.count = count;
+        offset += count;
+
+        pages.append(page);
+    }
+
+    qint32 groupChatCount = 0;
+    stream >> groupChatCount;
+
+    PublicGroupChats groupChats;
+
+    for (qint32 i = 0; i < groupChatCount && stream.status() == QDataStream::Ok; ++i) {
+        QString address;
+        qint32 users = 0;
+        bool isOpen = false;
+        QString name;
+        QString description;
+        QList<quint16> languageIndexes;
+        stream >> address >> users >> isOpen >> name >> description >> languageIndexes;
+
+        PublicGroupChat groupChat;
+        groupChat.setAddress(address);
+        groupChat.setUsers(users);
+        groupChat.setIsOpen(isOpen);
+        groupChat.setName(name);
+        groupChat.setDescription(description);
+        groupChat.setLanguages(transform(languageIndexes, [&languages](quint16 index) {
+            return languages.value(index);
+        }));
+
+        groupChats.append(groupChat);
+    }
 
-    if (error.error != QJsonParseError::NoError) {
-        qCWarning(KAIDAN_CORE_LOG, "Cannot parse json file: %ls, %ls", qUtf16Printable(file.fileName()), qUtf16Printable(error.errorString()));
+    if (stream.status() != QDataStream::Ok || offset != groupChats.size()) {
+        qCWarning(KAIDAN_CORE_LOG, "Cannot read corrupt public group chats: %ls", qUtf16Printable(file.fileName()));
         return false;
     }
 
-    m_groupChats = PublicGroupChat::fromJson(document.array());
+    m_groupChats = std::move(groupChats);
+    m_pages = std::move(pages);
+    m_refreshTime = QDateTime::fromMSecsSinceEpoch(refreshTime, QTimeZone::UTC);
+
+    m_pageIndexesByPreviousAddress.clear();
+
+    for (int i = 0; i < m_pages.size(); ++i) {
+        m_pageIndexesByPreviousAddress.insert(m_pages.at(i).previousAddress, i);
+    }
+
     return true;
 }
 
@@ -5,7 +5,10 @@
 #pragma once
 
 // Qt
+#include <QDateTime>
+#include <QHash>
 #include <QPointer>
+#include <QUrl>
 // Kaidan
 #include "PublicGroupChat.h"
 
@@ -16,6 +19,14 @@ class QTimer;
 
 using namespace std::chrono_literals;
 
+/**
+ * Retrieves the group chats of the public group chat directory.
+ *
+ * The group chats are cached.
+ * Once requested, the cached group chats are provided immediately.
+ * If the cache is outdated, it is refreshed in the background.
+ * Pages of group chats that have not been modified since they were cached are not transferred again.
+ */
 class PublicGroupChatSearchController : public QObject
 {
     Q_OBJECT
@@ -25,6 +36,7 @@ class PublicGroupChatSearchController : public QObject
 
 public:
     static constexpr auto RequestTimeout = 60s;
+    static constexpr auto CacheLifetime = 1h;
 
     explicit PublicGroupChatSearchController(QNetworkAccessManager *manager, QObject *parent = nullptr);
     explicit PublicGroupChatSearchController(QObject *parent = nullptr);
@@ -33,26 +45,90 @@ public:
     bool isRunning() const;
     PublicGroupChats cachedGroupChats() const;
 
+    /**
+     * Sets the URL of the directory's API endpoint for retrieving group chats.
+     */
+    void setServiceUrl(const QUrl &serviceUrl);
+
+    /**
+     * Sets the duration after which the cached group chats are refreshed.
+     */
+    void setCacheLifetime(std::chrono::milliseconds cacheLifetime);
+
+    /**
+     * Provides the cached group chats and refreshes them if they are outdated.
+     */
     Q_SLOT void requestAll();
+
+    /**
+     * Provides the cached group chats and refreshes them even if they are up to date.
+     *
+     * That is used for refreshes requested by the user.
+     */
+    Q_SLOT void refresh();
+
     Q_SLOT void cancel();
 
     Q_SIGNAL void isRunningChanged(bool running);
     Q_SIGNAL void error(const QString &error);
+
+    /**
+     * Emitted when a modified page of group chats is received while refreshing the cache.
+     */
+    Q_SIGNAL void groupChatsPageReceived(const PublicGroupChats &groupChats);
+
+    /**
+     * Emitted when the cached group chats are loaded or completely refreshed.
+     */
     Q_SIGNAL void groupChatsReceived(const PublicGroupChats &groupChats);
 
 private:
+    /**
+     * Page of group chats as stored in the cache.
+     */
+    struct Page {
+        // address of the last group chat on the previous page used to request this page
+        QString previousAddress;
+        // position of the page's first group chat within all group chats
+        int offset = 0;
+        int count = 0;
+        QByteArray entityTag;
+        QByteArray lastModified;
+    };
+
     void setIsRunning(bool running);
+    void loadCache();
+    void startRefresh();
     QNetworkRequest newRequest(const QString &previousAddress = {}) const;
     void requestFrom(const QString &previousAddress = {});
     void wakeUp();
     void replyFinished(QNetworkReply *reply);
+    void finishRefresh();
+    void clearRefresh();
+    bool isCacheOutdated() const;
+
     QString saveFilePath() const;
     bool saveGroupChats();
+    bool saveRefreshTime();
     bool readGroupChats();
 
     QTimer *const m_throttler;
     QNetworkAccessManager *const m_manager;
     QPointer<QNetworkReply> m_lastReply;
     bool m_isRunning = false;
+    QUrl m_serviceUrl;
+    std::chrono::milliseconds m_cacheLifetime = CacheLifetime;
+
+    // cache
+    bool m_cacheRead = false;
     PublicGroupChats m_groupChats;
+    QList<Page> m_pages;
+    QHash<QString, int> m_pageIndexesByPreviousAddress;
+    QDateTime m_refreshTime;
+
+    // state of a running refresh
+    QString m_requestedPreviousAddress;
+    PublicGroupChats m_refreshedGroupChats;
+    QList<Page> m_refreshedPages;
+    bool m_groupChatsModified = false;
 };
@@ -257,6 +257,11 @@ QString QmlUtils::geoUri(const QGeoCoordinate &geoCoordinate)
 
 QGeoCoordinate QmlUtils::geoCoordinate(const QString &geoUri)
 {
+    // Avoid parsing texts that cannot be geo URIs (e.g., most message bodies).
+    if (!geoUri.startsWith(GEO_URI_SCHEME, Qt::CaseInsensitive) || !QStringView(geoUri).sliced(GEO_URI_SCHEME.size()).startsWith(u':')) {
+        return {};
+    }
+
     QUrl uri(geoUri);
 
     if (uri.scheme() == GEO_URI_SCHEME) {
@@ -7,7 +7,11 @@
 
 #include "RosterDb.h"
 
+// std
+#include <algorithm>
 // Qt
+#include <QHash>
+#include <QSet>
 #include <QSqlDriver>
 #include <QSqlField>
 #include <QSqlQuery>
@@ -25,6 +29,9 @@
 
 using namespace SqlUtils;
 
+// Maximum number of variables in an SQL statement supported by all SQLite versions.
+constexpr qsizetype SQL_VARIABLE_LIMIT = 999;
+
 RosterDb *RosterDb::s_instance = nullptr;
 
 RosterDb::RosterDb(QObject *parent)
@@ -92,10 +99,61 @@ static QSqlRecord createUpdateRecord(const RosterItem &oldItem, const RosterItem
         rec.append(createSqlField(QStringLiteral("notificationRule"), static_cast<int>(newItem.notificationRule)));
     if (oldItem.automaticMediaDownloadsRule != newItem.automaticMediaDownloadsRule)
         rec.append(createSqlField(QStringLiteral("automaticMediaDownloadsRule"), static_cast<int>(newItem.automaticMediaDownloadsRule)));
+    if (oldItem.lastVCardCheckTimestamp != newItem.lastVCardCheckTimestamp)
+        rec.append(createSqlField(QStringLiteral("lastVCardCheckTimestamp"), newItem.lastVCardCheckTimestamp));
 
     return rec;
 }
 
+/**
+ * Executes a statement with a variable number of rows in as few chunks as possible while not
+ * exceeding the maximum number of variables per statement.
+ *
+ * @param query SQL query
+ * @param fixedValues values bound before the values of the rows
+ * @param rows values of each row
+ * @param createStatement function creating the statement for a given number of rows
+ */
+static void execMultiRowQuery(QSqlQuery &query,
+                              const QList<QVariant> &fixedValues,
+                              const QList<QList<QVariant>> &rows,
+                              const std::function<QString(qsizetype rowCount)> &createStatement)
+{
+    if (rows.isEmpty()) {
+        return;
+    }
+
+    const auto rowsPerStatement = std::max<qsizetype>((SQL_VARIABLE_LIMIT - fixedValues.size()) / rows.constFirst().size(), 1);
+
+    for (qsizetype begin = 0; begin < rows.size(); begin += rowsPerStatement) {
+        const auto rowCount = std::min(rowsPerStatement, rows.size() - begin);
+        auto values = fixedValues;
+
+        for (qsizetype i = begin; i < begin + rowCount; ++i) {
+            values.append(rows.at(i));
+        }
+
+        execQueryWithOrderedValues(query, createStatement(rowCount), values);
+    }
+}
+
+/**
+ * Creates placeholders for a multi-row statement such as "(?, ?), (?, ?)".
+ */
+static QString rowPlaceholders(qsizetype rowCount, qsizetype columnCount)
+{
+    const auto row = QStringLiteral("(%1?)").arg(QStringLiteral("?, ").repeated(columnCount - 1));
+    return QList<QString>(rowCount, row).join(u", ");
+}
+
+/**
+ * Creates placeholders for a list of values such as "?, ?".
+ */
+static QString listPlaceholders(qsizetype valueCount)
+{
+    return QList<QString>(valueCount, QStringLiteral("?")).join(u", ");
+}
+
 QFuture<QList<RosterItem>> RosterDb::fetchItems()
 {
     return run([this]() {
@@ -154,6 +212,24 @@ QFuture<void> RosterDb::updateItem(const QString &accountJid, const QString &jid
     });
 }
 
+QFuture<void> RosterDb::updateLastVCardCheckTimestamp(const QString &accountJid, const QString &jid, const QDateTime &timestamp)
+{
+    return run([this, accountJid, jid, timestamp]() {
+        auto query = createQuery();
+        execQuery(query,
+                  QStringLiteral(R"(
+                    UPDATE chats
+                    SET lastVCardCheckTimestamp = :timestamp
+                    WHERE accountJid = :accountJid AND jid = :jid
+                  )"),
+                  {
+                      {u":accountJid", accountJid},
+                      {u":jid", jid},
+                      {u":timestamp", timestamp},
+                  });
+    });
+}
+
 QXmppTask<void> RosterDb::updateOrAddItem(const QString &accountJid, const QString &version, RosterItem item)
 {
     return runTask([this, accountJid, version, item]() mutable {
@@ -280,6 +356,23 @@ void RosterDb::addGroups(const QString &accountJid, const QString &jid, const QL
     }
 }
 
+void RosterDb::addGroups(const QList<RosterItem> &items)
+{
+    QList<QList<QVariant>> rows;
+
+    for (const auto &item : items) {
+        for (const auto &group : item.groups) {
+            rows.append({item.accountJid, item.jid, group});
+        }
+    }
+
+    auto query = createQuery();
+
+    execMultiRowQuery(query, {}, rows, [](qsizetype rowCount) {
+        return QStringLiteral("INSERT OR IGNORE INTO " DB_TABLE_ROSTER_GROUPS " (accountJid, chatJid, name) VALUES ") + rowPlaceholders(rowCount, 3);
+    });
+}
+
 void RosterDb::updateGroups(const RosterItem &oldItem, const RosterItem &newItem)
 {
     const auto &oldGroups = oldItem.groups;
@@ -334,6 +427,19 @@ void RosterDb::removeGroups(const QString &accountJid, const QString &jid)
               {{u":accountJid", accountJid}, {u":chatJid", jid}});
 }
 
+void RosterDb::removeGroups(const QString &accountJid, const QList<QString> &jids)
+{
+    auto query = createQuery();
+
+    const auto rows = transform(jids, [](const QString &jid) {
+        return QList<QVariant>{jid};
+    });
+
+    execMultiRowQuery(query, {accountJid}, rows, [](qsizetype rowCount) {
+        return QStringLiteral("DELETE FROM " DB_TABLE_ROSTER_GROUPS " WHERE accountJid = ? AND chatJid IN (%1)").arg(listPlaceholders(rowCount));
+    });
+}
+
 void RosterDb::fetchLastMessage(RosterItem &item)
 {
     fetchLastMessage(item, fetchBasicItems());
@@ -474,11 +580,7 @@ void RosterDb::_updateOrAddItem(const QString &accountJid, RosterItem item)
         // The item already exists: only override the roster-wire columns and keep all other
         // conversation data (encryption, read markers, pinning, …) untouched.
         _updateItem(accountJid, item.jid, [newItem = item](RosterItem &oldItem) {
-            oldItem.name = newItem.name;
-            oldItem.subscription = newItem.subscription;
-            oldItem.subscriptionStatus = newItem.subscriptionStatus;
-            oldItem.subscriptionApproved = newItem.subscriptionApproved;
-            oldItem.groups = newItem.groups;
+            oldItem.applyWireData(newItem);
         });
     } else {
         _addItem(item);
@@ -487,50 +589,68 @@ void RosterDb::_updateOrAddItem(const QString &accountJid, RosterItem item)
 
 void RosterDb::_replaceItems(const QString &accountJid, const QList<RosterItem> &items, RosterItem::Origin origin)
 {
-    auto oldItems = fetchWireItems(accountJid, origin);
+    const auto oldItems = fetchWireItems(accountJid, origin);
 
-    transaction();
+    QHash<QString, qsizetype> oldItemIndexes;
+    oldItemIndexes.reserve(oldItems.size());
 
-    QList<QString> newJids = transform(items, [](const RosterItem &rosterItem) {
-        return rosterItem.jid;
-    });
+    for (qsizetype i = 0; i < oldItems.size(); ++i) {
+        oldItemIndexes.insert(oldItems.at(i).jid, i);
+    }
 
-    for (const auto &oldItem : std::as_const(oldItems)) {
-        const auto jid = oldItem.jid;
-
-        // We will remove the already existing JIDs, so we get a set of JIDs that
-        // are completely new.
-        //
-        // By calling remove(), we also find out whether the JID is already
-        // existing or not.
-        if (newJids.removeOne(jid)) {
-            auto itr = std::ranges::find_if(items, [jid](const RosterItem &rosterItem) {
-                return rosterItem.jid == jid;
-            });
-
-            // item is also included in newJids -> update
-            _updateItem(accountJid, jid, [newItem = *itr](RosterItem &oldItem) {
-                oldItem.name = newItem.name;
-                oldItem.subscription = newItem.subscription;
-                oldItem.subscriptionStatus = newItem.subscriptionStatus;
-                oldItem.subscriptionApproved = newItem.subscriptionApproved;
-                oldItem.groups = newItem.groups;
-            });
-        } else {
-            // item is not included in newJids -> delete
-            _removeItem(accountJid, jid);
+    // Determine the minimal changes in memory so that unchanged items are not touched.
+    QList<RosterItem> addedItems;
+    QList<RosterItem> updatedItems;
+    QList<QString> removedJids;
+    QList<RosterItem> regroupedItems;
+    QSet<QString> newJids;
+    newJids.reserve(items.size());
+
+    for (const auto &item : items) {
+        newJids.insert(item.jid);
+
+        if (const auto itr = oldItemIndexes.constFind(item.jid); itr == oldItemIndexes.cend()) {
+            addedItems.append(item);
+        } else if (const auto &oldItem = oldItems.at(*itr); !oldItem.hasSameWireData(item)) {
+            auto updatedItem = oldItem;
+            updatedItem.applyWireData(item);
+
+            if (QSet<QString>(oldItem.groups.cbegin(), oldItem.groups.cend()) != QSet<QString>(item.groups.cbegin(), item.groups.cend())) {
+                regroupedItems.append(updatedItem);
+            }
+
+            updatedItems.append(updatedItem);
         }
     }
 
-    // now add the completely new JIDs
-    for (const QString &jid : newJids) {
-        auto itr = std::ranges::find_if(items, [jid](const RosterItem &rosterItem) {
-            return rosterItem.jid == jid;
-        });
-        _addItem(*itr);
+    for (const auto &oldItem : oldItems) {
+        if (!newJids.contains(oldItem.jid)) {
+            removedJids.append(oldItem.jid);
+        }
+    }
+
+    if (!addedItems.isEmpty() || !updatedItems.isEmpty() || !removedJids.isEmpty()) {
+        transaction();
+
+        deleteItems(accountJid, removedJids);
+
+        for (const auto &jid : std::as_const(removedJids)) {
+            GroupChatUserDb::instance()->_removeUsers(accountJid, jid);
+        }
+
+        upsertItems(addedItems + updatedItems);
+
+        removeGroups(accountJid,
+                     transform(regroupedItems, [](const RosterItem &item) {
+                         return item.jid;
+                     }));
+        addGroups(addedItems + regroupedItems);
+
+        commit();
+
+        Q_EMIT itemsChanged(accountJid, addedItems, updatedItems, removedJids);
     }
 
-    commit();
     Q_EMIT itemsReplaced(accountJid);
 }
 
@@ -584,6 +704,72 @@ void RosterDb::_removeItems(const QString &accountJid, RosterItem::Origin origin
     commit();
 }
 
+void RosterDb::upsertItems(const QList<RosterItem> &items)
+{
+    const auto rows = transform(items, [](const RosterItem &item) {
+        return QList<QVariant>{
+            item.accountJid,
+            item.jid,
+            item.name,
+            static_cast<int>(item.origin),
+            static_cast<int>(item.subscription),
+            item.subscriptionStatus,
+            item.subscriptionApproved,
+            item.groupChatParticipantId,
+            item.groupChatName,
+            item.groupChatDescription,
+            static_cast<int>(item.groupChatFlags),
+            item.encryption,
+            QVariant{},
+            QVariant{},
+            QVariant{},
+            QVariant{},
+            item.readMarkerPending,
+            item.pinningPosition,
+            item.chatStateSendingEnabled,
+            item.readMarkerSendingEnabled,
+            static_cast<int>(item.notificationRule),
+            static_cast<int>(item.automaticMediaDownloadsRule),
+        };
+    });
+
+    auto query = createQuery();
+
+    // Only the roster data of stored items is updated to keep all other chat data.
+    execMultiRowQuery(query, {}, rows, [](qsizetype rowCount) {
+        return QStringLiteral(R"(
+                                 INSERT INTO chats (accountJid, jid, name, origin, subscription, subscriptionStatus, subscriptionApproved,
+                                                    groupChatParticipantId, groupChatName, groupChatDescription, groupChatFlags, encryption,
+                                                    lastReadOwnMessageId, lastReadContactMessageId, latestGroupChatMessageStanzaId,
+                                                    latestGroupChatMessageStanzaTimestamp, readMarkerPending, pinningPosition,
+                                                    chatStateSendingEnabled, readMarkerSendingEnabled, notificationRule,
+                                                    automaticMediaDownloadsRule)
+                                 VALUES %1
+                                 ON CONFLICT (accountJid, jid) DO UPDATE SET
+                                    name = excluded.name,
+                                    subscription = excluded.subscription,
+                                    subscriptionStatus = excluded.subscriptionStatus,
+                                    subscriptionApproved = excluded.subscriptionApproved
+                             )")
+            .arg(rowPlaceholders(rowCount, 22));
+    });
+}
+
+void RosterDb::deleteItems(const QString &accountJid, const QList<QString> &jids)
+{
+    auto query = createQuery();
+
+    const auto rows = transform(jids, [](const QString &jid) {
+        return QList<QVariant>{jid};
+    });
+
+    execMultiRowQuery(query, {accountJid}, rows, [](qsizetype rowCount) {
+        return QStringLiteral("DELETE FROM " DB_TABLE_CHATS " WHERE accountJid = ? AND jid IN (%1)").arg(listPlaceholders(rowCount));
+    });
+
+    removeGroups(accountJid, jids);
+}
+
 QList<RosterItem> RosterDb::parseItemsFromQuery(QSqlQuery &query)
 {
     QList<RosterItem> items;
@@ -621,6 +807,7 @@ RosterItem RosterDb::parseItemFromQuery(QSqlQuery &query)
     int idxReadMarkerSendingEnabled = rec.indexOf(QStringLiteral("readMarkerSendingEnabled"));
     int idxNotificationRule = rec.indexOf(QStringLiteral("notificationRule"));
     int idxAutomaticMediaDownloadsRule = rec.indexOf(QStringLiteral("automaticMediaDownloadsRule"));
+    int idxLastVCardCheckTimestamp = rec.indexOf(QStringLiteral("lastVCardCheckTimestamp"));
 
     RosterItem item;
 
@@ -647,6 +834,7 @@ RosterItem RosterDb::parseItemFromQuery(QSqlQuery &query)
     item.readMarkerSendingEnabled = query.value(idxReadMarkerSendingEnabled).toBool();
     item.notificationRule = query.value(idxNotificationRule).value<RosterItem::NotificationRule>();
     item.automaticMediaDownloadsRule = query.value(idxAutomaticMediaDownloadsRule).value<RosterItem::AutomaticMediaDownloadsRule>();
+    item.lastVCardCheckTimestamp = query.value(idxLastVCardCheckTimestamp).toDateTime();
 
     return item;
 }
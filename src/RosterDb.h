@@ -29,7 +29,32 @@ public:
     QFuture<void> replaceBookmarks(const QString &accountJid, const QList<RosterItem> &items);
     Q_SIGNAL void itemsReplaced(const QString &accountJid);
 
+    /**
+     * Emitted once after replacing the items of an account instead of emitting itemAdded(),
+     * itemUpdated() and itemRemoved() for each item.
+     *
+     * Only the data transmitted via the roster is changed for the updated items.
+     * They do not contain data derived from messages such as the last message.
+     *
+     * @param accountJid JID of the account whose items have been replaced
+     * @param addedItems items that have been added
+     * @param updatedItems items whose roster data has changed
+     * @param removedJids JIDs of the items that have been removed
+     */
+    Q_SIGNAL void itemsChanged(const QString &accountJid,
+                               const QList<RosterItem> &addedItems,
+                               const QList<RosterItem> &updatedItems,
+                               const QList<QString> &removedJids);
+
     QFuture<void> updateItem(const QString &accountJid, const QString &jid, const std::function<void(RosterItem &)> &updateItem);
+
+    /**
+     * Stores when the vCard of a contact was requested successfully.
+     *
+     * In contrast to updateItem(), no signal is emitted because the timestamp is only used for
+     * deciding whether to request the vCard again.
+     */
+    QFuture<void> updateLastVCardCheckTimestamp(const QString &accountJid, const QString &jid, const QDateTime &timestamp);
     QXmppTask<void> updateOrAddItem(const QString &accountJid, const QString &version, RosterItem item);
     QFuture<void> addBookmarks(const QString &accountJid, const QList<RosterItem> &items);
     Q_SIGNAL void itemAdded(const RosterItem &item);
@@ -56,9 +81,11 @@ private:
 
     void fetchGroups(RosterItem &item);
     void addGroups(const QString &accountJid, const QString &jid, const QList<QString> &groups);
+    void addGroups(const QList<RosterItem> &items);
     void updateGroups(const RosterItem &oldItem, const RosterItem &newItem);
     void removeGroups(const QString &accountJid);
     void removeGroups(const QString &accountJid, const QString &jid);
+    void removeGroups(const QString &accountJid, const QList<QString> &jids);
 
     void fetchLastMessage(RosterItem &item);
     void fetchLastMessage(RosterItem &item, const QList<RosterItem> &allItems);
@@ -74,6 +101,16 @@ private:
     void _removeItems(const QString &accountJid);
     void _removeItems(const QString &accountJid, RosterItem::Origin origin);
 
+    /**
+     * Adds items or updates the roster data of already stored items via multi-row statements.
+     */
+    void upsertItems(const QList<RosterItem> &items);
+
+    /**
+     * Removes items and their groups via multi-row statements without emitting signals.
+     */
+    void deleteItems(const QString &accountJid, const QList<QString> &jids);
+
     static QList<RosterItem> parseItemsFromQuery(QSqlQuery &query);
     static RosterItem parseItemFromQuery(QSqlQuery &query);
 
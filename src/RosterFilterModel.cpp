@@ -10,7 +10,6 @@
 #include "Account.h"
 #include "AccountController.h"
 #include "Algorithms.h"
-#include "PresenceCache.h"
 #include "RosterModel.h"
 
 RosterFilterModel::RosterFilterModel(QObject *parent)
@@ -114,14 +113,10 @@ bool RosterFilterModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourc
                 return false;
             }
 
-            const auto presenceCache = account->presenceCache();
-
-            if (const auto contactPresence = presenceCache->presence(chatJid)) {
-                if (contactPresence->type() == QXmppPresence::Available) {
-                    if (!m_displayedTypes.testFlag(Type::AvailableContact)) {
-                        return false;
-                    }
-                } else if (!m_displayedTypes.testFlag(Type::UnavailableContact)) {
+            // The source model informs about changed availabilities of contacts so that only their
+            // rows are filtered again.
+            if (sourceModel()->data(index, RosterModel::IsAvailableRole).toBool()) {
+                if (!m_displayedTypes.testFlag(Type::AvailableContact)) {
                     return false;
                 }
             } else if (!m_displayedTypes.testFlag(Type::UnavailableContact)) {
@@ -150,19 +145,7 @@ bool RosterFilterModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourc
 
 void RosterFilterModel::updateAccounts()
 {
-    const auto accounts = AccountController::instance()->accounts();
-
-    const auto keepAvailabilityFilteringUpToDate = [this](Account *account) {
-        connect(account->presenceCache(), &PresenceCache::presenceChanged, this, [this]() {
-            if (m_displayedTypes.testAnyFlags(Type::AvailableContact | Type::UnavailableContact)) {
-                invalidate();
-            }
-        });
-    };
-
-    std::ranges::for_each(accounts, keepAvailabilityFilteringUpToDate);
-
-    updateSelectedAccountJids(accounts);
+    updateSelectedAccountJids(AccountController::instance()->accounts());
 }
 
 void RosterFilterModel::updateSelectedAccountJids(QList<Account *> accounts)
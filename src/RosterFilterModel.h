@@ -11,7 +11,6 @@
 
 // Kaidan
 class Account;
-class PresenceCache;
 
 class RosterFilterModel : public QSortFilterProxyModel
 {
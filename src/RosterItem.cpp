@@ -6,6 +6,8 @@
 
 #include "RosterItem.h"
 
+// Qt
+#include <QSet>
 // QXmpp
 #include <QXmppUtils.h>
 // Kaidan
@@ -156,6 +158,22 @@ bool RosterItem::automaticDownloadsEnabled() const
     Q_UNREACHABLE();
 }
 
+bool RosterItem::hasSameWireData(const RosterItem &other) const
+{
+    return name == other.name && subscription == other.subscription && subscriptionStatus == other.subscriptionStatus
+        && subscriptionApproved == other.subscriptionApproved && groups.size() == other.groups.size()
+        && QSet<QString>(groups.cbegin(), groups.cend()) == QSet<QString>(other.groups.cbegin(), other.groups.cend());
+}
+
+void RosterItem::applyWireData(const RosterItem &other)
+{
+    name = other.name;
+    subscription = other.subscription;
+    subscriptionStatus = other.subscriptionStatus;
+    subscriptionApproved = other.subscriptionApproved;
+    groups = other.groups;
+}
+
 std::strong_ordering RosterItem::operator<=>(const RosterItem &other) const
 {
     // If both items are un-/pinned and one of them has a draft message, the one with the draft message is above the other one.
@@ -118,6 +118,20 @@ public:
     EffectiveNotificationRule effectiveNotificationRule() const;
     bool automaticDownloadsEnabled() const;
 
+    /**
+     * Returns whether the data transmitted via the roster (name, subscription and groups) is the
+     * same as the one of another item.
+     *
+     * The order of the groups is not taken into account.
+     */
+    bool hasSameWireData(const RosterItem &other) const;
+
+    /**
+     * Applies the data transmitted via the roster (name, subscription and groups) of another item
+     * while keeping all other data.
+     */
+    void applyWireData(const RosterItem &other);
+
     bool operator==(const RosterItem &other) const = default;
     std::strong_ordering operator<=>(const RosterItem &other) const;
 
@@ -222,4 +236,8 @@ public:
 
     // Whether files are downloaded automatically.
     AutomaticMediaDownloadsRule automaticMediaDownloadsRule = RosterItem::AutomaticMediaDownloadsRule::Account;
+
+    // Last time the contact's vCard was requested successfully.
+    // It is used to avoid requesting unchanged vCards on each connection.
+    QDateTime lastVCardCheckTimestamp;
 };
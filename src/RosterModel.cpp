@@ -11,12 +11,18 @@
 
 #include "RosterModel.h"
 
+// std
+#include <numeric>
+// Qt
+#include <QHash>
+#include <QSet>
 // Kaidan
 #include "AccountController.h"
 #include "KaidanCoreLog.h"
 #include "MainController.h"
 #include "MessageController.h"
 #include "MessageDb.h"
+#include "PresenceCache.h"
 #include "RosterController.h"
 #include "RosterDb.h"
 #include "RosterItemWatcher.h"
@@ -38,6 +44,7 @@ RosterModel::RosterModel(QObject *parent)
     connect(RosterDb::instance(), &RosterDb::itemUpdated, this, &RosterModel::updateItem);
     connect(RosterDb::instance(), &RosterDb::itemRemoved, this, &RosterModel::removeItem);
     connect(RosterDb::instance(), &RosterDb::itemsRemoved, this, &RosterModel::removeItems);
+    connect(RosterDb::instance(), &RosterDb::itemsChanged, this, &RosterModel::handleItemsChanged);
 
     connect(MessageDb::instance(), &MessageDb::messageAdded, this, &RosterModel::handleMessageAdded);
     connect(MessageDb::instance(), &MessageDb::messageUpdated, this, &RosterModel::handleMessageUpdated);
@@ -47,9 +54,13 @@ RosterModel::RosterModel(QObject *parent)
     connect(MessageDb::instance(), &MessageDb::messageRemoved, this, &RosterModel::handleMessageRemoved);
 
     connect(AccountController::instance(), &AccountController::accountAdded, this, qOverload<Account *>(&RosterModel::initializeNotificationRuleUpdates));
+    connect(AccountController::instance(), &AccountController::accountAdded, this, &RosterModel::initializePresenceUpdates);
 
     connect(AccountController::instance(), &AccountController::accountAvailable, this, [this]() {
         initializeNotificationRuleUpdates();
+        std::ranges::for_each(AccountController::instance()->accounts(), [this](Account *account) {
+            initializePresenceUpdates(account);
+        });
 
         RosterDb::instance()->fetchItems().then(this, [this](const QList<RosterItem> &items) {
             handleItemsFetched(items);
@@ -89,6 +100,7 @@ QHash<int, QByteArray> RosterModel::roleNames() const
     roles[PinnedRole] = QByteArrayLiteral("pinned");
     roles[SelectedRole] = QByteArrayLiteral("selected");
     roles[EffectiveNotificationRuleRole] = QByteArrayLiteral("effectiveNotificationRule");
+    roles[IsAvailableRole] = QByteArrayLiteral("isAvailable");
     return roles;
 }
 
@@ -150,6 +162,8 @@ QVariant RosterModel::data(const QModelIndex &index, int role) const
         return item.selected;
     case EffectiveNotificationRuleRole:
         return QVariant::fromValue(item.effectiveNotificationRule());
+    case IsAvailableRole:
+        return m_availableContacts.contains({item.accountJid, item.jid});
     }
     return {};
 }
@@ -430,6 +444,135 @@ void RosterModel::removeItems(const QString &accountJid)
     }
 }
 
+void RosterModel::handleItemsChanged(const QString &accountJid,
+                                     const QList<RosterItem> &addedItems,
+                                     const QList<RosterItem> &updatedItems,
+                                     const QList<QString> &removedJids)
+{
+    const auto oldGroups = groups();
+
+    QHash<QString, RosterItem> updatedItemsByJid;
+    updatedItemsByJid.reserve(updatedItems.size());
+
+    for (const auto &item : updatedItems) {
+        updatedItemsByJid.insert(item.jid, item);
+    }
+
+    const auto isUpdated = [&accountJid, &updatedItemsByJid](const RosterItem &item) {
+        return item.accountJid == accountJid && updatedItemsByJid.contains(item.jid);
+    };
+
+    // Remove contiguous rows at once starting at the end so that the preceding rows keep their
+    // positions.
+    if (!removedJids.isEmpty()) {
+        const QSet<QString> removedJidSet(removedJids.cbegin(), removedJids.cend());
+
+        const auto isRemoved = [&accountJid, &removedJidSet](const RosterItem &item) {
+            return item.accountJid == accountJid && removedJidSet.contains(item.jid);
+        };
+
+        for (int last = m_items.size() - 1; last >= 0; --last) {
+            if (isRemoved(m_items.at(last))) {
+                int first = last;
+
+                while (first > 0 && isRemoved(m_items.at(first - 1))) {
+                    --first;
+                }
+
+                beginRemoveRows(QModelIndex(), first, last);
+                m_items.remove(first, last - first + 1);
+                endRemoveRows();
+
+                last = first;
+            }
+        }
+    }
+
+    // Apply the new roster data while keeping the data derived from messages.
+    for (int i = 0; i < m_items.size(); ++i) {
+        if (auto &item = m_items[i]; isUpdated(item)) {
+            item.applyWireData(updatedItemsByJid.value(item.jid));
+            Q_EMIT dataChanged(index(i), index(i));
+        }
+    }
+
+    // Renamed items might have to be moved.
+    if (!std::ranges::is_sorted(m_items)) {
+        Q_EMIT layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+
+        QList<qsizetype> order(m_items.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::ranges::stable_sort(order, [this](qsizetype left, qsizetype right) {
+            return m_items.at(left) < m_items.at(right);
+        });
+
+        QList<RosterItem> sortedItems;
+        sortedItems.reserve(m_items.size());
+        QList<qsizetype> newRows(m_items.size());
+
+        for (qsizetype i = 0; i < order.size(); ++i) {
+            sortedItems.append(m_items.at(order.at(i)));
+            newRows[order.at(i)] = i;
+        }
+
+        m_items = std::move(sortedItems);
+
+        const auto persistentIndexes = persistentIndexList();
+
+        for (const auto &persistentIndex : persistentIndexes) {
+            changePersistentIndex(persistentIndex, index(int(newRows.at(persistentIndex.row()))));
+        }
+
+        Q_EMIT layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+    }
+
+    // Insert the added items sharing a position as contiguous rows at once starting at the end so
+    // that the positions of the preceding items stay valid.
+    if (!addedItems.isEmpty()) {
+        auto sortedAddedItems = addedItems;
+        std::ranges::stable_sort(sortedAddedItems);
+
+        for (int last = sortedAddedItems.size(); last > 0;) {
+            const int position = std::ranges::upper_bound(std::as_const(m_items), sortedAddedItems.at(last - 1)) - m_items.cbegin();
+            int first = last - 1;
+
+            while (first > 0 && (position == 0 || !(sortedAddedItems.at(first - 1) < m_items.at(position - 1)))) {
+                --first;
+            }
+
+            beginInsertRows(QModelIndex(), position, position + last - first - 1);
+
+            for (int i = first; i < last; ++i) {
+                m_items.insert(position + i - first, sortedAddedItems.at(i));
+            }
+
+            endInsertRows();
+
+            last = first;
+        }
+    }
+
+    for (const auto &jid : removedJids) {
+        RosterItemNotifier::instance().notifyWatchers(accountJid, jid, std::nullopt);
+        Q_EMIT itemRemoved(accountJid, jid);
+    }
+
+    for (const auto &item : std::as_const(m_items)) {
+        if (isUpdated(item)) {
+            RosterItemNotifier::instance().notifyWatchers(accountJid, item.jid, item);
+        }
+    }
+
+    for (const auto &item : addedItems) {
+        RosterItemNotifier::instance().notifyWatchers(accountJid, item.jid, item);
+        Q_EMIT itemAdded(item);
+    }
+
+    if (oldGroups != groups()) {
+        Q_EMIT groupsChanged();
+    }
+}
+
 void RosterModel::initializeNotificationRuleUpdates()
 {
     std::ranges::for_each(AccountController::instance()->accounts(), [this](Account *account) {
@@ -455,6 +598,86 @@ void RosterModel::handleAccountNotificationRuleChanged()
     }
 }
 
+void RosterModel::initializePresenceUpdates(Account *account)
+{
+    connect(account->presenceCache(),
+            &PresenceCache::presenceChanged,
+            this,
+            [this, account](PresenceCache::ChangeType, const QString &jid, const QString &, bool idealPresenceChanged) {
+                if (idealPresenceChanged) {
+                    handlePresenceChanged(account, jid);
+                }
+            });
+
+    connect(account->presenceCache(), &PresenceCache::presencesCleared, this, [this, account]() {
+        handlePresencesCleared(account);
+    });
+}
+
+void RosterModel::handlePresenceChanged(Account *account, const QString &jid)
+{
+    const auto contact = std::pair(account->settings()->jid(), jid);
+    const auto presence = account->presenceCache()->presence(jid);
+    const auto available = presence && presence->type() == QXmppPresence::Available;
+
+    // Most presences do not change whether a contact is available.
+    if (available == m_availableContacts.contains(contact)) {
+        return;
+    }
+
+    if (available) {
+        m_availableContacts.insert(contact);
+    } else {
+        m_availableContacts.remove(contact);
+    }
+
+    toggleChangedAvailability(contact);
+}
+
+void RosterModel::handlePresencesCleared(Account *account)
+{
+    const auto accountJid = account->settings()->jid();
+
+    for (auto itr = m_availableContacts.begin(); itr != m_availableContacts.end();) {
+        if (itr->first == accountJid) {
+            toggleChangedAvailability(*itr);
+            itr = m_availableContacts.erase(itr);
+        } else {
+            ++itr;
+        }
+    }
+}
+
+void RosterModel::toggleChangedAvailability(const std::pair<QString, QString> &contact)
+{
+    // A contact whose availability changes back within the same event loop iteration is unchanged.
+    if (!m_changedAvailabilityContacts.remove(contact)) {
+        m_changedAvailabilityContacts.insert(contact);
+    }
+
+    if (!m_availabilityInformationScheduled) {
+        m_availabilityInformationScheduled = true;
+        QMetaObject::invokeMethod(this, &RosterModel::informAboutChangedAvailabilities, Qt::QueuedConnection);
+    }
+}
+
+void RosterModel::informAboutChangedAvailabilities()
+{
+    m_availabilityInformationScheduled = false;
+
+    if (m_changedAvailabilityContacts.isEmpty()) {
+        return;
+    }
+
+    for (int i = 0; i < m_items.size(); ++i) {
+        if (const auto &item = m_items.at(i); m_changedAvailabilityContacts.contains({item.accountJid, item.jid})) {
+            Q_EMIT dataChanged(index(i), index(i), {IsAvailableRole});
+        }
+    }
+
+    m_changedAvailabilityContacts.clear();
+}
+
 void RosterModel::handleMessageAdded(const Message &message, MessageOrigin origin)
 {
     auto itr = std::ranges::find_if(m_items, [&message](const RosterItem &item) {
@@ -14,6 +14,7 @@
 // Qt
 #include <QAbstractListModel>
 #include <QFuture>
+#include <QSet>
 // Kaidan
 #include "RosterItem.h"
 
@@ -48,6 +49,7 @@ public:
         PinnedRole,
         SelectedRole,
         EffectiveNotificationRuleRole,
+        IsAvailableRole,
     };
     Q_ENUM(RosterItemRoles)
 
@@ -112,10 +114,34 @@ private:
     void removeItem(const QString &accountJid, const QString &jid);
     void removeItems(const QString &accountJid);
 
+    /**
+     * Applies all changes of a roster replacement at once.
+     *
+     * Contiguous removed or added items are removed or inserted as single row ranges.
+     * Updated items are changed in place and moved via a single layout change.
+     */
+    void handleItemsChanged(const QString &accountJid,
+                            const QList<RosterItem> &addedItems,
+                            const QList<RosterItem> &updatedItems,
+                            const QList<QString> &removedJids);
+
     void initializeNotificationRuleUpdates();
     void initializeNotificationRuleUpdates(Account *account);
     void handleAccountNotificationRuleChanged();
 
+    void initializePresenceUpdates(Account *account);
+    void handlePresenceChanged(Account *account, const QString &jid);
+    void handlePresencesCleared(Account *account);
+    void toggleChangedAvailability(const std::pair<QString, QString> &contact);
+
+    /**
+     * Informs about all contacts whose availability changed since the last call.
+     *
+     * That is done once per event loop iteration so that a flood of presences only results in
+     * filtering the affected rows again (e.g., by RosterFilterModel).
+     */
+    void informAboutChangedAvailabilities();
+
     void handleMessageAdded(const Message &message, MessageOrigin origin);
     void handleMessageUpdated(const Message &message);
     void handleMessageRemoved(const Message &newLastMessage);
@@ -140,5 +166,11 @@ private:
 
     QList<RosterItem> m_items;
 
+    // Account JIDs and JIDs of available contacts
+    QSet<std::pair<QString, QString>> m_availableContacts;
+    // Account JIDs and JIDs of contacts whose availability changed since the last information
+    QSet<std::pair<QString, QString>> m_changedAvailabilityContacts;
+    bool m_availabilityInformationScheduled = false;
+
     static RosterModel *s_instance;
 };
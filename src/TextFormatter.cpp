@@ -18,19 +18,20 @@
 #include "Algorithms.h"
 #include "QmlUtils.h"
 
+using TextType = Enums::TextType;
+
 const auto EMOJI_FONT_FAMILY = QStringLiteral("emoji");
 constexpr auto URL_PREFIX = u"https://";
 constexpr auto SINGLE_EMOJI_SIZE_FACTOR = 3;
 constexpr auto MULTIPLE_EMOJIS_SIZE_FACTOR = 2;
 constexpr auto MIXED_TEXT_EMOJI_SIZE_FACTOR = 1.3;
 
-enum class TextType {
-    Mixed,
-    SingleEmoji,
-    MultipleEmojis,
-};
+static auto isTextSeparator(QChar character)
+{
+    return character.isSpace() || character == MESSAGE_BUBBLE_PADDING_CHARACTER;
+}
 
-static TextType determineTextType(const QString &text)
+static TextType determineGraphemeTextType(const QString &text)
 {
     QTextBoundaryFinder finder(QTextBoundaryFinder::Grapheme, text);
     auto emojiCounter = 0;
@@ -61,9 +62,57 @@ static TextType determineTextType(const QString &text)
     }
 }
 
-static double determineEmojiFontSizeFactor(const QString &text)
+// Returns whether a codepoint can be part of a text that consists only of emojis and separators.
+static bool isPossiblePartOfEmojiText(char32_t codepoint)
+{
+    return u_hasBinaryProperty(codepoint, UCHAR_EMOJI) || u_getIntPropertyValue(codepoint, UCHAR_GRAPHEME_CLUSTER_BREAK) != U_GCB_OTHER;
+}
+
+// Returns whether a text provided character by character can consist only of emojis and separators.
+template<typename CharacterAt>
+static bool isPossibleEmojiText(int characterCount, CharacterAt characterAt)
+{
+    // Determining the text type requires splitting the whole text into graphemes.
+    // Most texts contain a character that cannot be part of an emoji near their beginning.
+    // Thus, they are detected as mixed text without creating the whole text and splitting it.
+    for (int i = 0; i < characterCount; i++) {
+        const QChar character = characterAt(i);
+
+        if (isTextSeparator(character)) {
+            continue;
+        }
+
+        char32_t codepoint = character.unicode();
+
+        if (i + 1 < characterCount && character.isHighSurrogate()) {
+            if (const QChar nextCharacter = characterAt(i + 1); nextCharacter.isLowSurrogate()) {
+                codepoint = QChar::surrogateToUcs4(character, nextCharacter);
+                i++;
+            }
+        }
+
+        if (!isPossiblePartOfEmojiText(codepoint)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static TextType determineDocumentTextType(const QTextDocument *document)
+{
+    if (!isPossibleEmojiText(document->characterCount(), [document](int i) {
+            return document->characterAt(i);
+        })) {
+        return TextType::Mixed;
+    }
+
+    return determineGraphemeTextType(document->toRawText());
+}
+
+static double determineEmojiFontSizeFactor(TextType textType)
 {
-    switch (determineTextType(text)) {
+    switch (textType) {
     case TextType::Mixed:
         return MIXED_TEXT_EMOJI_SIZE_FACTOR;
     case TextType::SingleEmoji:
@@ -75,13 +124,9 @@ static double determineEmojiFontSizeFactor(const QString &text)
     }
 }
 
-static auto isTextSeparator(QChar character)
-{
-    return character.isSpace() || character == MESSAGE_BUBBLE_PADDING_CHARACTER;
-}
-
 // Formats emojis to use an appropriate emoji font that usually displays coloured emojis.
-static void formatEmojis(QTextCursor &cursor, const QString &text, double emojiFontSizeFactor)
+// offset is the position of text within the text document.
+static void formatEmojis(QTextCursor &cursor, int offset, const QString &text, double emojiFontSizeFactor)
 {
     QTextBoundaryFinder finder(QTextBoundaryFinder::Grapheme, text);
 
@@ -90,8 +135,8 @@ static void formatEmojis(QTextCursor &cursor, const QString &text, double emojiF
         auto firstCodepoint = QStringView(text).mid(start, end - start).toUcs4()[0];
 
         if (u_hasBinaryProperty(firstCodepoint, UCHAR_EMOJI_PRESENTATION)) {
-            cursor.setPosition(start, QTextCursor::MoveAnchor);
-            cursor.setPosition(end, QTextCursor::KeepAnchor);
+            cursor.setPosition(offset + start, QTextCursor::MoveAnchor);
+            cursor.setPosition(offset + end, QTextCursor::KeepAnchor);
 
             auto font = QGuiApplication::font();
             font.setFamily(EMOJI_FONT_FAMILY);
@@ -123,12 +168,12 @@ static void removeEmojiFormat(QTextCursor &cursor, int start, int end)
 }
 
 // Marks and highlights URLs to be displayed as links that can be opened.
-static void formatUrls(QTextCursor &cursor, const QString &text)
+static void formatUrls(QTextCursor &cursor, int offset, const QString &text)
 {
-    processTextParts(text, isTextSeparator, [&cursor](qsizetype i, QStringView part) {
+    processTextParts(text, isTextSeparator, [&cursor, offset](qsizetype i, QStringView part) {
         if (part.startsWith(URL_PREFIX)) {
-            cursor.setPosition(i, QTextCursor::MoveAnchor);
-            cursor.setPosition(i + part.size(), QTextCursor::KeepAnchor);
+            cursor.setPosition(offset + i, QTextCursor::MoveAnchor);
+            cursor.setPosition(offset + i + part.size(), QTextCursor::KeepAnchor);
 
             QTextCharFormat format;
 
@@ -142,12 +187,12 @@ static void formatUrls(QTextCursor &cursor, const QString &text)
 }
 
 // Highlights mentions of group chat users.
-static void formatGroupChatUserMentions(QTextCursor &cursor, const QString &text)
+static void formatGroupChatUserMentions(QTextCursor &cursor, int offset, const QString &text)
 {
-    processTextParts(text, isTextSeparator, [&cursor](qsizetype i, QStringView part) {
+    processTextParts(text, isTextSeparator, [&cursor, offset](qsizetype i, QStringView part) {
         if (part.startsWith(GROUP_CHAT_USER_MENTION_PREFIX)) {
-            cursor.setPosition(i, QTextCursor::MoveAnchor);
-            cursor.setPosition(i + part.size(), QTextCursor::KeepAnchor);
+            cursor.setPosition(offset + i, QTextCursor::MoveAnchor);
+            cursor.setPosition(offset + i + part.size(), QTextCursor::KeepAnchor);
 
             QTextCharFormat format;
 
@@ -163,10 +208,31 @@ TextFormatter::TextFormatter(QObject *parent)
 {
 }
 
+TextType TextFormatter::determineTextType(const QString &text)
+{
+    if (!isPossibleEmojiText(text.size(), [&text](int i) {
+            return text.at(i);
+        })) {
+        return TextType::Mixed;
+    }
+
+    return determineGraphemeTextType(text);
+}
+
 void TextFormatter::setTextDocument(QQuickTextDocument *textDocument)
 {
     if (m_textDocument != textDocument) {
+        disconnect(m_contentsChangeConnection);
+
         m_textDocument = textDocument;
+
+        // Connect handleContentsChange() in order to be called each time the text document is modified.
+        // That way, text changes via QML cause the formatting to be applied.
+        if (m_textDocument) {
+            m_contentsChangeConnection =
+                connect(m_textDocument->textDocument(), &QTextDocument::contentsChange, this, &TextFormatter::handleContentsChange);
+        }
+
         update();
     }
 }
@@ -179,59 +245,115 @@ void TextFormatter::setEnhancedFormatting(bool enhancedFormatting)
     }
 }
 
-void TextFormatter::update()
+void TextFormatter::setTextType(TextType textType)
 {
-    if (m_textDocument) {
-        if (m_enhancedFormatting) {
-            attachEnhancedFormatting();
-        } else {
-            attachNormalFormatting();
-        }
+    if (m_textType != textType) {
+        m_textType = textType;
+        update();
     }
 }
 
-void TextFormatter::attachNormalFormatting()
+void TextFormatter::update()
 {
-    attachFormatting([](QTextCursor &cursor, const QString &text) {
-        formatEmojis(cursor, text, MIXED_TEXT_EMOJI_SIZE_FACTOR);
-    });
+    if (m_textDocument) {
+        formatAll();
+    }
 }
 
-void TextFormatter::attachEnhancedFormatting()
+void TextFormatter::formatAll()
 {
-    attachFormatting([](QTextCursor &cursor, const QString &text) {
-        formatEmojis(cursor, text, determineEmojiFontSizeFactor(text));
-        formatUrls(cursor, text);
-        formatGroupChatUserMentions(cursor, text);
-    });
+    const auto document = m_textDocument->textDocument();
+
+    m_formatting = true;
+
+    m_emojiFontSizeFactor = m_enhancedFormatting ? determineEmojiFontSizeFactor(currentTextType()) : MIXED_TEXT_EMOJI_SIZE_FACTOR;
+
+    QTextCursor cursor(document);
+    format(cursor, 0, document->characterCount() - 1);
+
+    m_formatting = false;
 }
 
-void TextFormatter::attachFormatting(const std::function<void(QTextCursor &cursor, const QString &text)> &formatText, int start, int addedCharactersCount)
+void TextFormatter::handleContentsChange(int position, int removedCharactersCount, int addedCharactersCount)
 {
-    auto document = m_textDocument->textDocument();
+    Q_UNUSED(removedCharactersCount)
+
+    if (m_formatting) {
+        return;
+    }
 
-    // Avoid calling this function again and creating an infinite loop if this function modifies the
-    // text document.
-    QObject::disconnect(document, &QTextDocument::contentsChange, this, nullptr);
+    m_formatting = true;
 
+    const auto document = m_textDocument->textDocument();
     QTextCursor cursor(document);
-    auto text = document->toRawText();
+
+    // The last character is the paragraph separator at the end of the document.
+    const auto textSize = document->characterCount() - 1;
 
     // If text is added after an emoji, the format of the emoji is automatically applied to the added text.
     // To not display the added text with the wrong emoji format, the format of the added text is reset.
-    // The added text is afterwards formatted again by formatText() which ensures that added emojis are correctly displayed as well.
-    // "end <= text.size()" is needed since addedCharactersCount is sometimes out of range (for an unknown reason).
-    if (const auto end = start + addedCharactersCount; addedCharactersCount > 0 && end <= text.size()) {
-        removeEmojiFormat(cursor, start, end);
+    // The added text is afterwards formatted again by format() which ensures that added emojis are correctly displayed as well.
+    // "end <= textSize" is needed since addedCharactersCount is sometimes out of range (for an unknown reason).
+    auto end = position + addedCharactersCount;
+
+    if (end > textSize) {
+        end = textSize;
+    } else if (addedCharactersCount > 0) {
+        removeEmojiFormat(cursor, position, end);
     }
 
-    formatText(cursor, text);
+    // A changed emoji size affects all emojis.
+    if (m_enhancedFormatting) {
+        if (const auto emojiFontSizeFactor = determineEmojiFontSizeFactor(currentTextType()); emojiFontSizeFactor != m_emojiFontSizeFactor) {
+            m_emojiFontSizeFactor = emojiFontSizeFactor;
+            format(cursor, 0, textSize);
+            m_formatting = false;
+            return;
+        }
+    }
 
-    // Connect this function in order to be called each time the text document is modified.
-    // That way, text changes via QML cause the formatting to be applied.
-    QObject::connect(document, &QTextDocument::contentsChange, this, [this, formatText](int start, int, int addedCharactersCount) {
-        attachFormatting(formatText, start, addedCharactersCount);
-    });
+    // Otherwise, only the text parts around the change need to be formatted again since emojis,
+    // URLs and mentions never contain separators.
+    auto start = std::min(position, end);
+
+    while (start > 0 && !isTextSeparator(document->characterAt(start - 1))) {
+        start--;
+    }
+
+    while (end < textSize && !isTextSeparator(document->characterAt(end))) {
+        end++;
+    }
+
+    format(cursor, start, end);
+
+    m_formatting = false;
+}
+
+TextType TextFormatter::currentTextType() const
+{
+    if (m_textType == TextType::Unknown) {
+        return determineDocumentTextType(m_textDocument->textDocument());
+    }
+
+    return m_textType;
+}
+
+void TextFormatter::format(QTextCursor &cursor, int start, int end)
+{
+    if (start >= end) {
+        return;
+    }
+
+    cursor.setPosition(start, QTextCursor::MoveAnchor);
+    cursor.setPosition(end, QTextCursor::KeepAnchor);
+    const auto text = cursor.selectedText();
+
+    formatEmojis(cursor, start, text, m_emojiFontSizeFactor);
+
+    if (m_enhancedFormatting) {
+        formatUrls(cursor, start, text);
+        formatGroupChatUserMentions(cursor, start, text);
+    }
 }
 
 #include "moc_TextFormatter.cpp"
@@ -6,6 +6,8 @@
 
 // Qt
 #include <QObject>
+// Kaidan
+#include "Enums.h"
 
 class QQuickTextDocument;
 class QTextCursor;
@@ -16,37 +18,59 @@ class TextFormatter : public QObject
 
     Q_PROPERTY(QQuickTextDocument *textDocument MEMBER m_textDocument WRITE setTextDocument)
     Q_PROPERTY(bool enhancedFormatting MEMBER m_enhancedFormatting WRITE setEnhancedFormatting)
+    Q_PROPERTY(Enums::TextType textType MEMBER m_textType WRITE setTextType)
 
 public:
     explicit TextFormatter(QObject *parent = nullptr);
 
+    /**
+     * Determines whether a text consists only of one or multiple emojis (apart from separators).
+     *
+     * That requires splitting the text into graphemes unless it contains a character that cannot
+     * be part of an emoji.
+     */
+    static Enums::TextType determineTextType(const QString &text);
+
     void setTextDocument(QQuickTextDocument *textDocument);
     void setEnhancedFormatting(bool enhancedFormatting);
 
+    /**
+     * Sets the type of the text if it is already known (e.g., for a message's body).
+     *
+     * That way, it does not need to be determined while formatting.
+     * If it is unknown, it is determined each time the text changes.
+     */
+    void setTextType(Enums::TextType textType);
+
 private:
     void update();
 
     /**
-     * Attaches formatting to a text document in order to format the text on each change with
-     * minimal adjustments.
+     * Formats the whole text in order to display it appropriately.
      *
-     * That results in displaying the text appropriately.
-     * For example, emojis are correctly formatted and a bit enlarged.
+     * With normal formatting, emojis are correctly formatted and a bit enlarged.
+     * With enhanced formatting, emojis are correctly formatted and enlarged depending on their
+     * count while links are marked as such and appropriately highlighted.
      */
-    void attachNormalFormatting();
+    void formatAll();
 
     /**
-     * Attaches formatting to a text document in order to format the text on each change with all
-     * available filters.
+     * Formats only the text parts affected by a change of the text document.
      *
-     * That results in displaying the text appropriately.
-     * For example, emojis are correctly formatted and enlarged depending on their count while links
-     * are marked as such and appropriately highlighted.
+     * If the change modifies how emojis need to be enlarged, the whole text is formatted again.
      */
-    void attachEnhancedFormatting();
+    void handleContentsChange(int position, int removedCharactersCount, int addedCharactersCount);
 
-    void attachFormatting(const std::function<void(QTextCursor &cursor, const QString &text)> &formatText, int start = 0, int addedCharactersCount = 0);
+    void format(QTextCursor &cursor, int start, int end);
+    Enums::TextType currentTextType() const;
 
     QQuickTextDocument *m_textDocument = nullptr;
+    QMetaObject::Connection m_contentsChangeConnection;
     bool m_enhancedFormatting = false;
+    Enums::TextType m_textType = Enums::TextType::Unknown;
+    double m_emojiFontSizeFactor = 1;
+
+    // Whether the text document is currently modified by this formatter.
+    // That is used to avoid handling the resulting changes and creating an infinite loop.
+    bool m_formatting = false;
 };
@@ -0,0 +1,204 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "ThumbnailCache.h"
+
+// Qt
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <QtConcurrentRun>
+// Kaidan
+#include "FutureUtils.h"
+#include "Globals.h"
+#include "KaidanCoreLog.h"
+
+using namespace Qt::Literals::StringLiterals;
+
+// Maximum number of bytes used by decoded thumbnails kept in memory.
+constexpr qsizetype THUMBNAIL_CACHE_MEMORY_LIMIT = 64 * 1024 * 1024;
+
+// Maximum number of bytes used by thumbnails stored on disk.
+constexpr qint64 THUMBNAIL_CACHE_DISK_LIMIT = 256 * 1024 * 1024;
+
+ThumbnailCache &ThumbnailCache::instance()
+{
+    static ThumbnailCache cache(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QDir::separator() + u"thumbnails"_s,
+                                THUMBNAIL_CACHE_MEMORY_LIMIT,
+                                THUMBNAIL_CACHE_DISK_LIMIT);
+    return cache;
+}
+
+ThumbnailCache::ThumbnailCache(const QString &directoryPath, qsizetype memoryLimit, qint64 diskLimit)
+    : m_directoryPath(directoryPath)
+    , m_diskLimit(diskLimit)
+    , m_images(memoryLimit)
+{
+    m_fileThreadPool.setMaxThreadCount(1);
+
+    QDir().mkpath(m_directoryPath);
+    (void)removeLeastRecentlyUsedFiles();
+}
+
+ThumbnailCache::~ThumbnailCache()
+{
+    // Finish pending file operations.
+    m_fileThreadPool.waitForDone();
+}
+
+QFuture<QImage> ThumbnailCache::thumbnail(const QString &localFilePath, int edgePixelCount, qreal devicePixelRatio, Generator generate)
+{
+    const auto thumbnailKey = key(localFilePath, edgePixelCount, devicePixelRatio);
+
+    auto promise = std::make_shared<QPromise<QImage>>();
+    promise->start();
+    auto future = promise->future();
+
+    {
+        QMutexLocker locker(&m_mutex);
+
+        if (const auto *image = m_images.object(thumbnailKey)) {
+            reportFinishedResult(*promise, *image);
+            return future;
+        }
+
+        if (auto itr = m_pendingRequests.find(thumbnailKey); itr != m_pendingRequests.end()) {
+            itr->second.push_back(std::move(promise));
+            return future;
+        }
+
+        m_pendingRequests[thumbnailKey].push_back(std::move(promise));
+    }
+
+    // The thumbnail is decoded without holding the mutex so that other thumbnails can be requested
+    // meanwhile.
+    // Requests for the same thumbnail are added to the pending ones.
+    if (auto image = loadFromDisk(thumbnailKey); !image.isNull()) {
+        image.setDevicePixelRatio(devicePixelRatio);
+        finishRequests(thumbnailKey, image);
+        return future;
+    }
+
+    // Failed or canceled generations finish the pending requests with a null image so that the
+    // thumbnail can be requested again.
+    generate()
+        .then([this, thumbnailKey](QImage &&image) {
+            handleGenerated(thumbnailKey, std::move(image));
+        })
+        .onFailed([this, thumbnailKey]() {
+            finishRequests(thumbnailKey, {});
+        })
+        .onCanceled([this, thumbnailKey]() {
+            finishRequests(thumbnailKey, {});
+        });
+
+    return future;
+}
+
+void ThumbnailCache::clearMemory()
+{
+    QMutexLocker locker(&m_mutex);
+    m_images.clear();
+}
+
+QFuture<void> ThumbnailCache::removeLeastRecentlyUsedFiles()
+{
+    return QtConcurrent::run(&m_fileThreadPool, [this]() {
+        m_fileRemovalScheduled = false;
+
+        // The most recently used thumbnails are listed first.
+        const auto fileInfos = QDir(m_directoryPath).entryInfoList({u"*.png"_s}, QDir::Files, QDir::Time);
+        qint64 usedBytes = 0;
+        qint64 keptBytes = 0;
+
+        for (const auto &fileInfo : fileInfos) {
+            if (usedBytes += fileInfo.size(); usedBytes > m_diskLimit) {
+                QFile::remove(fileInfo.absoluteFilePath());
+            } else {
+                keptBytes = usedBytes;
+            }
+        }
+
+        m_usedDiskBytes = keptBytes;
+    });
+}
+
+QString ThumbnailCache::key(const QString &localFilePath, int edgePixelCount, qreal devicePixelRatio) const
+{
+    const QFileInfo fileInfo(localFilePath);
+    return u"%1:%2:%3:%4:%5"_s.arg(fileInfo.absoluteFilePath(),
+                                   QString::number(fileInfo.lastModified().toMSecsSinceEpoch()),
+                                   QString::number(fileInfo.size()),
+                                   QString::number(edgePixelCount),
+                                   QString::number(devicePixelRatio));
+}
+
+QString ThumbnailCache::diskFilePath(const QString &key) const
+{
+    const auto fileName = QString::fromLatin1(QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex());
+    return m_directoryPath + QDir::separator() + fileName + u".png"_s;
+}
+
+QImage ThumbnailCache::loadFromDisk(const QString &key) const
+{
+    QImage image;
+
+    if (QFile file(diskFilePath(key)); file.open(QIODevice::ReadWrite | QIODevice::ExistingOnly) && image.load(&file, THUMBNAIL_FORMAT)) {
+        // Mark the thumbnail as recently used so that it is kept while cleaning up the disk.
+        file.setFileTime(QDateTime::currentDateTimeUtc(), QFileDevice::FileModificationTime);
+    }
+
+    return image;
+}
+
+void ThumbnailCache::handleGenerated(const QString &key, QImage &&image)
+{
+    if (!image.isNull()) {
+        // Encoding and writing the thumbnail is done in the background since it is not needed for the current request.
+        (void)QtConcurrent::run(&m_fileThreadPool, [this, image, filePath = diskFilePath(key)]() {
+            storeOnDisk(filePath, image);
+        });
+    }
+
+    finishRequests(key, image);
+}
+
+void ThumbnailCache::storeOnDisk(const QString &filePath, const QImage &image)
+{
+    if (!image.save(filePath, THUMBNAIL_FORMAT)) {
+        qCDebug(KAIDAN_CORE_LOG) << "Could not store thumbnail in" << filePath;
+        return;
+    }
+
+    // Thumbnails stored until the removal is run are covered by a single removal.
+    if (m_usedDiskBytes += QFileInfo(filePath).size(); m_usedDiskBytes > m_diskLimit && !m_fileRemovalScheduled) {
+        m_fileRemovalScheduled = true;
+        (void)removeLeastRecentlyUsedFiles();
+    }
+}
+
+void ThumbnailCache::finishRequests(const QString &key, const QImage &image)
+{
+    std::vector<std::shared_ptr<QPromise<QImage>>> promises;
+
+    {
+        QMutexLocker locker(&m_mutex);
+
+        if (auto itr = m_pendingRequests.find(key); itr != m_pendingRequests.end()) {
+            promises = std::move(itr->second);
+            m_pendingRequests.erase(itr);
+        }
+
+        if (!image.isNull()) {
+            m_images.insert(key, new QImage(image), image.sizeInBytes());
+        }
+    }
+
+    for (const auto &promise : promises) {
+        reportFinishedResult(*promise, image);
+    }
+}
@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#pragma once
+
+// std
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+// Qt
+#include <QCache>
+#include <QFuture>
+#include <QImage>
+#include <QMutex>
+#include <QPromise>
+#include <QThreadPool>
+
+/**
+ * Caches decoded thumbnails of local files in memory and on disk.
+ *
+ * The in-memory part is a least-recently-used cache bounded by the byte size of its images.
+ * The on-disk part stores the thumbnails as files in the cache location.
+ * The least recently used files are removed once the files exceed a byte limit.
+ * That is checked whenever a thumbnail is stored on disk.
+ * Entries are keyed by the file path, the file's modification time and size, and the requested thumbnail size.
+ * Thus, a changed file results in a new entry instead of a stale thumbnail.
+ *
+ * Concurrent requests for the same thumbnail are merged so that it is only generated once.
+ */
+class ThumbnailCache
+{
+public:
+    using Generator = std::function<QFuture<QImage>()>;
+
+    static ThumbnailCache &instance();
+
+    /**
+     * @param directoryPath path of the directory for storing thumbnails on disk
+     * @param memoryLimit maximum number of bytes used by the thumbnails kept in memory
+     * @param diskLimit maximum number of bytes used by the thumbnails stored on disk
+     */
+    ThumbnailCache(const QString &directoryPath, qsizetype memoryLimit, qint64 diskLimit);
+    ~ThumbnailCache();
+
+    /**
+     * Returns the thumbnail of a local file.
+     *
+     * If the thumbnail is neither cached in memory nor on disk, it is created by calling generate.
+     * Null images returned by generate are not cached.
+     * If generate fails or is canceled, a null image is returned.
+     *
+     * @param localFilePath path of the file to get a thumbnail for
+     * @param edgePixelCount number of pixels of the thumbnail's longest edge
+     * @param devicePixelRatio device pixel ratio of the thumbnail
+     * @param generate function creating the thumbnail if it is not cached
+     */
+    QFuture<QImage> thumbnail(const QString &localFilePath, int edgePixelCount, qreal devicePixelRatio, Generator generate);
+
+    /**
+     * Removes all thumbnails from memory but keeps them on disk.
+     */
+    void clearMemory();
+
+    /**
+     * Removes the least recently used thumbnails from disk until the remaining ones do not exceed
+     * the disk limit.
+     *
+     * That is done in the background once the cache is created and once the stored thumbnails
+     * exceed the disk limit.
+     */
+    QFuture<void> removeLeastRecentlyUsedFiles();
+
+private:
+    QString key(const QString &localFilePath, int edgePixelCount, qreal devicePixelRatio) const;
+    QString diskFilePath(const QString &key) const;
+    QImage loadFromDisk(const QString &key) const;
+    void handleGenerated(const QString &key, QImage &&image);
+
+    /**
+     * Stores a thumbnail on disk and removes the least recently used thumbnails if the disk limit
+     * is exceeded.
+     *
+     * That is done by the file thread pool.
+     */
+    void storeOnDisk(const QString &filePath, const QImage &image);
+    void finishRequests(const QString &key, const QImage &image);
+
+    const QString m_directoryPath;
+    const qint64 m_diskLimit;
+
+    QMutex m_mutex;
+    QCache<QString, QImage> m_images;
+    std::unordered_map<QString, std::vector<std::shared_ptr<QPromise<QImage>>>> m_pendingRequests;
+
+    // Only accessed by the file thread pool
+    qint64 m_usedDiskBytes = 0;
+    bool m_fileRemovalScheduled = false;
+
+    // Pool with a single thread so that file operations are run in the order they are requested
+    QThreadPool m_fileThreadPool;
+};
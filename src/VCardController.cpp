@@ -10,6 +10,8 @@
 
 // Qt
 #include <QBuffer>
+#include <QCryptographicHash>
+#include <QPromise>
 #include <QTimer>
 // QXmpp
 #include <QXmppUtils.h>
@@ -18,7 +20,9 @@
 // Kaidan
 #include "Account.h"
 #include "AvatarImageCache.h"
+#include "Globals.h"
 #include "PresenceCache.h"
+#include "RosterDb.h"
 #include "RosterModel.h"
 
 using namespace std::chrono_literals;
@@ -36,9 +40,24 @@ VCardController::VCardController(AccountSettings *accountSettings,
     , m_connection(connection)
     , m_presenceCache(presenceCache)
     , m_manager(vCardManager)
+    , m_fetchVCard([vCardManager](const QString &jid) {
+        return vCardManager->fetchVCard(jid);
+    })
+    , m_requestScheduler(MAX_PARALLEL_VCARD_REQUEST_COUNT)
 {
+    m_requestScheduler.setFinishedHandler([this](const QString &jid) {
+        handleVCardRequestFinished(jid);
+    });
+
     connect(client, &QXmppClient::presenceReceived, this, &VCardController::handlePresenceReceived);
 
+    connect(m_connection, &Connection::stateChanged, this, [this]() {
+        if (m_connection->state() == Enums::ConnectionState::StateDisconnected) {
+            m_requestScheduler.clear();
+            m_announcedPhotoHashes.clear();
+        }
+    });
+
     connect(m_manager, &QXmppVCardManager::vCardReceived, this, &VCardController::handleVCardReceived);
     connect(m_manager, &QXmppVCardManager::clientVCardReceived, this, &VCardController::handleOwnVCardReceived);
 
@@ -60,10 +79,34 @@ VCardController::VCardController(AccountSettings *accountSettings,
 void VCardController::requestVCard(const QString &jid)
 {
     if (m_connection->state() == Enums::ConnectionState::StateConnected) {
-        m_manager->requestVCard(jid);
+        scheduleVCardRequest(jid, RequestPriority::Requested);
+    }
+}
+
+void VCardController::prioritizeVCardRequest(const QString &jid)
+{
+    m_visibleJids.insert(jid);
+
+    // Requests by the user keep their priority.
+    if (m_requestScheduler.priority(jid) == RequestPriority::Normal) {
+        m_requestScheduler.setPriority(jid, RequestPriority::Visible);
+    }
+}
+
+void VCardController::deprioritizeVCardRequest(const QString &jid)
+{
+    m_visibleJids.remove(jid);
+
+    if (m_requestScheduler.priority(jid) == RequestPriority::Visible) {
+        m_requestScheduler.setPriority(jid, RequestPriority::Normal);
     }
 }
 
+void VCardController::setVCardFetcher(FetchVCard &&fetchVCard)
+{
+    m_fetchVCard = std::move(fetchVCard);
+}
+
 void VCardController::requestOwnVCard()
 {
     if (m_connection->state() == Enums::ConnectionState::StateConnected) {
@@ -97,25 +140,34 @@ void VCardController::changeAvatar(const QImage &avatar)
 void VCardController::handleRosterItemsFetched(const QList<RosterItem> &rosterItems)
 {
     for (const auto &rosterItem : rosterItems) {
-        requestContactVCard(rosterItem.accountJid, rosterItem.jid, rosterItem.isGroupChat());
+        requestContactVCard(rosterItem);
     }
 }
 
 void VCardController::handleRosterItemAdded(const RosterItem &rosterItem)
 {
-    requestContactVCard(rosterItem.accountJid, rosterItem.jid, rosterItem.isGroupChat());
+    requestContactVCard(rosterItem);
 }
 
-void VCardController::requestContactVCard(const QString &accountJid, const QString &jid, bool isGroupChat)
+void VCardController::requestContactVCard(const RosterItem &rosterItem)
 {
-    if (accountJid != m_accountSettings->jid() || isGroupChat) {
+    if (rosterItem.accountJid != m_accountSettings->jid() || rosterItem.isGroupChat()) {
         return;
     }
 
-    auto requestVCardOfUnavailableContact = [this, jid]() {
+    // Avoid requesting vCards that have been requested recently.
+    // Changes of the avatars of available contacts are covered by handlePresenceReceived().
+    if (const auto &lastCheckTimestamp = rosterItem.lastVCardCheckTimestamp;
+        lastCheckTimestamp.isValid() && lastCheckTimestamp.addDuration(VCARD_CHECK_INTERVAL) > QDateTime::currentDateTimeUtc()) {
+        return;
+    }
+
+    auto requestVCardOfUnavailableContact = [this, jid = rosterItem.jid]() {
         QTimer::singleShot(VCARD_FETCHING_AFTER_CONNECTING_DELAY, this, [this, jid] {
             if (const auto presence = m_presenceCache->presence(jid); !presence || presence->type() == QXmppPresence::Unavailable) {
-                requestVCard(jid);
+                if (m_connection->state() == Enums::ConnectionState::StateConnected) {
+                    scheduleVCardRequest(jid);
+                }
             }
         });
     };
@@ -134,6 +186,55 @@ void VCardController::requestContactVCard(const QString &accountJid, const QStri
     }
 }
 
+void VCardController::scheduleVCardRequest(const QString &jid, RequestPriority priority)
+{
+    if (m_visibleJids.contains(jid)) {
+        priority = std::max(priority, RequestPriority::Visible);
+    }
+
+    m_requestScheduler.enqueue(jid, priority, [this, jid]() {
+        return fetchVCard(jid);
+    });
+}
+
+void VCardController::handleVCardRequestFinished(const QString &jid)
+{
+    if (m_announcedPhotoHashes.remove(jid) && m_connection->state() == Enums::ConnectionState::StateConnected) {
+        scheduleVCardRequest(jid);
+    }
+}
+
+QFuture<void> VCardController::fetchVCard(const QString &jid)
+{
+    auto promise = std::make_shared<QPromise<void>>();
+    promise->start();
+
+    m_fetchVCard(jid).then(this, [this, jid, promise](QXmppVCardManager::Result &&result) {
+        if (auto vCard = std::get_if<QXmppVCardIq>(&result)) {
+            // The sender is needed to assign a containing avatar to the contact.
+            if (vCard->from().isEmpty()) {
+                vCard->setFrom(jid);
+            }
+
+            // The announced avatar is contained if the request was answered after announcing it.
+            if (const auto photoHash = QString::fromUtf8(QCryptographicHash::hash(vCard->photo(), QCryptographicHash::Sha1).toHex());
+                m_announcedPhotoHashes.value(jid) == photoHash) {
+                m_announcedPhotoHashes.remove(jid);
+            }
+
+            handleVCardReceived(*vCard);
+            RosterDb::instance()->updateLastVCardCheckTimestamp(m_accountSettings->jid(), jid, QDateTime::currentDateTimeUtc());
+        } else if (std::get<QXmppError>(result).holdsType<QXmppStanza::Error>()) {
+            // An error response such as "item-not-found" means that there is no vCard.
+            RosterDb::instance()->updateLastVCardCheckTimestamp(m_accountSettings->jid(), jid, QDateTime::currentDateTimeUtc());
+        }
+
+        promise->finish();
+    });
+
+    return promise->future();
+}
+
 void VCardController::handleVCardReceived(const QXmppVCardIq &vCard)
 {
     addAvatar(vCard);
@@ -164,9 +265,17 @@ void VCardController::handlePresenceReceived(const QXmppPresence &presence)
         QString hash = AvatarImageCache::instance()->getHashOfJid(QXmppUtils::jidToBareJid(presence.from()));
         QString newHash = QString::fromUtf8(presence.photoHash().toHex());
 
-        // check if hash differs and we need to refetch the avatar
+        // Check if the hash differs and the avatar needs to be requested.
+        // Multiple resources announcing the same new hash result in only one request as long as
+        // the previous one is running.
+        // A hash announced while a request is running is requested afterwards unless the response
+        // already contains the announced avatar.
         if (hash != newHash) {
-            m_manager->requestVCard(QXmppUtils::jidToBareJid(presence.from()));
+            if (const auto bareJid = QXmppUtils::jidToBareJid(presence.from()); m_requestScheduler.isRunning(bareJid)) {
+                m_announcedPhotoHashes.insert(bareJid, newHash);
+            } else {
+                scheduleVCardRequest(bareJid);
+            }
         }
     } else if (presence.vCardUpdateType() == QXmppPresence::VCardUpdateNoPhoto) {
         QString bareJid = QXmppUtils::jidToBareJid(presence.from());
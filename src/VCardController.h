@@ -7,11 +7,17 @@
 
 #pragma once
 
+// std
+#include <functional>
 // Qt
 #include <QImage>
 #include <QObject>
+#include <QSet>
 // QXmpp
 #include <QXmppVCardIq.h>
+#include <QXmppVCardManager.h>
+// Kaidan
+#include "PriorityScheduler.h"
 
 struct RosterItem;
 
@@ -21,7 +27,6 @@ class Connection;
 class PresenceCache;
 class QXmppClient;
 class QXmppPresence;
-class QXmppVCardManager;
 
 class VCardController : public QObject
 {
@@ -38,10 +43,41 @@ public:
     /**
      * Requests the vCard of a given JID from the JID's server.
      *
+     * The request is started before the ones of contacts not being displayed.
+     * If the vCard is already being requested, it is not requested again.
+     *
      * @param jid JID for which the vCard is being requested
      */
     void requestVCard(const QString &jid);
 
+    /**
+     * Requests the vCard of a contact before the ones of other contacts.
+     *
+     * That is used for contacts that are visible to the user.
+     * It also affects vCard requests enqueued later (e.g., once connected).
+     *
+     * @param jid bare JID of the contact
+     */
+    Q_INVOKABLE void prioritizeVCardRequest(const QString &jid);
+
+    /**
+     * Requests the vCard of a contact that is not visible anymore in its normal order.
+     *
+     * @param jid bare JID of the contact
+     */
+    Q_INVOKABLE void deprioritizeVCardRequest(const QString &jid);
+
+    /**
+     * Function requesting a vCard from the server.
+     */
+    using FetchVCard = std::function<QFuture<QXmppVCardManager::Result>(const QString &jid)>;
+
+    /**
+     * Sets the function used to request vCards instead of the vCard manager (e.g., to answer the
+     * requests locally).
+     */
+    void setVCardFetcher(FetchVCard &&fetchVCard);
+
     /**
      * Requests the user's vCard from the server.
      */
@@ -62,15 +98,38 @@ public:
     Q_SIGNAL void avatarChangeSucceeded();
 
 private:
+    enum class RequestPriority {
+        Normal,
+        Visible,
+        Requested,
+    };
+
     void handleRosterItemsFetched(const QList<RosterItem> &items);
     void handleRosterItemAdded(const RosterItem &rosterItem);
 
     /**
-     * Requests the vCard of an unavailable contact.
+     * Requests the vCard of an unavailable contact if it has not been requested recently.
      *
      * Available contacts are already covered by handlePresenceReceived().
      */
-    void requestContactVCard(const QString &accountJid, const QString &jid, bool isGroupChat);
+    void requestContactVCard(const RosterItem &rosterItem);
+
+    /**
+     * Enqueues a vCard request.
+     */
+    void scheduleVCardRequest(const QString &jid, RequestPriority priority = RequestPriority::Normal);
+
+    /**
+     * Requests a vCard again if a new avatar has been announced while it was being requested.
+     */
+    void handleVCardRequestFinished(const QString &jid);
+
+    /**
+     * Requests a vCard and processes it once received.
+     *
+     * @return a future that finishes once the response is received
+     */
+    QFuture<void> fetchVCard(const QString &jid);
 
     /**
      * Handles an incoming vCard and processes it like saving a containing user avatar etc..
@@ -107,6 +166,14 @@ private:
     Connection *const m_connection;
     PresenceCache *const m_presenceCache;
     QXmppVCardManager *const m_manager;
+    FetchVCard m_fetchVCard;
+    PriorityScheduler<QString, RequestPriority> m_requestScheduler;
+
+    // Bare JIDs of contacts visible to the user
+    QSet<QString> m_visibleJids;
+
+    // Hashes of avatars announced by contacts whose vCards were being requested
+    QHash<QString, QString> m_announcedPhotoHashes;
 
     QString m_nicknameToBeSetAfterReceivingCurrentVCard;
     QImage m_avatarToBeSetAfterReceivingCurrentVCard;
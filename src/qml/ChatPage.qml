@@ -401,6 +401,7 @@ SearchBarPage {
 			ownReactionsFailed: model.ownReactionsFailed
 			groupChatInvitationJid: model.groupChatInvitationJid
 			geoCoordinate: model.geoCoordinate
+			bodyTextType: model.bodyTextType
 			marked: model.marked
 
 			onOpenMediaViewerRequested: function(fileId) {
@@ -55,6 +55,7 @@ SearchBarPage {
 		}
 		delegate: RosterItemDelegate {
 			property bool active: root.activeChatPage?.chatController.account.settings.jid === accountJid && root.activeChatPage.chatController.jid === jid
+			readonly property var vCardController: model.account.vCardController
 
 			highlighted: rosterListView.currentIndex === model.index || pinned && _previousMove.newIndex === model.index && _previousMove.oldIndex !== model.index
 			checked: !Kirigami.Settings.isMobile && active
@@ -79,6 +80,14 @@ SearchBarPage {
 			pinModeActive: pinButton.checked
 			pinned: model.pinned
 			effectiveNotificationRule: model.effectiveNotificationRule
+			Component.onCompleted: {
+				// Request the vCards of visible contacts before the ones of other contacts.
+				vCardController.prioritizeVCardRequest(jid)
+			}
+			Component.onDestruction: {
+				// Request the vCards of contacts that are not visible anymore in their normal order.
+				vCardController?.deprioritizeVCardRequest(jid)
+			}
 			onClicked: {
 				root.searchField.reset()
 
@@ -62,6 +62,7 @@ Controls.ItemDelegate {
 	property bool ownReactionsFailed
 	property string groupChatInvitationJid
 	property var geoCoordinate
+	property int bodyTextType
 	property bool marked
 	property bool isGroupBegin: determineMessageGroupDelimiter(messageListView.count - 1, 1)
 	property bool isGroupEnd: determineMessageGroupDelimiter()
@@ -293,6 +294,7 @@ Controls.ItemDelegate {
 										enabled: true
 										visible: messageBody
 										enhancedFormatting: true
+										textType: root.bodyTextType
 										padding: root.bubblePadding
 										Layout.maximumWidth: root.maximumBubbleContentWidth
 									}
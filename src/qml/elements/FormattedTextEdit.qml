@@ -20,6 +20,9 @@ TextEdit {
 	// marked as such)
 	property alias enhancedFormatting: formatter.enhancedFormatting
 
+	// Type of the text if it is already known (e.g., for a message's body)
+	property alias textType: formatter.textType
+
 	color: Kirigami.Theme.textColor
 	wrapMode: Text.Wrap
 	readOnly: true
@@ -51,6 +51,7 @@ Dialog {
 		id: listView
 		model: GroupChatUserFilterModel {
 			sourceModel: GroupChatUserModel {
+				id: groupChatUserModel
 				accountJid: root.account.settings.jid
 				chatJid: root.chatJid
 			}
@@ -82,7 +83,7 @@ Dialog {
 
 	function search(text) {
 		_searchedText = text
-		listView.model.setFilterFixedString(searchedText.toLowerCase())
+		groupChatUserModel.searchString = searchedText
 	}
 
 	function selectCurrentItem() {
@@ -21,6 +21,16 @@ MediumPreview {
 	size: file.formattedSize
 	localFileUrl: file.localFileUrl
 	type: file.type
+	Component.onCompleted: {
+		// Download visible files before the ones of other messages.
+		if (file.transferState === File.TransferState.Pending) {
+			root.message.chatController.account.fileSharingController.prioritizeDownload(file)
+		}
+	}
+	Component.onDestruction: {
+		// Download files that are not visible anymore (e.g., scrolled away) in their normal order.
+		root.message?.chatController?.account.fileSharingController.deprioritizeDownload(file)
+	}
 	mainArea.data: MediumMouseArea {
 		id: opacityChangingMouseArea
 		opacityItem: parent.background
@@ -56,7 +56,7 @@ Dialog {
 					ListViewSearchField {
 						listView: groupChatListView
 						Layout.fillWidth: true
-						onTextChanged: publicGroupChatProxyModel.setFilterWildcard(text)
+						onTextChanged: publicGroupChatProxyModel.searchText = text
 						onActiveFocusChanged: {
 							// Force the active focus when it is lost.
 							if (!Kirigami.Settings.isMobile && !activeFocus) {
@@ -102,7 +102,7 @@ Dialog {
 									anchors.verticalCenter: parent.verticalCenter
 									onClicked: {
 										root.errorMessage = ""
-										publicGroupChatSearchController.requestAll()
+										publicGroupChatSearchController.refresh()
 									}
 								}
 							}
@@ -177,6 +177,7 @@ Dialog {
 	PublicGroupChatSearchController {
 		id: publicGroupChatSearchController
 		onError: root.errorMessage = qsTr("The public groups could not be retrieved: %1", "%1 is an error message").arg(error)
+		onGroupChatsPageReceived: groupChats => publicGroupChatModel.addGroupChats(groupChats)
 	}
 
 	Connections {
@@ -0,0 +1,218 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// std
+#include <memory>
+#include <vector>
+// Qt
+#include <QDir>
+#include <QRandomGenerator>
+#include <QStandardPaths>
+#include <QTest>
+// Kaidan
+#include "AvatarImageCache.h"
+#include "Test.h"
+#include "TestUtils.h"
+
+class AvatarImageCacheTest : public Test
+{
+    Q_OBJECT
+
+private:
+    Q_SLOT void initTestCase() override;
+    Q_SLOT void cleanupTestCase();
+    Q_SLOT void keyedNotifications();
+    Q_SLOT void backgroundStoring();
+    Q_SLOT void avatarListStoring();
+    Q_SLOT void burstStoring();
+
+    std::unique_ptr<AvatarImageCache> m_cache;
+};
+
+void AvatarImageCacheTest::initTestCase()
+{
+    Test::initTestCase();
+
+    // Remove avatars of previous runs.
+    QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)).removeRecursively();
+
+    m_cache = std::make_unique<AvatarImageCache>();
+}
+
+void AvatarImageCacheTest::cleanupTestCase()
+{
+    m_cache.reset();
+}
+
+void AvatarImageCacheTest::keyedNotifications()
+{
+    constexpr int jidCount = 1000;
+    constexpr int watchersPerJid = 5;
+
+    const auto jid = [](int i) {
+        return QStringLiteral("user%1@kaidan.im").arg(i);
+    };
+
+    std::vector<std::unique_ptr<AvatarImageWatcher>> watchers;
+    std::vector<int> wakeUpCounts(jidCount * watchersPerJid, 0);
+    watchers.reserve(jidCount * watchersPerJid);
+
+    for (int i = 0; i < jidCount; ++i) {
+        for (int j = 0; j < watchersPerJid; ++j) {
+            const auto index = watchers.size();
+            auto &watcher = watchers.emplace_back(std::make_unique<AvatarImageWatcher>());
+            watcher->setJid(jid(i));
+            connect(watcher.get(), &AvatarImageWatcher::urlChanged, this, [&wakeUpCounts, index]() {
+                wakeUpCounts[index]++;
+            });
+        }
+    }
+
+    QCOMPARE(watchers.size(), std::size_t(5000));
+
+    // A new avatar only wakes up the watchers of its JID.
+    wait(m_cache->addAvatar(jid(42), QByteArrayLiteral("avatar-1")));
+
+    // An unchanged avatar wakes up nobody.
+    wait(m_cache->addAvatar(jid(42), QByteArrayLiteral("avatar-1")));
+
+    // An already stored avatar used by another JID only wakes up the watchers of that JID.
+    wait(m_cache->addAvatar(jid(7), QByteArrayLiteral("avatar-1")));
+
+    // A removed avatar only wakes up the watchers of its JID.
+    m_cache->clearAvatar(jid(42));
+
+    // Clearing a JID without an avatar wakes up nobody.
+    m_cache->clearAvatar(jid(100));
+
+    for (std::size_t index = 0; index < wakeUpCounts.size(); ++index) {
+        const auto jidIndex = int(index) / watchersPerJid;
+
+        if (jidIndex == 42) {
+            QCOMPARE(wakeUpCounts[index], 2);
+        } else if (jidIndex == 7) {
+            QCOMPARE(wakeUpCounts[index], 1);
+        } else {
+            QCOMPARE(wakeUpCounts[index], 0);
+        }
+    }
+
+    // Destroyed watchers are not woken up anymore.
+    watchers.erase(watchers.begin() + 7 * watchersPerJid, watchers.begin() + 8 * watchersPerJid);
+    m_cache->clearAvatar(jid(7));
+    wait(m_cache->addAvatar(jid(8), QByteArrayLiteral("avatar-2")));
+
+    QCOMPARE(wakeUpCounts[8 * watchersPerJid], 1);
+}
+
+void AvatarImageCacheTest::backgroundStoring()
+{
+    const auto jid = QStringLiteral("background@kaidan.im");
+    const auto avatar = QByteArrayLiteral("avatar-3");
+
+    auto future = m_cache->addAvatar(jid, avatar);
+
+    // The avatar is stored in the background and the hash of the JID is only updated afterwards.
+    QVERIFY(!future.isFinished());
+    QVERIFY(m_cache->getHashOfJid(jid).isEmpty());
+
+    const auto result = wait(future);
+    QVERIFY(result.hasChanged);
+    QVERIFY(result.newWritten);
+    QCOMPARE(m_cache->getHashOfJid(jid), result.hash);
+
+    QFile file(m_cache->getAvatarPathOfJid(jid));
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QCOMPARE(file.readAll(), avatar);
+    file.close();
+
+    // A replaced avatar is deleted once it is not used anymore.
+    const auto oldAvatarPath = m_cache->getAvatarPathOfJid(jid);
+    wait(m_cache->addAvatar(jid, QByteArrayLiteral("avatar-4")));
+    QTRY_VERIFY(!QFile::exists(oldAvatarPath));
+}
+
+void AvatarImageCacheTest::avatarListStoring()
+{
+    const auto keptJid = QStringLiteral("kept@kaidan.im");
+    const auto removedJid = QStringLiteral("removed@kaidan.im");
+
+    wait(m_cache->addAvatar(keptJid, QByteArrayLiteral("avatar-5")));
+    wait(m_cache->addAvatar(removedJid, QByteArrayLiteral("avatar-6")));
+    const auto keptHash = m_cache->getHashOfJid(keptJid);
+
+    // The cache is destroyed (e.g., on quit) before the deferred saving of the avatar list is done.
+    m_cache->clearAvatar(removedJid);
+    m_cache.reset();
+
+    // The saved avatar list is loaded after a restart.
+    m_cache = std::make_unique<AvatarImageCache>();
+    QCOMPARE(m_cache->getHashOfJid(keptJid), keptHash);
+    QVERIFY(m_cache->getHashOfJid(removedJid).isEmpty());
+}
+
+void AvatarImageCacheTest::burstStoring()
+{
+    constexpr int avatarCount = 1000;
+    constexpr int avatarSize = 64 * 1024;
+
+    const auto jid = [](int i) {
+        return QStringLiteral("burst%1@kaidan.im").arg(i);
+    };
+
+    QList<QByteArray> avatars;
+    avatars.reserve(avatarCount);
+
+    for (int i = 0; i < avatarCount; ++i) {
+        QByteArray avatar(avatarSize, Qt::Uninitialized);
+        QRandomGenerator::global()->fillRange(reinterpret_cast<quint32 *>(avatar.data()), avatarSize / sizeof(quint32));
+        avatars.append(avatar);
+    }
+
+    QList<QFuture<AvatarImageCache::AddAvatarResult>> futures;
+    futures.reserve(avatarCount);
+
+    // Number of avatars that were stored before addAvatar() returned and thus blocked the event loop
+    int synchronouslyStoredCount = 0;
+
+    // Each avatar is received in its own event as after logging in.
+    for (int i = 0; i < avatarCount; ++i) {
+        QMetaObject::invokeMethod(
+            this,
+            [this, &futures, &avatars, &jid, &synchronouslyStoredCount, i]() {
+                auto future = m_cache->addAvatar(jid(i), avatars.at(i));
+
+                if (future.isFinished() || !m_cache->getHashOfJid(jid(i)).isEmpty()) {
+                    synchronouslyStoredCount++;
+                }
+
+                futures.append(future);
+            },
+            Qt::QueuedConnection);
+    }
+
+    QTRY_COMPARE_WITH_TIMEOUT(futures.size(), avatarCount, 30000);
+    QCOMPARE(synchronouslyStoredCount, 0);
+
+    QHash<QString, QString> hashes;
+
+    for (int i = 0; i < avatarCount; ++i) {
+        const auto result = wait(futures.at(i));
+        QVERIFY(result.newWritten);
+        QCOMPARE(m_cache->getHashOfJid(jid(i)), result.hash);
+        hashes.insert(jid(i), result.hash);
+    }
+
+    // The avatar list saved for the whole burst contains all avatars.
+    m_cache.reset();
+    m_cache = std::make_unique<AvatarImageCache>();
+
+    for (auto itr = hashes.cbegin(); itr != hashes.cend(); ++itr) {
+        QCOMPARE(m_cache->getHashOfJid(itr.key()), itr.value());
+        QVERIFY(QFile::exists(m_cache->getAvatarPathOfJid(itr.key())));
+    }
+}
+
+QTEST_GUILESS_MAIN(AvatarImageCacheTest)
+#include "AvatarImageCacheTest.moc"
@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Qt
+#include <QMimeDatabase>
+#include <QTest>
+// QXmpp
+#include <QXmppBitsOfBinaryContentId.h>
+// Kaidan
+#include "BitsOfBinaryCache.h"
+#include "Test.h"
+
+constexpr qsizetype DATA_SIZE = 1024;
+constexpr qsizetype CACHE_SIZE_LIMIT = 256 * DATA_SIZE;
+constexpr int ENTRY_COUNT = 5000;
+
+class BitsOfBinaryCacheTest : public Test
+{
+    Q_OBJECT
+
+private:
+    Q_SLOT void insertAndRemove();
+    Q_SLOT void boundedSize();
+    Q_SLOT void leastRecentlyUsedEviction();
+    Q_SLOT void lookup_data();
+    Q_SLOT void lookup();
+
+    static QXmppBitsOfBinaryData createData(int index);
+};
+
+void BitsOfBinaryCacheTest::insertAndRemove()
+{
+    BitsOfBinaryCache cache(CACHE_SIZE_LIMIT);
+    const auto data = createData(0);
+    const auto cidUrl = data.cid().toCidUrl();
+
+    QVERIFY(!cache.data(cidUrl));
+    QCOMPARE(cache.missCount(), quint64(1));
+
+    QVERIFY(cache.insert(data));
+    QCOMPARE(cache.data(cidUrl)->data(), data.data());
+    QCOMPARE(cache.hitCount(), quint64(1));
+
+    QVERIFY(cache.remove(data.cid()));
+    QVERIFY(!cache.remove(data.cid()));
+    QVERIFY(!cache.data(cidUrl));
+    QCOMPARE(cache.missCount(), quint64(2));
+
+    // Data exceeding the size limit is not stored.
+    QXmppBitsOfBinaryData tooLargeData;
+    tooLargeData.setData(QByteArray(CACHE_SIZE_LIMIT + 1, 'x'));
+    tooLargeData.setCid(QXmppBitsOfBinaryContentId::fromContentId(QStringLiteral("sha1+toolarge@bob.xmpp.org")));
+    QVERIFY(!cache.insert(tooLargeData));
+    QCOMPARE(cache.count(), qsizetype(0));
+}
+
+void BitsOfBinaryCacheTest::boundedSize()
+{
+    BitsOfBinaryCache cache(CACHE_SIZE_LIMIT);
+
+    for (int i = 0; i < ENTRY_COUNT; ++i) {
+        cache.insert(createData(i));
+        QVERIFY(cache.size() <= cache.sizeLimit());
+    }
+
+    QCOMPARE(cache.count(), CACHE_SIZE_LIMIT / DATA_SIZE);
+    QCOMPARE(cache.size(), CACHE_SIZE_LIMIT);
+
+    // The most recently inserted data is kept and the oldest one is evicted.
+    QVERIFY(cache.data(createData(ENTRY_COUNT - 1).cid().toCidUrl()));
+    QVERIFY(!cache.data(createData(0).cid().toCidUrl()));
+}
+
+void BitsOfBinaryCacheTest::leastRecentlyUsedEviction()
+{
+    BitsOfBinaryCache cache(CACHE_SIZE_LIMIT);
+    const auto entryLimit = int(CACHE_SIZE_LIMIT / DATA_SIZE);
+
+    for (int i = 0; i < entryLimit; ++i) {
+        cache.insert(createData(i));
+    }
+
+    // Using the oldest data prevents it from being evicted.
+    const auto firstCidUrl = createData(0).cid().toCidUrl();
+    QVERIFY(cache.data(firstCidUrl));
+
+    cache.insert(createData(entryLimit));
+
+    QVERIFY(cache.data(firstCidUrl));
+    QVERIFY(!cache.data(createData(1).cid().toCidUrl()));
+}
+
+void BitsOfBinaryCacheTest::lookup_data()
+{
+    QTest::addColumn<int>("entryCount");
+
+    QTest::newRow("100") << 100;
+    QTest::newRow("5000") << ENTRY_COUNT;
+}
+
+void BitsOfBinaryCacheTest::lookup()
+{
+    QFETCH(int, entryCount);
+
+    // The lookup time must not depend on the number of stored entries.
+    BitsOfBinaryCache cache(qsizetype(entryCount) * DATA_SIZE);
+
+    for (int i = 0; i < entryCount; ++i) {
+        cache.insert(createData(i));
+    }
+
+    QCOMPARE(cache.count(), qsizetype(entryCount));
+
+    // Each entry is found by its content ID URL regardless of its position.
+    for (int i = 0; i < entryCount; ++i) {
+        const auto data = createData(i);
+        QCOMPARE(cache.data(data.cid().toCidUrl())->data(), data.data());
+    }
+
+    QCOMPARE(cache.hitCount(), quint64(entryCount));
+    QCOMPARE(cache.missCount(), quint64(0));
+
+    const auto expectedData = createData(entryCount / 2);
+    const auto cidUrl = expectedData.cid().toCidUrl();
+
+    QBENCHMARK {
+        QCOMPARE(cache.data(cidUrl)->data(), expectedData.data());
+    }
+
+    // Looking up entries does neither evict nor add any.
+    QCOMPARE(cache.count(), qsizetype(entryCount));
+    QCOMPARE(cache.missCount(), quint64(0));
+}
+
+QXmppBitsOfBinaryData BitsOfBinaryCacheTest::createData(int index)
+{
+    auto data = QXmppBitsOfBinaryData::fromByteArray(QByteArray::number(index).leftJustified(DATA_SIZE, ' '));
+    data.setContentType(QMimeDatabase().mimeTypeForName(QStringLiteral("image/png")));
+    return data;
+}
+
+QTEST_GUILESS_MAIN(BitsOfBinaryCacheTest)
+#include "BitsOfBinaryCacheTest.moc"
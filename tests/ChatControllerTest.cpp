@@ -0,0 +1,178 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Qt
+#include <QSignalSpy>
+#include <QTest>
+// Kaidan
+#include "Account.h"
+#include "ChatController.h"
+#include "Globals.h"
+#include "MessageDb.h"
+#include "MessageModel.h"
+#include "RosterModel.h"
+#include "Test.h"
+#include "TestUtils.h"
+
+static const auto accountJid = QStringLiteral("user@example.org");
+static constexpr int chatCount = MAX_CACHED_CHAT_COUNT + 2;
+static constexpr int messageCount = 100;
+static constexpr int chatSwitchCount = 50;
+
+class ChatControllerTest : public Test
+{
+    Q_OBJECT
+
+private:
+    Q_SLOT void initTestCase() override;
+    Q_SLOT void testCachedChatReused();
+    Q_SLOT void testCachedChatKeptUpToDate();
+    Q_SLOT void testCachedChatEvicted();
+    Q_SLOT void benchmarkAlternatingChatSwitches();
+
+    /**
+     * Opens a chat and waits until its first message can be rendered.
+     */
+    void openChat(ChatController &chatController, int chatNumber);
+
+    static QString chatJid(int number);
+    static Message message(int chatNumber, int messageNumber);
+
+    Account *m_account = nullptr;
+};
+
+void ChatControllerTest::initTestCase()
+{
+    Test::initTestCase();
+
+    m_account = addAccount(accountJid);
+
+    for (int i = 0; i < chatCount; ++i) {
+        addRosterItem(accountJid, chatJid(i));
+
+        for (int j = 0; j < messageCount; ++j) {
+            wait(MessageDb::instance()->addMessage(message(i, j), MessageOrigin::Stream));
+        }
+    }
+}
+
+void ChatControllerTest::testCachedChatReused()
+{
+    ChatController chatController;
+
+    openChat(chatController, 0);
+    auto *messageModel = chatController.messageModel();
+    QCOMPARE(messageModel->chatJid(), chatJid(0));
+
+    openChat(chatController, 1);
+    QVERIFY(chatController.messageModel() != messageModel);
+
+    // The messages of a cached chat are available without fetching them again.
+    chatController.initialize(m_account, chatJid(0));
+    QCOMPARE(chatController.messageModel(), messageModel);
+    QVERIFY(messageModel->rowCount() > 0);
+}
+
+void ChatControllerTest::testCachedChatKeptUpToDate()
+{
+    ChatController chatController;
+
+    openChat(chatController, 0);
+    auto *messageModel = chatController.messageModel();
+    const auto rowCount = messageModel->rowCount();
+
+    openChat(chatController, 1);
+
+    // A message received for a cached chat is added to its model.
+    auto newMessage = message(0, messageCount);
+    newMessage.timestamp = QDateTime::currentDateTimeUtc();
+    wait(MessageDb::instance()->addMessage(newMessage, MessageOrigin::Stream));
+
+    QTRY_COMPARE(messageModel->rowCount(), rowCount + 1);
+
+    chatController.initialize(m_account, chatJid(0));
+    QCOMPARE(chatController.messageModel(), messageModel);
+    QCOMPARE(messageModel->data(messageModel->index(0), MessageModel::Id).toString(), newMessage.id);
+}
+
+void ChatControllerTest::testCachedChatEvicted()
+{
+    ChatController chatController;
+
+    for (int i = 0; i < chatCount; ++i) {
+        openChat(chatController, i);
+    }
+
+    // The least recently opened chats are evicted once the cache is full.
+    chatController.initialize(m_account, chatJid(0));
+    QCOMPARE(chatController.messageModel()->rowCount(), 0);
+
+    chatController.initialize(m_account, chatJid(chatCount - 1));
+    QVERIFY(chatController.messageModel()->rowCount() > 0);
+}
+
+void ChatControllerTest::benchmarkAlternatingChatSwitches()
+{
+    ChatController chatController;
+
+    openChat(chatController, 0);
+    auto *firstMessageModel = chatController.messageModel();
+    openChat(chatController, 1);
+    auto *secondMessageModel = chatController.messageModel();
+
+    QSignalSpy firstRowsInsertedSpy(firstMessageModel, &QAbstractItemModel::rowsInserted);
+    QSignalSpy secondRowsInsertedSpy(secondMessageModel, &QAbstractItemModel::rowsInserted);
+    QSignalSpy firstFetchingFinishedSpy(firstMessageModel, &MessageModel::messageFetchingFinished);
+    QSignalSpy secondFetchingFinishedSpy(secondMessageModel, &MessageModel::messageFetchingFinished);
+
+    QBENCHMARK_ONCE {
+        for (int i = 0; i < chatSwitchCount; ++i) {
+            openChat(chatController, i % 2);
+            QCOMPARE(chatController.messageModel(), i % 2 ? secondMessageModel : firstMessageModel);
+        }
+    }
+
+    // Switching back to a cached chat finishes its fetching without loading its messages from the
+    // database again.
+    QTRY_VERIFY(!firstFetchingFinishedSpy.isEmpty() && !secondFetchingFinishedSpy.isEmpty());
+    QVERIFY(firstRowsInsertedSpy.isEmpty());
+    QVERIFY(secondRowsInsertedSpy.isEmpty());
+}
+
+void ChatControllerTest::openChat(ChatController &chatController, int chatNumber)
+{
+    chatController.initialize(m_account, chatJid(chatNumber));
+
+    // Emulate a view fetching the messages to be rendered.
+    if (auto *messageModel = chatController.messageModel(); messageModel->rowCount() == 0) {
+        QSignalSpy rowsInsertedSpy(messageModel, &QAbstractItemModel::rowsInserted);
+
+        if (messageModel->canFetchMore({})) {
+            messageModel->fetchMore({});
+        }
+
+        rowsInsertedSpy.wait();
+    }
+}
+
+QString ChatControllerTest::chatJid(int number)
+{
+    return QStringLiteral("contact-%1@example.org").arg(number);
+}
+
+Message ChatControllerTest::message(int chatNumber, int messageNumber)
+{
+    Message message;
+    message.accountJid = accountJid;
+    message.chatJid = chatJid(chatNumber);
+    message.isOwn = true;
+    message.id = QStringLiteral("message-%1-%2").arg(chatNumber).arg(messageNumber);
+    message.timestamp = QDateTime::currentDateTimeUtc().addSecs(messageNumber - messageCount);
+    message.setPreparedBody(QStringLiteral("Message %1").arg(messageNumber));
+
+    return message;
+}
+
+QTEST_GUILESS_MAIN(ChatControllerTest)
+#include "ChatControllerTest.moc"
@@ -0,0 +1,140 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Qt
+#include <QTest>
+// Kaidan
+#include "ChatMarkerBatcher.h"
+#include "Test.h"
+
+using ChatMarkers = ChatMarkerBatcher::ChatMarkers;
+
+static constexpr int chatCount = 10;
+static constexpr int markerCount = 1000;
+
+class ChatMarkerBatcherTest : public Test
+{
+    Q_OBJECT
+
+private:
+    Q_SLOT void testCatchUpReplay();
+    Q_SLOT void testLastWriterWins();
+    Q_SLOT void testSeparateDirections();
+
+    static QString chatJid(int number);
+    static QString messageId(int number);
+};
+
+void ChatMarkerBatcherTest::testCatchUpReplay()
+{
+    QHash<QString, ChatMarkers> storedMarkers;
+    int rosterWriteCount = 0;
+
+    ChatMarkerBatcher batcher([&](const ChatMarkers &markers) {
+        rosterWriteCount++;
+        storedMarkers.insert(markers.chatJid, markers);
+    });
+
+    const auto startTimestamp = QDateTime::currentDateTimeUtc();
+
+    // Markers of a MAM catch-up arrive back to back in archive order.
+    for (int i = 0; i < markerCount; ++i) {
+        const auto timestamp = startTimestamp.addSecs(i);
+
+        if (i % 2) {
+            batcher.addOwnMarker(chatJid(i % chatCount), messageId(i), timestamp);
+        } else {
+            batcher.addContactMarker(chatJid(i % chatCount), messageId(i), timestamp);
+        }
+    }
+
+    // Nothing is stored before the event loop is entered.
+    QCOMPARE(rosterWriteCount, 0);
+    QCOMPARE(batcher.pendingChatCount(), chatCount);
+
+    QTRY_COMPARE(storedMarkers.size(), chatCount);
+
+    // The markers of each chat are stored with a single roster write.
+    QCOMPARE(rosterWriteCount, chatCount);
+    QCOMPARE(batcher.pendingChatCount(), 0);
+
+    // Only the newest marker of each chat is stored.
+    for (int i = 0; i < chatCount; ++i) {
+        const auto newestMarkerNumber = markerCount - chatCount + i;
+        const auto markers = storedMarkers.value(chatJid(i));
+
+        if (newestMarkerNumber % 2) {
+            QCOMPARE(markers.ownMarker.markedId, messageId(newestMarkerNumber));
+            QVERIFY(!markers.contactMarker.isValid());
+        } else {
+            QCOMPARE(markers.contactMarker.markedId, messageId(newestMarkerNumber));
+            QVERIFY(!markers.ownMarker.isValid());
+        }
+    }
+}
+
+void ChatMarkerBatcherTest::testLastWriterWins()
+{
+    QList<ChatMarkers> storedMarkers;
+
+    ChatMarkerBatcher batcher([&storedMarkers](const ChatMarkers &markers) {
+        storedMarkers.append(markers);
+    });
+
+    const auto timestamp = QDateTime::currentDateTimeUtc();
+
+    batcher.addOwnMarker(chatJid(1), messageId(1), timestamp);
+    batcher.addOwnMarker(chatJid(1), messageId(2), timestamp.addSecs(1));
+
+    // A delayed marker does not override a newer one.
+    batcher.addOwnMarker(chatJid(1), messageId(3), timestamp.addSecs(-1));
+
+    // A marker with the same timestamp received later overrides the previous one.
+    batcher.addOwnMarker(chatJid(2), messageId(4), timestamp);
+    batcher.addOwnMarker(chatJid(2), messageId(5), timestamp);
+
+    batcher.flush();
+
+    QCOMPARE(storedMarkers.size(), 2);
+    QCOMPARE(storedMarkers.at(0).chatJid, chatJid(1));
+    QCOMPARE(storedMarkers.at(0).ownMarker.markedId, messageId(2));
+    QCOMPARE(storedMarkers.at(1).chatJid, chatJid(2));
+    QCOMPARE(storedMarkers.at(1).ownMarker.markedId, messageId(5));
+
+    // The already flushed markers are not flushed again.
+    QTest::qWait(0);
+    QCOMPARE(storedMarkers.size(), 2);
+}
+
+void ChatMarkerBatcherTest::testSeparateDirections()
+{
+    QList<ChatMarkers> storedMarkers;
+
+    ChatMarkerBatcher batcher([&storedMarkers](const ChatMarkers &markers) {
+        storedMarkers.append(markers);
+    });
+
+    const auto timestamp = QDateTime::currentDateTimeUtc();
+
+    // Markers of both directions are stored together but do not override each other.
+    batcher.addOwnMarker(chatJid(1), messageId(1), timestamp);
+    batcher.addContactMarker(chatJid(1), messageId(2), timestamp.addSecs(1));
+
+    QTRY_COMPARE(storedMarkers.size(), 1);
+    QCOMPARE(storedMarkers.constFirst().ownMarker.markedId, messageId(1));
+    QCOMPARE(storedMarkers.constFirst().contactMarker.markedId, messageId(2));
+}
+
+QString ChatMarkerBatcherTest::chatJid(int number)
+{
+    return QStringLiteral("contact-%1@example.org").arg(number);
+}
+
+QString ChatMarkerBatcherTest::messageId(int number)
+{
+    return QStringLiteral("message-%1").arg(number);
+}
+
+QTEST_GUILESS_MAIN(ChatMarkerBatcherTest)
+#include "ChatMarkerBatcherTest.moc"
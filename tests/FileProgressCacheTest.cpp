@@ -0,0 +1,111 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Qt
+#include <QSignalSpy>
+#include <QTest>
+// Kaidan
+#include "FileProgressCache.h"
+#include "Test.h"
+
+constexpr auto PROGRESS_EVENT_COUNT = 100000;
+
+class FileProgressCacheTest : public Test
+{
+    Q_OBJECT
+
+private:
+    Q_SLOT void throttledNotifications();
+    Q_SLOT void latestProgress();
+};
+
+void FileProgressCacheTest::throttledNotifications()
+{
+    constexpr qint64 fileId = 1;
+    constexpr quint64 bytesTotal = PROGRESS_EVENT_COUNT;
+
+    auto &cache = FileProgressCache::instance();
+
+    FileProgressWatcher watcher;
+    watcher.setFileId(QString::number(fileId));
+
+    QSignalSpy spy(&watcher, &FileProgressWatcher::progressChanged);
+
+    // The start of a transfer is reported immediately.
+    cache.reportProgress(fileId, FileProgress{QStringLiteral("alice@kaidan.im"), 0, bytesTotal, 0.0F, {}});
+    QCOMPARE(spy.count(), 1);
+    QVERIFY(watcher.isLoading());
+
+    // The progress events of a fast transfer arrive back to back.
+    for (quint64 i = 1; i <= bytesTotal; ++i) {
+        cache.updateProgress(fileId, i, bytesTotal, float(i) / bytesTotal);
+    }
+
+    QCOMPARE(spy.count(), 1);
+
+    // The watchers are notified once about the latest progress.
+    QVERIFY(spy.wait());
+    QCOMPARE(spy.count(), 2);
+    QCOMPARE(watcher.bytesSent(), bytesTotal);
+
+    // The notification of a concurrent transfer indicates when pending notifications are sent.
+    constexpr qint64 otherFileId = 4;
+
+    FileProgressWatcher otherWatcher;
+    otherWatcher.setFileId(QString::number(otherFileId));
+    cache.reportProgress(otherFileId, FileProgress{QStringLiteral("alice@kaidan.im"), 0, bytesTotal, 0.0F, {}});
+
+    QSignalSpy otherSpy(&otherWatcher, &FileProgressWatcher::progressChanged);
+
+    cache.updateProgress(fileId, bytesTotal, bytesTotal, 1.0F);
+    cache.updateProgress(otherFileId, 1, bytesTotal, 1.0F / bytesTotal);
+
+    // The end of a transfer is reported immediately.
+    const auto notificationCount = spy.count();
+    cache.reportFinished(fileId);
+    QCOMPARE(spy.count(), notificationCount + 1);
+    QVERIFY(!watcher.isLoading());
+
+    // Pending notifications are dropped once the transfer is finished.
+    QVERIFY(otherSpy.wait());
+    QCOMPARE(spy.count(), notificationCount + 1);
+
+    cache.reportFinished(otherFileId);
+}
+
+void FileProgressCacheTest::latestProgress()
+{
+    constexpr qint64 fileId = 2;
+
+    auto &cache = FileProgressCache::instance();
+
+    FileProgressWatcher watcher;
+    watcher.setFileId(QString::number(fileId));
+
+    cache.reportProgress(fileId, FileProgress{QStringLiteral("alice@kaidan.im"), 0, 100, 0.0F, {}});
+
+    QSignalSpy spy(&watcher, &FileProgressWatcher::progressChanged);
+
+    cache.updateProgress(fileId, 10, 100, 0.1F);
+    cache.updateProgress(fileId, 20, 100, 0.2F);
+    cache.updateProgress(fileId, 30, 100, 0.3F);
+
+    // The stored progress is updated immediately while the watchers are notified later.
+    QCOMPARE(cache.progress(fileId)->bytesSent, quint64(30));
+    QCOMPARE(spy.count(), 0);
+
+    QVERIFY(spy.wait());
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(watcher.bytesSent(), quint64(30));
+    QCOMPARE(watcher.progress(), 0.3F);
+
+    // Updates of unknown transfers are ignored.
+    cache.updateProgress(3, 10, 100, 0.1F);
+    QVERIFY(!cache.progress(3));
+
+    cache.reportFinished(fileId);
+}
+
+QTEST_GUILESS_MAIN(FileProgressCacheTest)
+#include "FileProgressCacheTest.moc"
@@ -0,0 +1,201 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Qt
+#include <QSignalSpy>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTest>
+// Kaidan
+#include "Account.h"
+#include "ClientController.h"
+#include "FileSharingController.h"
+#include "Globals.h"
+#include "MediaUtils.h"
+#include "MessageDb.h"
+#include "RosterItem.h"
+#include "Test.h"
+
+static const auto accountJid = QStringLiteral("user@example.org");
+static const auto chatJid = QStringLiteral("contact@example.org");
+static const auto messageId = QStringLiteral("message-1");
+static constexpr int fileCount = 6;
+
+/**
+ * Local file server that holds back its responses until they are released.
+ *
+ * That allows to inspect the requests being in flight at the same time.
+ */
+class FileServer : public QTcpServer
+{
+public:
+    FileServer()
+    {
+        QVERIFY(listen(QHostAddress::LocalHost));
+        connect(this, &QTcpServer::newConnection, this, &FileServer::handleNewConnections);
+    }
+
+    QUrl url(qint64 fileId) const
+    {
+        return QUrl(QStringLiteral("http://127.0.0.1:%1/file-%2.txt").arg(serverPort()).arg(fileId));
+    }
+
+    int pendingRequestCount() const
+    {
+        return int(m_pendingRequests.size());
+    }
+
+    /**
+     * Answers the oldest request that has not been answered yet.
+     */
+    void respond()
+    {
+        auto *socket = m_pendingRequests.takeFirst();
+        const auto body = QByteArrayLiteral("content");
+
+        socket->write(QByteArrayLiteral("HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length: ") + QByteArray::number(body.size())
+                      + QByteArrayLiteral("\r\nConnection: close\r\n\r\n") + body);
+        socket->disconnectFromHost();
+    }
+
+    int maxPendingRequestCount = 0;
+
+private:
+    void handleNewConnections()
+    {
+        while (auto *socket = nextPendingConnection()) {
+            connect(socket, &QTcpSocket::readyRead, this, [this, socket]() {
+                handleRequest(socket);
+            });
+            connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+        }
+    }
+
+    void handleRequest(QTcpSocket *socket)
+    {
+        if (!socket->peek(socket->bytesAvailable()).contains("\r\n\r\n")) {
+            return;
+        }
+
+        socket->readAll();
+
+        m_pendingRequests.append(socket);
+        maxPendingRequestCount = std::max(maxPendingRequestCount, pendingRequestCount());
+    }
+
+    QList<QTcpSocket *> m_pendingRequests;
+};
+
+class FileSharingControllerTest : public Test
+{
+    Q_OBJECT
+
+private:
+    Q_SLOT void initTestCase() override;
+    Q_SLOT void testDownloadPriorities();
+
+    /**
+     * Returns the IDs of the files in the order their downloads were started.
+     */
+    static QList<qint64> startedDownloads(const QSignalSpy &filesUpdatedSpy);
+
+    static Message message(const FileServer &fileServer);
+
+    Account *m_account = nullptr;
+};
+
+void FileSharingControllerTest::initTestCase()
+{
+    Test::initTestCase();
+
+    m_account = addAccount(accountJid);
+
+    RosterItem item;
+    item.accountJid = accountJid;
+    item.jid = chatJid;
+    item.automaticMediaDownloadsRule = RosterItem::AutomaticMediaDownloadsRule::Always;
+    addRosterItem(item);
+
+    // Downloads are only started while being connected.
+    Q_EMIT m_account->clientController()->connectionStateChanged(Enums::ConnectionState::StateConnected);
+}
+
+void FileSharingControllerTest::testDownloadPriorities()
+{
+    FileServer fileServer;
+
+    auto *fileSharingController = m_account->fileSharingController();
+    QSignalSpy filesUpdatedSpy(MessageDb::instance(), &MessageDb::filesUpdated);
+
+    // The files of a received message are automatically downloaded.
+    const auto receivedMessage = message(fileServer);
+    Q_EMIT MessageDb::instance()->messageAdded(receivedMessage, MessageOrigin::Stream);
+
+    const auto &files = receivedMessage.files;
+
+    // The previews of files become visible.
+    fileSharingController->prioritizeDownload(files.at(4));
+    fileSharingController->prioritizeDownload(files.at(3));
+
+    // The user requests a download.
+    fileSharingController->downloadFile(chatJid, messageId, files.at(5));
+
+    // The previews of files become invisible again.
+    fileSharingController->deprioritizeDownload(files.at(3));
+    fileSharingController->prioritizeDownload(files.at(5));
+    fileSharingController->deprioritizeDownload(files.at(5));
+
+    // Only a limited number of downloads is in flight at the same time.
+    // Each answered request makes room for the next download.
+    for (int answeredRequestCount = 0; answeredRequestCount < fileCount; ++answeredRequestCount) {
+        QTRY_COMPARE(fileServer.pendingRequestCount(), std::min(MAX_PARALLEL_FILE_DOWNLOAD_COUNT, fileCount - answeredRequestCount));
+        fileServer.respond();
+    }
+
+    QCOMPARE(fileServer.maxPendingRequestCount, MAX_PARALLEL_FILE_DOWNLOAD_COUNT);
+
+    // The download requested by the user keeps the highest priority while the file that is not
+    // visible anymore is downloaded in its normal order.
+    QTRY_COMPARE(startedDownloads(filesUpdatedSpy).size(), fileCount);
+    QCOMPARE(startedDownloads(filesUpdatedSpy), (QList<qint64>{6, 5, 1, 2, 3, 4}));
+}
+
+QList<qint64> FileSharingControllerTest::startedDownloads(const QSignalSpy &filesUpdatedSpy)
+{
+    QList<qint64> fileIds;
+
+    for (const auto &arguments : filesUpdatedSpy) {
+        for (const auto &update : arguments.constFirst().value<QList<MessageDb::FileUpdate>>()) {
+            if (update.transferState == File::TransferState::Transferring) {
+                fileIds.append(update.fileId);
+            }
+        }
+    }
+
+    return fileIds;
+}
+
+Message FileSharingControllerTest::message(const FileServer &fileServer)
+{
+    Message message;
+    message.accountJid = accountJid;
+    message.chatJid = chatJid;
+    message.isOwn = true;
+    message.id = messageId;
+    message.timestamp = QDateTime::currentDateTimeUtc();
+
+    for (qint64 fileId = 1; fileId <= fileCount; ++fileId) {
+        File file;
+        file.id = fileId;
+        file.name = QStringLiteral("file-%1.txt").arg(fileId);
+        file.mimeType = MediaUtils::mimeDatabase().mimeTypeForName(QStringLiteral("text/plain"));
+        file.httpSources = {HttpSource{fileId, fileServer.url(fileId)}};
+        message.files.append(file);
+    }
+
+    return message;
+}
+
+QTEST_GUILESS_MAIN(FileSharingControllerTest)
+#include "FileSharingControllerTest.moc"
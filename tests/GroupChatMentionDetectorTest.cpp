@@ -0,0 +1,190 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Qt
+#include <QSignalSpy>
+#include <QTest>
+// Kaidan
+#include "Database.h"
+#include "GroupChatMentionDetector.h"
+#include "GroupChatUserDb.h"
+#include "RosterDb.h"
+#include "Test.h"
+#include "TestUtils.h"
+
+static const auto accountJid = QStringLiteral("user@example.org");
+static const auto chatJid = QStringLiteral("channel@groups.example.org");
+static constexpr int messageCount = 10000;
+
+class GroupChatMentionDetectorTest : public Test
+{
+    Q_OBJECT
+
+public:
+    GroupChatMentionDetectorTest();
+
+private:
+    Q_SLOT void initTestCase() override;
+    Q_SLOT void testChannelMessages();
+    Q_SLOT void testOwnParticipantUpdated();
+    Q_SLOT void testOwnParticipantChanged();
+    Q_SLOT void testGroupChatRemoved();
+
+    /**
+     * Checks whether a message body mentions the own participant.
+     *
+     * @return whether the user has been mentioned so far, which is only set later if the own
+     *         participant has to be retrieved from the database first
+     */
+    static std::shared_ptr<bool> checkMention(GroupChatMentionDetector &detector, const QString &ownParticipantId, const QString &body);
+
+    /**
+     * Checks whether a message body mentions the own participant and waits until it is checked.
+     */
+    bool isMentioned(GroupChatMentionDetector &detector, const QString &ownParticipantId, const QString &body);
+
+    static GroupChatUser ownParticipant(const QString &id, const QString &name);
+
+    Database db;
+    GroupChatUserDb *groupChatUserDb = nullptr;
+    RosterDb *rosterDb = nullptr;
+};
+
+GroupChatMentionDetectorTest::GroupChatMentionDetectorTest()
+{
+    groupChatUserDb = new GroupChatUserDb(this);
+    rosterDb = new RosterDb(this);
+}
+
+void GroupChatMentionDetectorTest::initTestCase()
+{
+    Test::initTestCase();
+
+    wait(groupChatUserDb->handleParticipantReceived(ownParticipant(QStringLiteral("participant-1"), QStringLiteral("Alice"))));
+}
+
+void GroupChatMentionDetectorTest::testChannelMessages()
+{
+    GroupChatMentionDetector detector;
+    int mentionCount = 0;
+    int expectedMentionCount = 0;
+
+    for (int i = 0; i < messageCount; ++i) {
+        QString body;
+
+        if (i % 10 == 0) {
+            body = QStringLiteral("Hi Alice, message %1").arg(i);
+            expectedMentionCount++;
+        } else if (i % 25 == 0) {
+            body = QStringLiteral("Ping user@example.org, message %1").arg(i);
+            expectedMentionCount++;
+        } else {
+            body = QStringLiteral("Hi all, message %1 (Alic e)").arg(i);
+        }
+
+        detector.checkMention(accountJid, chatJid, QStringLiteral("participant-1"), body, [&mentionCount]() {
+            mentionCount++;
+        });
+    }
+
+    QTRY_COMPARE(mentionCount, expectedMentionCount);
+
+    // Once retrieved from the database, the own participant is used without retrieving it again.
+    QVERIFY(*checkMention(detector, QStringLiteral("participant-1"), QStringLiteral("Hi Alice")));
+}
+
+void GroupChatMentionDetectorTest::testOwnParticipantUpdated()
+{
+    GroupChatMentionDetector detector;
+
+    QVERIFY(isMentioned(detector, QStringLiteral("participant-1"), QStringLiteral("Hi Alice")));
+    QVERIFY(!isMentioned(detector, QStringLiteral("participant-1"), QStringLiteral("Hi Bob")));
+
+    QSignalSpy userUpdatedSpy(groupChatUserDb, &GroupChatUserDb::userUpdated);
+    wait(groupChatUserDb->handleParticipantReceived(ownParticipant(QStringLiteral("participant-1"), QStringLiteral("Bob"))));
+    QTRY_COMPARE(userUpdatedSpy.count(), 1);
+
+    // The new nickname is used without retrieving the participant again.
+    QVERIFY(*checkMention(detector, QStringLiteral("participant-1"), QStringLiteral("Hi Bob")));
+    QVERIFY(!isMentioned(detector, QStringLiteral("participant-1"), QStringLiteral("Hi Alice")));
+
+    wait(groupChatUserDb->handleParticipantReceived(ownParticipant(QStringLiteral("participant-1"), QStringLiteral("Alice"))));
+    QTRY_COMPARE(userUpdatedSpy.count(), 2);
+}
+
+void GroupChatMentionDetectorTest::testOwnParticipantChanged()
+{
+    GroupChatMentionDetector detector;
+
+    QVERIFY(isMentioned(detector, QStringLiteral("participant-1"), QStringLiteral("Hi Alice")));
+
+    // The own participant changes after joining the group chat again.
+    auto rejoinedParticipant = ownParticipant(QStringLiteral("participant-2"), QStringLiteral("Carol"));
+    rejoinedParticipant.jid = QStringLiteral("other-user@example.org");
+    wait(groupChatUserDb->handleParticipantReceived(rejoinedParticipant));
+
+    QVERIFY(isMentioned(detector, QStringLiteral("participant-2"), QStringLiteral("Hi Carol")));
+    QVERIFY(!isMentioned(detector, QStringLiteral("participant-2"), QStringLiteral("Hi Alice")));
+}
+
+void GroupChatMentionDetectorTest::testGroupChatRemoved()
+{
+    GroupChatMentionDetector detector;
+
+    QVERIFY(isMentioned(detector, QStringLiteral("participant-1"), QStringLiteral("Hi Alice")));
+
+    // The own participant is not kept after leaving the group chat.
+    QSignalSpy itemRemovedSpy(rosterDb, &RosterDb::itemRemoved);
+    wait(rosterDb->removeBookmarks(accountJid, {chatJid}));
+    QTRY_COMPARE(itemRemovedSpy.count(), 1);
+
+    QVERIFY(!isMentioned(detector, QStringLiteral("participant-1"), QStringLiteral("Hi Alice")));
+
+    // The own participant is not kept after removing the account.
+    wait(groupChatUserDb->handleParticipantReceived(ownParticipant(QStringLiteral("participant-1"), QStringLiteral("Alice"))));
+    QVERIFY(isMentioned(detector, QStringLiteral("participant-1"), QStringLiteral("Hi Alice")));
+
+    QSignalSpy itemsRemovedSpy(rosterDb, &RosterDb::itemsRemoved);
+    wait(rosterDb->removeItems(accountJid));
+    QTRY_COMPARE(itemsRemovedSpy.count(), 1);
+
+    QVERIFY(!isMentioned(detector, QStringLiteral("participant-1"), QStringLiteral("Hi Alice")));
+}
+
+std::shared_ptr<bool> GroupChatMentionDetectorTest::checkMention(GroupChatMentionDetector &detector, const QString &ownParticipantId, const QString &body)
+{
+    auto mentioned = std::make_shared<bool>(false);
+
+    detector.checkMention(accountJid, chatJid, ownParticipantId, body, [mentioned]() {
+        *mentioned = true;
+    });
+
+    return mentioned;
+}
+
+bool GroupChatMentionDetectorTest::isMentioned(GroupChatMentionDetector &detector, const QString &ownParticipantId, const QString &body)
+{
+    const auto mentioned = checkMention(detector, ownParticipantId, body);
+
+    // The database handles requests one after another.
+    // Thus, a possible retrieval of the own participant is handled once a subsequent request is
+    // finished.
+    wait(groupChatUserDb->user(accountJid, chatJid, ownParticipantId));
+
+    return *mentioned;
+}
+
+GroupChatUser GroupChatMentionDetectorTest::ownParticipant(const QString &id, const QString &name)
+{
+    GroupChatUser user;
+    user.accountJid = accountJid;
+    user.chatJid = chatJid;
+    user.id = id;
+    user.jid = accountJid;
+    user.name = name;
+    return user;
+}
+
+QTEST_GUILESS_MAIN(GroupChatMentionDetectorTest)
+#include "GroupChatMentionDetectorTest.moc"
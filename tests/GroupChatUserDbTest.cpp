@@ -0,0 +1,262 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Qt
+#include <QSignalSpy>
+#include <QTest>
+// Kaidan
+#include "Database.h"
+#include "Globals.h"
+#include "GroupChatUserDb.h"
+#include "RosterDb.h"
+#include "Test.h"
+#include "TestUtils.h"
+
+static const auto accountJid = QStringLiteral("user@example.org");
+static constexpr int participantCount = 5000;
+
+class GroupChatUserDbTest : public Test
+{
+    Q_OBJECT
+
+public:
+    GroupChatUserDbTest();
+
+private:
+    Q_SLOT void testUsersAllowedOrBanned();
+    Q_SLOT void testParticipantsReceived();
+    Q_SLOT void testUsersPaging();
+    Q_SLOT void testUsersSearch();
+    Q_SLOT void benchmarkParticipantsReceived();
+
+    static GroupChatUser user(const QString &chatJid, int number, GroupChatUser::Status status = GroupChatUser::Status::Joined);
+    QList<GroupChatUser> fetchAllUsers(const QString &chatJid, const QString &searchString = {});
+
+    Database db;
+    GroupChatUserDb *groupChatUserDb = nullptr;
+    RosterDb *rosterDb = nullptr;
+};
+
+GroupChatUserDbTest::GroupChatUserDbTest()
+{
+    groupChatUserDb = new GroupChatUserDb(this);
+    rosterDb = new RosterDb(this);
+}
+
+GroupChatUser GroupChatUserDbTest::user(const QString &chatJid, int number, GroupChatUser::Status status)
+{
+    GroupChatUser user;
+    user.accountJid = accountJid;
+    user.chatJid = chatJid;
+    user.id = QStringLiteral("participant-%1").arg(number);
+    user.jid = QStringLiteral("participant-%1@example.org").arg(number);
+    user.name = QStringLiteral("Participant %1").arg(number);
+    user.status = status;
+    return user;
+}
+
+QList<GroupChatUser> GroupChatUserDbTest::fetchAllUsers(const QString &chatJid, const QString &searchString)
+{
+    QList<GroupChatUser> users;
+
+    while (true) {
+        const auto lastUser = users.isEmpty() ? std::nullopt : std::optional(users.constLast());
+        const auto page = wait(groupChatUserDb->users(accountJid, chatJid, lastUser, searchString));
+        users.append(page);
+
+        if (page.size() < DB_QUERY_LIMIT_GROUP_CHAT_USERS) {
+            break;
+        }
+    }
+
+    return users;
+}
+
+void GroupChatUserDbTest::testUsersAllowedOrBanned()
+{
+    const auto chatJid = QStringLiteral("allowed@groups.example.org");
+
+    auto allowedUser = user(chatJid, 1, GroupChatUser::Status::Allowed);
+    allowedUser.id = QStringLiteral("");
+    auto bannedUser = user(chatJid, 2, GroupChatUser::Status::Banned);
+    bannedUser.id = QStringLiteral("");
+
+    QSignalSpy usersChangedSpy(groupChatUserDb, &GroupChatUserDb::usersChanged);
+    QSignalSpy userJidsChangedSpy(groupChatUserDb, &GroupChatUserDb::userJidsChanged);
+
+    wait(groupChatUserDb->handleUsersAllowedOrBanned({allowedUser, bannedUser}));
+
+    QCOMPARE(usersChangedSpy.count(), 1);
+    QCOMPARE(usersChangedSpy.constFirst().at(0).value<QList<GroupChatUser>>().size(), 2);
+    QCOMPARE(userJidsChangedSpy.count(), 1);
+
+    // Banning an allowed user updates the stored entry.
+    allowedUser.status = GroupChatUser::Status::Banned;
+    wait(groupChatUserDb->handleUsersAllowedOrBanned({allowedUser, bannedUser}));
+
+    QCOMPARE(usersChangedSpy.count(), 2);
+    QVERIFY(usersChangedSpy.at(1).at(0).value<QList<GroupChatUser>>().isEmpty());
+    QCOMPARE(usersChangedSpy.at(1).at(1).value<QList<GroupChatUser>>().size(), 1);
+
+    const auto users = fetchAllUsers(chatJid);
+    QCOMPARE(users.size(), 2);
+    QVERIFY(std::ranges::all_of(users, [](const GroupChatUser &user) {
+        return user.status == GroupChatUser::Status::Banned;
+    }));
+
+    // Unchanged users result in no signal.
+    wait(groupChatUserDb->handleUsersAllowedOrBanned({allowedUser, bannedUser}));
+    QCOMPARE(usersChangedSpy.count(), 2);
+}
+
+void GroupChatUserDbTest::testParticipantsReceived()
+{
+    const auto chatJid = QStringLiteral("participants@groups.example.org");
+
+    // An allowed user becomes a joined participant.
+    auto allowedUser = user(chatJid, 1, GroupChatUser::Status::Allowed);
+    allowedUser.id = QStringLiteral("");
+    wait(groupChatUserDb->handleUsersAllowedOrBanned({allowedUser}));
+
+    // An anonymous participant without a JID is updated by its ID.
+    auto anonymousParticipant = user(chatJid, 2);
+    anonymousParticipant.jid.clear();
+    wait(groupChatUserDb->handleParticipantsReceived({anonymousParticipant}));
+
+    QSignalSpy usersChangedSpy(groupChatUserDb, &GroupChatUserDb::usersChanged);
+
+    anonymousParticipant.name = QStringLiteral("Renamed");
+    wait(groupChatUserDb->handleParticipantsReceived({user(chatJid, 1), anonymousParticipant, user(chatJid, 3)}));
+
+    QCOMPARE(usersChangedSpy.count(), 1);
+    QCOMPARE(usersChangedSpy.constFirst().at(0).value<QList<GroupChatUser>>().size(), 1);
+    QCOMPARE(usersChangedSpy.constFirst().at(1).value<QList<GroupChatUser>>().size(), 2);
+
+    const auto users = fetchAllUsers(chatJid);
+    QCOMPARE(users.size(), 3);
+
+    const auto formerlyAllowedUser = wait(groupChatUserDb->user(accountJid, chatJid, user(chatJid, 1).id));
+    QVERIFY(formerlyAllowedUser);
+    QCOMPARE(formerlyAllowedUser->jid, allowedUser.jid);
+    QCOMPARE(formerlyAllowedUser->status, GroupChatUser::Status::Joined);
+
+    const auto renamedParticipant = wait(groupChatUserDb->user(accountJid, chatJid, anonymousParticipant.id));
+    QVERIFY(renamedParticipant);
+    QCOMPARE(renamedParticipant->name, QStringLiteral("Renamed"));
+}
+
+void GroupChatUserDbTest::testUsersPaging()
+{
+    const auto chatJid = QStringLiteral("paging@groups.example.org");
+    const auto userCount = DB_QUERY_LIMIT_GROUP_CHAT_USERS * 2 + 1;
+
+    QList<GroupChatUser> participants;
+
+    for (int i = 0; i < userCount; ++i) {
+        participants.append(user(chatJid, i, i % 3 ? GroupChatUser::Status::Joined : GroupChatUser::Status::Left));
+    }
+
+    wait(groupChatUserDb->handleParticipantsReceived(participants));
+
+    const auto firstPage = wait(groupChatUserDb->users(accountJid, chatJid));
+    QCOMPARE(firstPage.size(), DB_QUERY_LIMIT_GROUP_CHAT_USERS);
+
+    // Users added before the current page do not shift the following pages.
+    auto addedUser = user(chatJid, userCount, GroupChatUser::Status::Allowed);
+    addedUser.id = QStringLiteral("");
+    wait(groupChatUserDb->handleUsersAllowedOrBanned({addedUser}));
+
+    const auto secondPage = wait(groupChatUserDb->users(accountJid, chatJid, firstPage.constLast()));
+    QCOMPARE(secondPage.size(), DB_QUERY_LIMIT_GROUP_CHAT_USERS);
+    QVERIFY(!firstPage.contains(secondPage.constFirst()));
+
+    const auto users = fetchAllUsers(chatJid);
+    QCOMPARE(users.size(), userCount + 1);
+
+    // The users are ordered by their status and names.
+    QCOMPARE(users.constFirst().jid, addedUser.jid);
+
+    for (int i = 1; i < users.size(); ++i) {
+        const auto &previousUser = users.at(i - 1);
+        const auto &currentUser = users.at(i);
+        QVERIFY(previousUser.status < currentUser.status || (previousUser.status == currentUser.status && previousUser.name < currentUser.name));
+    }
+}
+
+void GroupChatUserDbTest::testUsersSearch()
+{
+    const auto chatJid = QStringLiteral("search@groups.example.org");
+
+    auto alice = user(chatJid, 1);
+    alice.name = QStringLiteral("Alice");
+    auto bob = user(chatJid, 2);
+    bob.name = QStringLiteral("Bob");
+    bob.jid = QStringLiteral("alice-fan@example.org");
+    auto percentUser = user(chatJid, 3);
+    percentUser.name = QStringLiteral("100% Carol");
+    auto contact = user(chatJid, 4);
+
+    wait(groupChatUserDb->handleParticipantsReceived({alice, bob, percentUser, contact}));
+
+    RosterItem rosterItem;
+    rosterItem.accountJid = accountJid;
+    rosterItem.jid = contact.jid;
+    rosterItem.name = QStringLiteral("Dorothy");
+    wait(this, rosterDb->updateOrAddItem(accountJid, {}, rosterItem));
+
+    // Names and JIDs are searched case-insensitively for any of their parts.
+    auto users = fetchAllUsers(chatJid, QStringLiteral("LIC"));
+    QCOMPARE(users.size(), 2);
+    QCOMPARE(users.at(0).name, alice.name);
+    QCOMPARE(users.at(1).name, bob.name);
+
+    users = fetchAllUsers(chatJid, QStringLiteral("ice"));
+    QCOMPARE(users.size(), 2);
+
+    // The names of the users' roster items are searched as well.
+    users = fetchAllUsers(chatJid, QStringLiteral("thy"));
+    QCOMPARE(users.size(), 1);
+    QCOMPARE(users.constFirst().jid, contact.jid);
+
+    // Wildcards are matched literally.
+    users = fetchAllUsers(chatJid, QStringLiteral("0% c"));
+    QCOMPARE(users.size(), 1);
+    QCOMPARE(users.constFirst().name, percentUser.name);
+
+    QVERIFY(fetchAllUsers(chatJid, QStringLiteral("%o")).isEmpty());
+    QVERIFY(fetchAllUsers(chatJid, QStringLiteral("_ob")).isEmpty());
+}
+
+void GroupChatUserDbTest::benchmarkParticipantsReceived()
+{
+    const auto chatJid = QStringLiteral("large@groups.example.org");
+
+    QList<GroupChatUser> participants;
+    participants.reserve(participantCount);
+
+    for (int i = 0; i < participantCount; ++i) {
+        participants.append(user(chatJid, i));
+    }
+
+    QSignalSpy usersChangedSpy(groupChatUserDb, &GroupChatUserDb::usersChanged);
+
+    QBENCHMARK_ONCE {
+        // Joining the channel adds all participants and a subsequent request updates some.
+        wait(groupChatUserDb->handleParticipantsReceived(participants));
+
+        for (int i = 0; i < participantCount; i += 10) {
+            participants[i].name = participants.at(i).name + QStringLiteral(" (renamed)");
+        }
+
+        wait(groupChatUserDb->handleParticipantsReceived(participants));
+    }
+
+    QCOMPARE(usersChangedSpy.count(), 2);
+    QCOMPARE(usersChangedSpy.at(0).at(0).value<QList<GroupChatUser>>().size(), participantCount);
+    QCOMPARE(usersChangedSpy.at(1).at(1).value<QList<GroupChatUser>>().size(), participantCount / 10);
+    QCOMPARE(fetchAllUsers(chatJid).size(), participantCount);
+}
+
+QTEST_GUILESS_MAIN(GroupChatUserDbTest)
+#include "GroupChatUserDbTest.moc"
@@ -0,0 +1,257 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Qt
+#include <QSignalSpy>
+#include <QTest>
+// Kaidan
+#include "GroupChatUserDb.h"
+#include "GroupChatUserModel.h"
+#include "RosterDb.h"
+#include "RosterModel.h"
+#include "Test.h"
+
+static const auto accountJid = QStringLiteral("user@example.org");
+static const auto chatJid = QStringLiteral("group@groups.example.org");
+static const auto ownParticipantId = QStringLiteral("own");
+static constexpr int participantCount = 10000;
+
+class GroupChatUserModelTest : public Test
+{
+    Q_OBJECT
+
+private:
+    Q_SLOT void initTestCase() override;
+
+    Q_SLOT void testAddUsers();
+    Q_SLOT void testUpdateUser();
+    Q_SLOT void testRemoveUser();
+    Q_SLOT void testCoalescedUserJidsChanged();
+    Q_SLOT void testRosterItemRenamed();
+    Q_SLOT void benchmarkAddUsers();
+
+    static GroupChatUser participant(int number, GroupChatUser::Status status = GroupChatUser::Status::Joined);
+    static void verifySorted(const GroupChatUserModel &model);
+    static void prepareModel(GroupChatUserModel &model);
+};
+
+void GroupChatUserModelTest::initTestCase()
+{
+    Test::initTestCase();
+
+    // The model requires a RosterModel instance and a roster item for the group chat.
+    addAccount(accountJid);
+
+    RosterItem item;
+    item.accountJid = accountJid;
+    item.jid = chatJid;
+    item.groupChatParticipantId = ownParticipantId;
+    addRosterItem(item);
+
+    QVERIFY(RosterModel::instance()->item(accountJid, chatJid));
+}
+
+GroupChatUser GroupChatUserModelTest::participant(int number, GroupChatUser::Status status)
+{
+    GroupChatUser user;
+    user.accountJid = accountJid;
+    user.chatJid = chatJid;
+    user.id = QStringLiteral("participant-%1").arg(number);
+    user.jid = QStringLiteral("participant-%1@example.org").arg(number);
+    user.name = QStringLiteral("Participant %1").arg(number, 5, 10, QLatin1Char('0'));
+    user.status = status;
+    return user;
+}
+
+void GroupChatUserModelTest::verifySorted(const GroupChatUserModel &model)
+{
+    for (int i = 1; i < model.rowCount(); ++i) {
+        const auto previousIndex = model.index(i - 1);
+        const auto currentIndex = model.index(i);
+
+        const auto previousStatus = model.data(previousIndex, GroupChatUserModel::Role::Status).value<GroupChatUser::Status>();
+        const auto currentStatus = model.data(currentIndex, GroupChatUserModel::Role::Status).value<GroupChatUser::Status>();
+
+        QVERIFY(previousStatus <= currentStatus);
+
+        if (previousStatus == currentStatus) {
+            QVERIFY(model.data(previousIndex, GroupChatUserModel::Role::Name).toString()
+                    <= model.data(currentIndex, GroupChatUserModel::Role::Name).toString());
+        }
+    }
+}
+
+void GroupChatUserModelTest::prepareModel(GroupChatUserModel &model)
+{
+    model.setAccountJid(accountJid);
+    model.setChatJid(chatJid);
+}
+
+void GroupChatUserModelTest::testAddUsers()
+{
+    GroupChatUserModel model;
+    prepareModel(model);
+
+    for (const auto number : {3, 1, 2}) {
+        Q_EMIT GroupChatUserDb::instance()->userAdded(participant(number));
+    }
+
+    // Duplicates, the own user and users of other group chats are not added.
+    Q_EMIT GroupChatUserDb::instance()->userAdded(participant(2));
+
+    auto ownUser = participant(4);
+    ownUser.id = ownParticipantId;
+    Q_EMIT GroupChatUserDb::instance()->userAdded(ownUser);
+
+    auto otherGroupChatUser = participant(5);
+    otherGroupChatUser.chatJid = QStringLiteral("other@groups.example.org");
+    Q_EMIT GroupChatUserDb::instance()->userAdded(otherGroupChatUser);
+
+    QCOMPARE(model.rowCount(), 3);
+    QCOMPARE(model.data(model.index(0), GroupChatUserModel::Role::Jid).toString(), participant(1).jid);
+    QCOMPARE(model.data(model.index(2), GroupChatUserModel::Role::Jid).toString(), participant(3).jid);
+
+    QCOMPARE(model.participantName(accountJid, chatJid, participant(2).id), participant(2).name);
+    QVERIFY(model.participantName(accountJid, chatJid, otherGroupChatUser.id).isEmpty());
+}
+
+void GroupChatUserModelTest::testUpdateUser()
+{
+    GroupChatUserModel model;
+    prepareModel(model);
+
+    for (int i = 0; i < 10; ++i) {
+        Q_EMIT GroupChatUserDb::instance()->userAdded(participant(i));
+    }
+
+    // Moving the first user to the end by renaming it.
+    auto renamedUser = participant(0);
+    renamedUser.name = QStringLiteral("Zed");
+    Q_EMIT GroupChatUserDb::instance()->userUpdated(renamedUser);
+
+    QCOMPARE(model.rowCount(), 10);
+    QCOMPARE(model.data(model.index(9), GroupChatUserModel::Role::Name).toString(), QStringLiteral("Zed"));
+    verifySorted(model);
+
+    // Moving a user to the front by changing its status.
+    Q_EMIT GroupChatUserDb::instance()->userUpdated(participant(5, GroupChatUser::Status::Allowed));
+
+    QCOMPARE(model.data(model.index(0), GroupChatUserModel::Role::Jid).toString(), participant(5).jid);
+    verifySorted(model);
+
+    // Updating a user whose JID was known before its ID.
+    auto allowedUser = participant(10, GroupChatUser::Status::Allowed);
+    allowedUser.id.clear();
+    Q_EMIT GroupChatUserDb::instance()->userAdded(allowedUser);
+    Q_EMIT GroupChatUserDb::instance()->userUpdated(participant(10));
+
+    QCOMPARE(model.rowCount(), 11);
+    QCOMPARE(model.participant(accountJid, chatJid, participant(10).id)->status, GroupChatUser::Status::Joined);
+    verifySorted(model);
+}
+
+void GroupChatUserModelTest::testRemoveUser()
+{
+    GroupChatUserModel model;
+    prepareModel(model);
+
+    for (int i = 0; i < 10; ++i) {
+        Q_EMIT GroupChatUserDb::instance()->userAdded(participant(i));
+    }
+
+    Q_EMIT GroupChatUserDb::instance()->userRemoved(participant(4));
+
+    QCOMPARE(model.rowCount(), 9);
+    QVERIFY(!model.participant(accountJid, chatJid, participant(4).id));
+    QVERIFY(!model.userJids().contains(participant(4).jid));
+    verifySorted(model);
+}
+
+void GroupChatUserModelTest::testCoalescedUserJidsChanged()
+{
+    GroupChatUserModel model;
+    prepareModel(model);
+
+    QSignalSpy userJidsChangedSpy(&model, &GroupChatUserModel::userJidsChanged);
+
+    for (int i = 0; i < 100; ++i) {
+        Q_EMIT GroupChatUserDb::instance()->userAdded(participant(i));
+    }
+
+    Q_EMIT GroupChatUserDb::instance()->userRemoved(participant(0));
+
+    QCOMPARE(userJidsChangedSpy.count(), 0);
+    QVERIFY(userJidsChangedSpy.wait());
+    QCOMPARE(userJidsChangedSpy.count(), 1);
+    QCOMPARE(model.userJids().size(), 99);
+}
+
+void GroupChatUserModelTest::testRosterItemRenamed()
+{
+    GroupChatUserModel model;
+    prepareModel(model);
+
+    for (int i = 0; i < 10; ++i) {
+        Q_EMIT GroupChatUserDb::instance()->userAdded(participant(i));
+    }
+
+    // The name of a user's roster item is used as soon as the user is added to the roster.
+    RosterItem item;
+    item.accountJid = accountJid;
+    item.jid = participant(0).jid;
+    item.name = QStringLiteral("Zed");
+    addRosterItem(item);
+
+    QCOMPARE(model.data(model.index(9), GroupChatUserModel::Role::Name).toString(), QStringLiteral("Zed"));
+    QCOMPARE(model.participantName(accountJid, chatJid, participant(0).id), QStringLiteral("Zed"));
+    verifySorted(model);
+
+    // Renaming the roster item moves the user.
+    item.name = QStringLiteral("Adam");
+    Q_EMIT RosterDb::instance()->itemUpdated(item);
+
+    QCOMPARE(model.data(model.index(0), GroupChatUserModel::Role::Name).toString(), QStringLiteral("Adam"));
+    verifySorted(model);
+
+    // The user's own name is used again once the user is removed from the roster.
+    Q_EMIT RosterDb::instance()->itemRemoved(accountJid, item.jid);
+
+    QCOMPARE(model.data(model.index(0), GroupChatUserModel::Role::Name).toString(), participant(0).name);
+    QCOMPARE(model.rowCount(), 10);
+    verifySorted(model);
+}
+
+void GroupChatUserModelTest::benchmarkAddUsers()
+{
+    QList<GroupChatUser> users;
+    users.reserve(participantCount);
+
+    // Add the users in an order differing from the sorted one.
+    for (int i = 0; i < participantCount; ++i) {
+        users.append(participant((i * 7919) % participantCount));
+    }
+
+    GroupChatUserModel model;
+    prepareModel(model);
+
+    QBENCHMARK_ONCE {
+        for (const auto &user : std::as_const(users)) {
+            Q_EMIT GroupChatUserDb::instance()->userAdded(user);
+        }
+
+        for (int i = 0; i < participantCount; i += 10) {
+            Q_EMIT GroupChatUserDb::instance()->userUpdated(participant(i, GroupChatUser::Status::Left));
+        }
+
+        for (int i = 0; i < participantCount; ++i) {
+            QCOMPARE(model.participantName(accountJid, chatJid, participant(i).id), participant(i).name);
+        }
+    }
+
+    QCOMPARE(model.rowCount(), participantCount);
+    verifySorted(model);
+}
+
+QTEST_GUILESS_MAIN(GroupChatUserModelTest)
+#include "GroupChatUserModelTest.moc"
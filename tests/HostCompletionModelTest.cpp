@@ -0,0 +1,132 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// std
+#include <numeric>
+// Qt
+#include <QSignalSpy>
+#include <QTest>
+// Kaidan
+#include "HostCompletionModel.h"
+#include "RosterDb.h"
+#include "RosterModel.h"
+#include "Test.h"
+
+static const auto accountJid = QStringLiteral("user@example.org");
+static constexpr int contactCount = 10000;
+static constexpr int chunkSize = 100;
+static constexpr int hostCount = 500;
+
+class HostCompletionModelTest : public Test
+{
+    Q_OBJECT
+
+private:
+    Q_SLOT void initTestCase() override;
+    Q_SLOT void testAggregate();
+    Q_SLOT void benchmarkRosterLoading();
+
+    static QString contactJid(int number);
+};
+
+void HostCompletionModelTest::initTestCase()
+{
+    Test::initTestCase();
+    Q_INIT_RESOURCE(data);
+
+    addAccount(accountJid);
+}
+
+void HostCompletionModelTest::testAggregate()
+{
+    HostCompletionModel model;
+
+    model.aggregate({QStringLiteral("alice@Example.org"), QStringLiteral("example.org"), QStringLiteral("bob@example.com")});
+    QCOMPARE(model.rowCount(), 2);
+    QCOMPARE(model.data(model.index(0)).toString(), QStringLiteral("example.org"));
+    QCOMPARE(model.data(model.index(1)).toString(), QStringLiteral("example.com"));
+
+    // Known hosts are not added again.
+    QSignalSpy rowsInsertedSpy(&model, &HostCompletionModel::rowsInserted);
+    model.aggregate({QStringLiteral("carol@example.com")});
+    QCOMPARE(model.rowCount(), 2);
+    QCOMPARE(rowsInsertedSpy.count(), 0);
+
+    // Hosts can be added again after clearing the model.
+    model.clear();
+    model.aggregate({QStringLiteral("carol@example.com")});
+    QCOMPARE(model.rowCount(), 1);
+
+    // The providers of the completion list are added once.
+    model.clear();
+    model.aggregateKnownProviders();
+    const auto knownProviderCount = model.rowCount();
+    QVERIFY(knownProviderCount > 0);
+
+    model.aggregateKnownProviders();
+    QCOMPARE(model.rowCount(), knownProviderCount);
+}
+
+void HostCompletionModelTest::benchmarkRosterLoading()
+{
+    HostCompletionModel model;
+    model.setRosterModel(RosterModel::instance());
+
+    // The host completion model aggregates the whole roster after each reset and only the
+    // inserted rows otherwise.
+    QSignalSpy rosterResetSpy(RosterModel::instance(), &RosterModel::modelReset);
+    QSignalSpy rosterRowsInsertedSpy(RosterModel::instance(), &RosterModel::rowsInserted);
+
+    QBENCHMARK_ONCE {
+        // The roster is received in chunks, each being added to the roster model.
+        for (int i = 0; i < contactCount; i += chunkSize) {
+            QList<RosterItem> items;
+            items.reserve(chunkSize);
+
+            for (int j = i; j < i + chunkSize; ++j) {
+                RosterItem item;
+                item.accountJid = accountJid;
+                item.jid = contactJid(j);
+                items.append(item);
+            }
+
+            Q_EMIT RosterDb::instance()->itemsChanged(accountJid, items, {}, {});
+        }
+    }
+
+    QCOMPARE(RosterModel::instance()->rowCount(), contactCount);
+    QCOMPARE(model.rowCount(), hostCount);
+
+    // No full aggregation ran and each contact was aggregated once.
+    QCOMPARE(rosterResetSpy.count(), 0);
+    QCOMPARE(std::accumulate(rosterRowsInsertedSpy.cbegin(),
+                             rosterRowsInsertedSpy.cend(),
+                             0,
+                             [](int count, const QList<QVariant> &arguments) {
+                                 return count + arguments.at(2).toInt() - arguments.at(1).toInt() + 1;
+                             }),
+             contactCount);
+
+    QSet<QString> hosts;
+
+    for (int i = 0; i < model.rowCount(); ++i) {
+        hosts.insert(model.data(model.index(i)).toString());
+    }
+
+    QCOMPARE(hosts.size(), hostCount);
+
+    // A single contact added later only adds its own host.
+    addRosterItem(accountJid, QStringLiteral("contact@new.example.org"));
+
+    QCOMPARE(model.rowCount(), hostCount + 1);
+    QCOMPARE(model.data(model.index(hostCount)).toString(), QStringLiteral("new.example.org"));
+}
+
+QString HostCompletionModelTest::contactJid(int number)
+{
+    return QStringLiteral("contact-%1@host-%2.example.org").arg(number).arg(number % hostCount);
+}
+
+QTEST_GUILESS_MAIN(HostCompletionModelTest)
+#include "HostCompletionModelTest.moc"
@@ -0,0 +1,208 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Qt
+#include <QSignalSpy>
+#include <QTest>
+// Kaidan
+#include "Algorithms.h"
+#include "Database.h"
+#include "GroupChatUserDb.h"
+#include "MessageDb.h"
+#include "Test.h"
+#include "TestUtils.h"
+
+static const auto accountJid = QStringLiteral("user@example.org");
+static const auto chatJid = QStringLiteral("alice@example.org");
+
+class MessageDbTest : public Test
+{
+    Q_OBJECT
+
+public:
+    MessageDbTest();
+
+private:
+    Q_SLOT void testUpdateFiles();
+    Q_SLOT void testUpdateFilesResetsError();
+    Q_SLOT void testUpdateFilesBatch();
+    Q_SLOT void testUpdateReactions();
+
+    Message addFileMessage(const QString &messageId, int fileCount, const QString &errorText = {});
+    Message fetchMessage(const QString &messageId);
+
+    Database db;
+    MessageDb *messageDb = nullptr;
+    GroupChatUserDb *groupChatUserDb = nullptr;
+};
+
+MessageDbTest::MessageDbTest()
+{
+    messageDb = new MessageDb(this);
+    groupChatUserDb = new GroupChatUserDb(this);
+}
+
+Message MessageDbTest::addFileMessage(const QString &messageId, int fileCount, const QString &errorText)
+{
+    Message message;
+    message.accountJid = accountJid;
+    message.chatJid = chatJid;
+    message.isOwn = false;
+    message.id = messageId;
+    message.timestamp = QDateTime::currentDateTimeUtc();
+    message.fileGroupId = messageDb->newFileGroupId();
+    message.errorText = errorText;
+
+    for (int i = 0; i < fileCount; ++i) {
+        File file;
+        file.id = messageDb->newFileId();
+        file.fileGroupId = *message.fileGroupId;
+        file.externalId = QString::number(file.id);
+        message.files.append(file);
+    }
+
+    wait(messageDb->addMessage(message, MessageOrigin::Stream));
+
+    return message;
+}
+
+Message MessageDbTest::fetchMessage(const QString &messageId)
+{
+    const auto message = wait(messageDb->fetchMessage(accountJid, chatJid, messageId));
+    Q_ASSERT(message);
+    return *message;
+}
+
+void MessageDbTest::testUpdateFiles()
+{
+    const auto message = addFileMessage(QStringLiteral("update-files"), 2);
+    const auto fileId = message.files.constFirst().id;
+
+    QSignalSpy messageUpdatedSpy(messageDb, &MessageDb::messageUpdated);
+    QSignalSpy filesUpdatedSpy(messageDb, &MessageDb::filesUpdated);
+
+    wait(messageDb->updateFiles({{fileId, File::TransferState::Transferring}}));
+
+    QCOMPARE(fetchMessage(message.id).files.constFirst().transferState, File::TransferState::Transferring);
+
+    wait(messageDb->updateFiles({{fileId, File::TransferState::Done, QStringLiteral("/tmp/file.png")}}));
+
+    const auto files = fetchMessage(message.id).files;
+    QCOMPARE(files.at(0).transferState, File::TransferState::Done);
+    QCOMPARE(files.at(0).localFilePath, QStringLiteral("/tmp/file.png"));
+    // Other files of the message are not touched.
+    QCOMPARE(files.at(1).transferState, File::TransferState::Pending);
+    QVERIFY(files.at(1).localFilePath.isEmpty());
+
+    // Only the narrow signal is emitted.
+    QCOMPARE(messageUpdatedSpy.count(), 0);
+    QCOMPARE(filesUpdatedSpy.count(), 2);
+
+    const auto updates = filesUpdatedSpy.at(1).at(0).value<QList<MessageDb::FileUpdate>>();
+    QCOMPARE(updates.size(), 1);
+    QCOMPARE(updates.constFirst().fileId, fileId);
+    QCOMPARE(updates.constFirst().localFilePath, std::optional(QStringLiteral("/tmp/file.png")));
+}
+
+void MessageDbTest::testUpdateFilesResetsError()
+{
+    const auto message = addFileMessage(QStringLiteral("update-files-error"), 2, QStringLiteral("Transfer failed"));
+    const auto firstFileId = message.files.at(0).id;
+    const auto secondFileId = message.files.at(1).id;
+
+    // The error is kept as long as not all files are transferred.
+    wait(messageDb->updateFiles({{firstFileId, File::TransferState::Done}}));
+    QCOMPARE(fetchMessage(message.id).errorText, QStringLiteral("Transfer failed"));
+
+    wait(messageDb->updateFiles({{secondFileId, File::TransferState::Done}}));
+    QVERIFY(fetchMessage(message.id).errorText.isEmpty());
+}
+
+void MessageDbTest::testUpdateFilesBatch()
+{
+    constexpr int messageCount = 50;
+
+    QList<Message> messages;
+    QList<MessageDb::FileUpdate> updates;
+
+    for (int i = 0; i < messageCount; ++i) {
+        const auto message = addFileMessage(QStringLiteral("update-files-batch-%1").arg(i), 1);
+        messages.append(message);
+        updates.append({message.files.constFirst().id, File::TransferState::Done});
+    }
+
+    QSignalSpy filesUpdatedSpy(messageDb, &MessageDb::filesUpdated);
+
+    wait(messageDb->updateFiles(updates));
+
+    QCOMPARE(filesUpdatedSpy.count(), 1);
+    QCOMPARE(filesUpdatedSpy.constFirst().constFirst().value<QList<MessageDb::FileUpdate>>().size(), messageCount);
+
+    for (const auto &message : std::as_const(messages)) {
+        QCOMPARE(fetchMessage(message.id).files.constFirst().transferState, File::TransferState::Done);
+    }
+}
+
+void MessageDbTest::testUpdateReactions()
+{
+    const auto message = addFileMessage(QStringLiteral("update-reactions"), 0);
+    const auto senderJid = QStringLiteral("bob@example.org");
+    const auto timestamp = QDateTime::currentDateTimeUtc();
+    const auto thumbsUp = QStringLiteral("👍");
+    const auto heart = QStringLiteral("❤️");
+    const auto party = QStringLiteral("🎉");
+
+    const auto emojis = [](const QList<MessageReaction> &reactions) {
+        return transform(reactions, [](const MessageReaction &reaction) {
+            return reaction.emoji;
+        });
+    };
+
+    QSignalSpy messageUpdatedSpy(messageDb, &MessageDb::messageUpdated);
+    QSignalSpy reactionsChangedSpy(messageDb, &MessageDb::reactionsChanged);
+
+    wait(messageDb->updateReactions(accountJid, chatJid, message.id, senderJid, {thumbsUp, heart}, timestamp));
+
+    QCOMPARE(emojis(fetchMessage(message.id).reactionSenders.value(senderJid).reactions), (QList<QString>{thumbsUp, heart}));
+    QCOMPARE(reactionsChangedSpy.count(), 1);
+
+    // Older reactions are ignored.
+    wait(messageDb->updateReactions(accountJid, chatJid, message.id, senderJid, {thumbsUp}, timestamp.addSecs(-1)));
+
+    QCOMPARE(emojis(fetchMessage(message.id).reactionSenders.value(senderJid).reactions), (QList<QString>{thumbsUp, heart}));
+    QCOMPARE(reactionsChangedSpy.count(), 1);
+
+    // Newer reactions replace the stored ones.
+    wait(messageDb->updateReactions(accountJid, chatJid, message.id, senderJid, {party, thumbsUp}, timestamp.addSecs(1)));
+
+    QCOMPARE(emojis(fetchMessage(message.id).reactionSenders.value(senderJid).reactions), (QList<QString>{thumbsUp, party}));
+    QCOMPARE(reactionsChangedSpy.count(), 2);
+
+    const auto arguments = reactionsChangedSpy.at(1);
+    QCOMPARE(arguments.at(2).toString(), message.referenceId());
+    QCOMPARE(arguments.at(3).toString(), senderJid);
+    QCOMPARE(emojis(arguments.at(4).value<MessageReactionSender>().reactions), (QList<QString>{thumbsUp, party}));
+
+    // The reactions of other senders are not affected.
+    wait(messageDb->updateReactions(accountJid, chatJid, message.id, accountJid, {heart}, timestamp));
+
+    auto reactionSenders = fetchMessage(message.id).reactionSenders;
+    QCOMPARE(emojis(reactionSenders.value(accountJid).reactions), (QList<QString>{heart}));
+    QCOMPARE(emojis(reactionSenders.value(senderJid).reactions), (QList<QString>{thumbsUp, party}));
+
+    // Removing all reactions removes the sender.
+    wait(messageDb->updateReactions(accountJid, chatJid, message.id, senderJid, {}, timestamp.addSecs(2)));
+
+    reactionSenders = fetchMessage(message.id).reactionSenders;
+    QVERIFY(!reactionSenders.contains(senderJid));
+    QVERIFY(reactionSenders.contains(accountJid));
+    QCOMPARE(reactionsChangedSpy.count(), 4);
+    QVERIFY(reactionsChangedSpy.constLast().at(4).value<MessageReactionSender>().reactions.isEmpty());
+
+    // Only the narrow signal is emitted.
+    QCOMPARE(messageUpdatedSpy.count(), 0);
+}
+
+QTEST_GUILESS_MAIN(MessageDbTest)
+#include "MessageDbTest.moc"
@@ -0,0 +1,186 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// std
+#include <numeric>
+// Qt
+#include <QTest>
+// Kaidan
+#include "MessageNotificationBatcher.h"
+#include "Test.h"
+
+using namespace std::chrono_literals;
+
+using Update = MessageNotificationBatcher::Update;
+
+static constexpr int messageCount = 500;
+static constexpr int intervalCount = 5;
+
+// Interval not ending during a test so that it can be ended explicitly
+static constexpr auto flushInterval = 1h;
+
+/**
+ * Notification backend counting the updates of each chat's notification.
+ */
+struct NotificationBackendStub {
+    MessageNotificationBatcher::Flush updater()
+    {
+        return [this](const Update &update) {
+            updateCounts[update.chatJid]++;
+            latestUpdates.insert(update.chatJid, update);
+        };
+    }
+
+    int updateCount() const
+    {
+        return std::accumulate(updateCounts.cbegin(), updateCounts.cend(), 0);
+    }
+
+    QHash<QString, int> updateCounts;
+    QHash<QString, Update> latestUpdates;
+};
+
+class MessageNotificationBatcherTest : public Test
+{
+    Q_OBJECT
+
+private:
+    Q_SLOT void testCatchUpBurst();
+    Q_SLOT void testFlushInterval();
+    Q_SLOT void testTextLines();
+    Q_SLOT void testRemoveChat();
+
+    static QString chatJid(int number);
+    static QString messageId(int number);
+};
+
+void MessageNotificationBatcherTest::testCatchUpBurst()
+{
+    NotificationBackendStub backend;
+    MessageNotificationBatcher batcher(backend.updater(), flushInterval);
+
+    // Messages of a MAM catch-up arrive back to back.
+    for (int i = 0; i < messageCount; ++i) {
+        batcher.addMessage(chatJid(i % 2), messageId(i), QStringLiteral("Message %1").arg(i));
+    }
+
+    // Nothing is updated before the event loop is entered.
+    QCOMPARE(backend.updateCount(), 0);
+    QCOMPARE(batcher.pendingChatCount(), 2);
+
+    QTRY_COMPARE(backend.updateCount(), 2);
+    QCOMPARE(batcher.pendingChatCount(), 0);
+
+    const auto update = backend.latestUpdates.value(chatJid(1));
+    QCOMPARE(update.latestMessageId, messageId(messageCount - 1));
+    QVERIFY(update.text.endsWith(QStringLiteral("Message %1").arg(messageCount - 1)));
+
+    // No further updates are flushed without new messages.
+    batcher.endInterval();
+    QCoreApplication::processEvents();
+    QCOMPARE(backend.updateCount(), 2);
+}
+
+void MessageNotificationBatcherTest::testFlushInterval()
+{
+    NotificationBackendStub backend;
+    MessageNotificationBatcher batcher(backend.updater(), flushInterval);
+
+    constexpr int intervalMessageCount = messageCount / intervalCount;
+
+    for (int interval = 0; interval < intervalCount; ++interval) {
+        // Messages arrive in quick succession during the interval.
+        for (int i = 0; i < intervalMessageCount; ++i) {
+            const auto messageNumber = interval * intervalMessageCount + i;
+            batcher.addMessage(chatJid(1), messageId(messageNumber), QStringLiteral("Message %1").arg(messageNumber));
+            QCoreApplication::processEvents();
+        }
+
+        // The messages received during an interval are not flushed before it has ended.
+        QCOMPARE(backend.updateCount(), interval + 1);
+        QCOMPARE(batcher.pendingChatCount(), 1);
+
+        // They are flushed together once it has ended.
+        batcher.endInterval();
+        QCOMPARE(backend.updateCount(), interval + 2);
+        QCOMPARE(backend.latestUpdates.value(chatJid(1)).latestMessageId, messageId((interval + 1) * intervalMessageCount - 1));
+    }
+
+    // An interval without new messages ends without an update.
+    batcher.endInterval();
+    QCOMPARE(backend.updateCount(), intervalCount + 1);
+
+    // Afterwards, a new message is flushed once the event loop is entered again.
+    batcher.addMessage(chatJid(1), messageId(messageCount), QStringLiteral("Message %1").arg(messageCount));
+    QCOMPARE(backend.updateCount(), intervalCount + 1);
+    QTRY_COMPARE(backend.updateCount(), intervalCount + 2);
+}
+
+void MessageNotificationBatcherTest::testTextLines()
+{
+    NotificationBackendStub backend;
+    MessageNotificationBatcher batcher(backend.updater(), flushInterval);
+
+    // A single message is displayed completely.
+    const auto longText = QStringLiteral("1\n2\n3\n4\n5\n6\n7");
+    batcher.addMessage(chatJid(1), messageId(1), longText);
+    batcher.flush();
+    QCOMPARE(backend.latestUpdates.value(chatJid(1)).text, longText);
+
+    // Messages fitting into the notification are displayed completely.
+    batcher.addMessage(chatJid(2), messageId(2), QStringLiteral("a\nb\nc"));
+    batcher.addMessage(chatJid(2), messageId(3), QStringLiteral("d\ne\nf"));
+    batcher.flush();
+    QCOMPARE(backend.latestUpdates.value(chatJid(2)).text, QStringLiteral("a\nb\nc\nd\ne\nf"));
+
+    // Only the last lines are displayed for further messages.
+    batcher.addMessage(chatJid(2), messageId(4), QStringLiteral("g"));
+    batcher.flush();
+    QCOMPARE(backend.latestUpdates.value(chatJid(2)).text, QStringLiteral("…\nc\nd\ne\nf\ng"));
+
+    batcher.addMessage(chatJid(1), messageId(5), QStringLiteral("8"));
+    batcher.flush();
+    QCOMPARE(backend.latestUpdates.value(chatJid(1)).text, QStringLiteral("…\n4\n5\n6\n7\n8"));
+
+    batcher.addMessage(chatJid(1), messageId(6), QStringLiteral("9\n10"));
+    batcher.flush();
+    QCOMPARE(backend.latestUpdates.value(chatJid(1)).text, QStringLiteral("…\n6\n7\n8\n9\n10"));
+}
+
+void MessageNotificationBatcherTest::testRemoveChat()
+{
+    NotificationBackendStub backend;
+    MessageNotificationBatcher batcher(backend.updater(), flushInterval);
+
+    batcher.addMessage(chatJid(1), messageId(1), QStringLiteral("a"));
+    batcher.addMessage(chatJid(2), messageId(2), QStringLiteral("b"));
+
+    // The messages of a chat that has been read in the meantime are not notified.
+    batcher.removeChat(chatJid(1));
+    QCOMPARE(batcher.pendingChatCount(), 1);
+
+    batcher.flush();
+    QCOMPARE(backend.updateCount(), 1);
+    QVERIFY(!backend.updateCounts.contains(chatJid(1)));
+
+    // A new notification only contains the messages received after removing the chat.
+    batcher.addMessage(chatJid(2), messageId(3), QStringLiteral("c"));
+    batcher.removeChat(chatJid(2));
+    batcher.addMessage(chatJid(2), messageId(4), QStringLiteral("d"));
+    batcher.flush();
+    QCOMPARE(backend.latestUpdates.value(chatJid(2)).text, QStringLiteral("d"));
+}
+
+QString MessageNotificationBatcherTest::chatJid(int number)
+{
+    return QStringLiteral("contact-%1@example.org").arg(number);
+}
+
+QString MessageNotificationBatcherTest::messageId(int number)
+{
+    return QStringLiteral("message-%1").arg(number);
+}
+
+QTEST_GUILESS_MAIN(MessageNotificationBatcherTest)
+#include "MessageNotificationBatcherTest.moc"
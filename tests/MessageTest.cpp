@@ -0,0 +1,170 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Qt
+#include <QGeoCoordinate>
+#include <QTest>
+// Kaidan
+#include "Message.h"
+#include "QmlUtils.h"
+#include "Test.h"
+#include "TextFormatter.h"
+
+static constexpr int bodyCount = 100000;
+
+class MessageTest : public Test
+{
+    Q_OBJECT
+
+private:
+    Q_SLOT void testBodyClassification_data();
+    Q_SLOT void testBodyClassification();
+    Q_SLOT void testPreviewText();
+    Q_SLOT void benchmarkRendering_data();
+    Q_SLOT void benchmarkRendering();
+
+    /**
+     * Creates bodies of messages as they are usually received.
+     */
+    static QList<QString> representativeBodies();
+};
+
+void MessageTest::testBodyClassification_data()
+{
+    QTest::addColumn<QString>("body");
+    QTest::addColumn<bool>("geoLocation");
+    QTest::addColumn<TextType>("textType");
+
+    QTest::newRow("text") << QStringLiteral("Hi there") << false << TextType::Mixed;
+    QTest::newRow("text-with-emoji") << QStringLiteral("Hi 😀") << false << TextType::Mixed;
+    QTest::newRow("single-emoji") << QStringLiteral("😀") << false << TextType::SingleEmoji;
+    QTest::newRow("multiple-emojis") << QStringLiteral("😀 👍") << false << TextType::MultipleEmojis;
+    QTest::newRow("geo-uri") << QStringLiteral("geo:48.2082,16.3738") << true << TextType::Mixed;
+    QTest::newRow("geo-uri-uppercase") << QStringLiteral("GEO:48.2082,16.3738") << true << TextType::Mixed;
+    QTest::newRow("geo-scheme-only") << QStringLiteral("geo") << false << TextType::Mixed;
+    QTest::newRow("geo-like-text") << QStringLiteral("geography: 48.2082,16.3738") << false << TextType::Mixed;
+}
+
+void MessageTest::testBodyClassification()
+{
+    QFETCH(QString, body);
+    QFETCH(bool, geoLocation);
+    QFETCH(TextType, textType);
+
+    Message unpreparedMessage;
+    unpreparedMessage.setUnpreparedBody(QStringLiteral("  ") + body + QStringLiteral("\n"));
+
+    Message preparedMessage;
+    preparedMessage.setPreparedBody(body);
+
+    QCOMPARE(unpreparedMessage.geoCoordinate().isValid(), geoLocation);
+    QCOMPARE(unpreparedMessage.bodyTextType(), textType);
+    QCOMPARE(preparedMessage.geoCoordinate().isValid(), geoLocation);
+    QCOMPARE(preparedMessage.bodyTextType(), textType);
+
+    // The classification is updated with the body.
+    preparedMessage.setPreparedBody(QStringLiteral("Hi"));
+    QVERIFY(!preparedMessage.geoCoordinate().isValid());
+    QCOMPARE(preparedMessage.bodyTextType(), TextType::Mixed);
+}
+
+void MessageTest::testPreviewText()
+{
+    Message message;
+
+    message.setPreparedBody(QStringLiteral("geo:48.2082,16.3738"));
+    QCOMPARE(message.previewText(), QStringLiteral("Location"));
+    QCOMPARE(message.geoCoordinate(), QGeoCoordinate(48.2082, 16.3738));
+
+    message.setPreparedBody(QStringLiteral("Hi"));
+    QCOMPARE(message.previewText(), QStringLiteral("Hi"));
+
+    message.isSpoiler = true;
+    QCOMPARE(message.previewText(), QStringLiteral("Spoiler"));
+}
+
+void MessageTest::benchmarkRendering_data()
+{
+    QTest::addColumn<bool>("classifiedOnce");
+
+    QTest::newRow("classified-per-render") << false;
+    QTest::newRow("classified-once") << true;
+}
+
+void MessageTest::benchmarkRendering()
+{
+    QFETCH(bool, classifiedOnce);
+
+    const auto bodies = representativeBodies();
+
+    // The bodies are classified once while the messages are parsed.
+    QList<Message> messages;
+    messages.reserve(bodies.size());
+
+    for (const auto &body : bodies) {
+        auto &message = messages.emplace_back();
+        message.setUnpreparedBody(body);
+    }
+
+    QBENCHMARK_ONCE {
+        // Each rendering (e.g., of the message list and the roster) needs the body's classification.
+        qsizetype geoLocationCount = 0;
+        qsizetype emojiTextCount = 0;
+
+        for (const auto &message : std::as_const(messages)) {
+            bool geoLocation = false;
+            TextType textType = TextType::Mixed;
+
+            if (classifiedOnce) {
+                geoLocation = message.geoCoordinate().isValid();
+                textType = message.bodyTextType();
+            } else {
+                // Parse the whole body as a URL as it was done before and determine the text type.
+                const QUrl uri(message.body());
+                geoLocation = uri.scheme() == u"geo" && QmlUtils::geoCoordinate(message.body()).isValid();
+                textType = geoLocation ? TextType::Mixed : TextFormatter::determineTextType(message.body());
+            }
+
+            geoLocationCount += geoLocation;
+            emojiTextCount += textType != TextType::Mixed;
+            QVERIFY(!message.previewText().isEmpty());
+        }
+
+        QCOMPARE(geoLocationCount, bodies.size() / 20);
+        QCOMPARE(emojiTextCount, bodies.size() / 10);
+    }
+}
+
+QList<QString> MessageTest::representativeBodies()
+{
+    const auto longText = QStringLiteral("This is a longer message with a link to https://kaidan.im and some more words. ").repeated(20);
+
+    QList<QString> bodies;
+    bodies.reserve(bodyCount);
+
+    for (int i = 0; i < bodyCount; ++i) {
+        switch (i % 20) {
+        case 0:
+            bodies.append(QStringLiteral("geo:%1,%2").arg(i % 90).arg(i % 180));
+            break;
+        case 1:
+            bodies.append(QStringLiteral("😀"));
+            break;
+        case 2:
+            bodies.append(QStringLiteral("👍 🎉 😀"));
+            break;
+        case 3:
+        case 4:
+            bodies.append(longText + QString::number(i));
+            break;
+        default:
+            bodies.append(QStringLiteral("Hi, this is message %1 😀").arg(i));
+        }
+    }
+
+    return bodies;
+}
+
+QTEST_GUILESS_MAIN(MessageTest)
+#include "MessageTest.moc"
@@ -2,6 +2,8 @@
 //
 // SPDX-License-Identifier: GPL-3.0-or-later
 
+// std
+#include <array>
 // Qt
 #include <QSignalSpy>
 #include <QTest>
@@ -22,6 +24,8 @@ private:
     Q_SLOT void presenceGetter();
     Q_SLOT void idealResource_data();
     Q_SLOT void idealResource();
+    Q_SLOT void idealPresenceChanged();
+    Q_SLOT void benchmarkPresences();
 
     void addBasicPresences();
     void addSimplePresence(const QString &jid,
@@ -51,6 +55,7 @@ void PresenceCacheTest::presenceChangedSignal()
         ChangeType,
         Jid,
         Resource,
+        IdealPresenceChanged,
     };
 
     QXmppPresence p1;
@@ -71,6 +76,7 @@ void PresenceCacheTest::presenceChangedSignal()
     QCOMPARE(spy[0][ChangeType], QVariant::fromValue(PresenceCache::Connected));
     QCOMPARE(spy[0][Jid], QStringLiteral("bob@kaidan.im"));
     QCOMPARE(spy[0][Resource], QStringLiteral("dev1"));
+    QCOMPARE(spy[0][IdealPresenceChanged], true);
 
     cache.updatePresence(p1);
     QCOMPARE(spy.count(), ++signalCount);
@@ -171,6 +177,94 @@ void PresenceCacheTest::idealResource()
     QCOMPARE(cache.pickIdealResource(jid), expectedResource);
 }
 
+void PresenceCacheTest::idealPresenceChanged()
+{
+    cache.clear();
+
+    QSignalSpy spy(&cache, &PresenceCache::presenceChanged);
+
+    const auto idealPresenceChanged = [&spy]() {
+        return spy.takeLast().at(3).toBool();
+    };
+
+    addSimplePresence(QStringLiteral("bob@kaidan.im/dev1"), QXmppPresence::Online);
+    QVERIFY(idealPresenceChanged());
+    QCOMPARE(cache.pickIdealResource(QStringLiteral("bob@kaidan.im")), QStringLiteral("dev1"));
+
+    // A less important resource does not change the ideal presence.
+    addSimplePresence(QStringLiteral("bob@kaidan.im/dev2"), QXmppPresence::Away);
+    QVERIFY(!idealPresenceChanged());
+    addSimplePresence(QStringLiteral("bob@kaidan.im/dev2"), QXmppPresence::XA);
+    QVERIFY(!idealPresenceChanged());
+    QCOMPARE(cache.pickIdealResource(QStringLiteral("bob@kaidan.im")), QStringLiteral("dev1"));
+
+    // A more important resource changes the ideal presence.
+    addSimplePresence(QStringLiteral("bob@kaidan.im/dev3"), QXmppPresence::DND);
+    QVERIFY(idealPresenceChanged());
+    QCOMPARE(cache.pickIdealResource(QStringLiteral("bob@kaidan.im")), QStringLiteral("dev3"));
+
+    // An update of the ideal resource making it less important than another one.
+    addSimplePresence(QStringLiteral("bob@kaidan.im/dev3"), QXmppPresence::Away);
+    QVERIFY(idealPresenceChanged());
+    QCOMPARE(cache.pickIdealResource(QStringLiteral("bob@kaidan.im")), QStringLiteral("dev1"));
+    QCOMPARE(cache.presence(QStringLiteral("bob@kaidan.im"))->availableStatusType(), QXmppPresence::Online);
+
+    // Removing another resource than the ideal one does not change the ideal presence.
+    addSimplePresence(QStringLiteral("bob@kaidan.im/dev2"), QXmppPresence::Online, {}, QXmppPresence::Unavailable);
+    QVERIFY(!idealPresenceChanged());
+
+    // Removing the ideal resource does.
+    addSimplePresence(QStringLiteral("bob@kaidan.im/dev1"), QXmppPresence::Online, {}, QXmppPresence::Unavailable);
+    QVERIFY(idealPresenceChanged());
+    QCOMPARE(cache.pickIdealResource(QStringLiteral("bob@kaidan.im")), QStringLiteral("dev3"));
+
+    addSimplePresence(QStringLiteral("bob@kaidan.im/dev3"), QXmppPresence::Online, {}, QXmppPresence::Unavailable);
+    QVERIFY(idealPresenceChanged());
+    QVERIFY(!cache.presence(QStringLiteral("bob@kaidan.im")));
+    QVERIFY(cache.pickIdealResource(QStringLiteral("bob@kaidan.im")).isEmpty());
+}
+
+void PresenceCacheTest::benchmarkPresences()
+{
+    constexpr int jidCount = 5000;
+    constexpr int resourceCount = 5;
+    constexpr std::array availableStatusTypes = {QXmppPresence::Away, QXmppPresence::XA, QXmppPresence::Online, QXmppPresence::Chat, QXmppPresence::DND};
+
+    QList<QString> jids;
+    QList<QXmppPresence> presences;
+    jids.reserve(jidCount);
+    presences.reserve(jidCount * resourceCount);
+
+    for (int i = 0; i < jidCount; ++i) {
+        const auto jid = QStringLiteral("contact%1@kaidan.im").arg(i);
+        jids.append(jid);
+
+        for (int j = 0; j < resourceCount; ++j) {
+            presences.append(simplePresence(jid + QStringLiteral("/resource%1").arg(j), availableStatusTypes.at((i + j) % resourceCount)));
+        }
+    }
+
+    cache.clear();
+
+    QBENCHMARK_ONCE {
+        for (const auto &presence : std::as_const(presences)) {
+            cache.updatePresence(presence);
+        }
+
+        // The ideal presence is looked up far more often than presences are received.
+        for (int round = 0; round < 10; ++round) {
+            for (const auto &jid : std::as_const(jids)) {
+                QVERIFY(cache.presence(jid));
+            }
+        }
+    }
+
+    for (const auto &jid : std::as_const(jids)) {
+        QCOMPARE(cache.resourcesCount(jid), resourceCount);
+        QCOMPARE(cache.presence(jid)->availableStatusType(), QXmppPresence::DND);
+    }
+}
+
 void PresenceCacheTest::addBasicPresences()
 {
     addSimplePresence(QStringLiteral("bob@kaidan.im/dev1"));
@@ -0,0 +1,273 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// std
+#include <stdexcept>
+// Qt
+#include <QPromise>
+#include <QTest>
+#include <QTimer>
+// Kaidan
+#include "PriorityScheduler.h"
+#include "Test.h"
+
+enum class Priority {
+    Low,
+    Normal,
+    High,
+};
+
+using Scheduler = PriorityScheduler<qint64, Priority>;
+
+constexpr auto RESPONSE_DELAY_MS = 20;
+
+/**
+ * Runs tasks that finish after a short delay and records the order they were started.
+ */
+class TaskRunner : public QObject
+{
+public:
+    Scheduler::Start task(qint64 key)
+    {
+        return [this, key]() {
+            auto promise = std::make_shared<QPromise<void>>();
+            promise->start();
+
+            m_startedKeys.append(key);
+            m_maxParallelTaskCount = std::max(m_maxParallelTaskCount, ++m_parallelTaskCount);
+
+            QTimer::singleShot(RESPONSE_DELAY_MS, this, [this, promise]() {
+                m_parallelTaskCount--;
+                promise->finish();
+            });
+
+            return promise->future();
+        };
+    }
+
+    /**
+     * Waits until all tasks are finished and returns the keys in the order the tasks were started.
+     */
+    QList<qint64> wait(const Scheduler &scheduler)
+    {
+        QTest::qWaitFor(
+            [&scheduler]() {
+                return scheduler.runningTaskCount() == 0 && scheduler.queuedTaskCount() == 0;
+            },
+            10000);
+
+        return std::exchange(m_startedKeys, {});
+    }
+
+    int maxParallelTaskCount() const
+    {
+        return m_maxParallelTaskCount;
+    }
+
+private:
+    QList<qint64> m_startedKeys;
+    int m_parallelTaskCount = 0;
+    int m_maxParallelTaskCount = 0;
+};
+
+class PrioritySchedulerTest : public Test
+{
+    Q_OBJECT
+
+private:
+    Q_SLOT void limitedParallelTasks();
+    Q_SLOT void prioritization();
+    Q_SLOT void reprioritization();
+    Q_SLOT void cancellation();
+    Q_SLOT void duplicates();
+    Q_SLOT void finishedHandler();
+    Q_SLOT void unsuccessfulTasks();
+};
+
+void PrioritySchedulerTest::limitedParallelTasks()
+{
+    TaskRunner runner;
+    Scheduler scheduler(3);
+    QList<qint64> finishedKeys;
+
+    scheduler.setFinishedHandler([&finishedKeys](qint64 key) {
+        finishedKeys.append(key);
+    });
+
+    for (qint64 key = 0; key < 20; ++key) {
+        scheduler.enqueue(key, Priority::Normal, runner.task(key));
+    }
+
+    // The tasks are started once the event loop is entered.
+    QCOMPARE(scheduler.runningTaskCount(), 0);
+    QCOMPARE(scheduler.queuedTaskCount(), 20);
+
+    QTRY_COMPARE(scheduler.runningTaskCount(), 3);
+    QCOMPARE(scheduler.queuedTaskCount(), 17);
+
+    QCOMPARE(runner.wait(scheduler).size(), 20);
+
+    QCOMPARE(finishedKeys.size(), 20);
+    QCOMPARE(runner.maxParallelTaskCount(), 3);
+}
+
+void PrioritySchedulerTest::prioritization()
+{
+    const auto preferredGroup = QStringLiteral("open@kaidan.im");
+    const auto otherGroup = QStringLiteral("other@kaidan.im");
+
+    TaskRunner runner;
+    Scheduler scheduler(1);
+
+    scheduler.setPreferredGroup(preferredGroup);
+
+    scheduler.enqueue(1, Priority::Normal, runner.task(1), otherGroup);
+    scheduler.enqueue(2, Priority::Normal, runner.task(2), otherGroup);
+    scheduler.enqueue(3, Priority::Normal, runner.task(3), preferredGroup);
+    scheduler.enqueue(4, Priority::High, runner.task(4), otherGroup);
+    scheduler.enqueue(5, Priority::Normal, runner.task(5), preferredGroup);
+    scheduler.enqueue(6, Priority::Low, runner.task(6), preferredGroup);
+    scheduler.enqueue(7, Priority::High, runner.task(7), preferredGroup);
+
+    QCOMPARE(runner.wait(scheduler), (QList<qint64>{7, 4, 3, 5, 1, 2, 6}));
+}
+
+void PrioritySchedulerTest::reprioritization()
+{
+    const auto firstGroup = QStringLiteral("first@kaidan.im");
+    const auto secondGroup = QStringLiteral("second@kaidan.im");
+
+    TaskRunner runner;
+    Scheduler scheduler(1);
+
+    scheduler.setPreferredGroup(firstGroup);
+
+    scheduler.enqueue(1, Priority::Normal, runner.task(1), firstGroup);
+    scheduler.enqueue(2, Priority::Normal, runner.task(2), firstGroup);
+    scheduler.enqueue(3, Priority::Normal, runner.task(3), secondGroup);
+    scheduler.enqueue(4, Priority::Normal, runner.task(4), secondGroup);
+    scheduler.enqueue(5, Priority::Normal, runner.task(5), secondGroup);
+
+    // Preferring another group changes the order of the queued tasks.
+    scheduler.setPreferredGroup(secondGroup);
+
+    scheduler.setPriority(4, Priority::High);
+    QCOMPARE(scheduler.priority(4), std::optional(Priority::High));
+
+    // A task whose priority is reset is started in its normal order.
+    scheduler.setPriority(5, Priority::High);
+    scheduler.setPriority(5, Priority::Normal);
+    QCOMPARE(scheduler.priority(5), std::optional(Priority::Normal));
+
+    QCOMPARE(runner.wait(scheduler), (QList<qint64>{4, 3, 5, 1, 2}));
+    QVERIFY(!scheduler.priority(4));
+}
+
+void PrioritySchedulerTest::cancellation()
+{
+    TaskRunner runner;
+    Scheduler scheduler(1);
+
+    for (qint64 key = 1; key <= 4; ++key) {
+        scheduler.enqueue(key, Priority::Normal, runner.task(key));
+    }
+
+    QVERIFY(scheduler.cancel(2));
+    QVERIFY(!scheduler.cancel(2));
+    QVERIFY(!scheduler.isQueued(2));
+
+    // Running tasks cannot be canceled by the scheduler.
+    QTRY_VERIFY(scheduler.isRunning(1));
+    QVERIFY(!scheduler.cancel(1));
+
+    QCOMPARE(runner.wait(scheduler), (QList<qint64>{1, 3, 4}));
+
+    scheduler.enqueue(5, Priority::Normal, runner.task(5));
+    scheduler.enqueue(6, Priority::Normal, runner.task(6));
+    QTRY_VERIFY(scheduler.isRunning(5));
+    scheduler.clear();
+
+    QCOMPARE(runner.wait(scheduler), (QList<qint64>{5}));
+}
+
+void PrioritySchedulerTest::duplicates()
+{
+    TaskRunner runner;
+    Scheduler scheduler(1);
+
+    scheduler.enqueue(1, Priority::Normal, runner.task(1));
+    QTRY_VERIFY(scheduler.isRunning(1));
+
+    scheduler.enqueue(2, Priority::Normal, runner.task(2));
+    scheduler.enqueue(3, Priority::Normal, runner.task(3));
+
+    // Enqueuing a running task does nothing.
+    scheduler.enqueue(1, Priority::Normal, runner.task(1));
+    QVERIFY(scheduler.isRunning(1));
+    QVERIFY(!scheduler.isQueued(1));
+
+    // Enqueuing a queued task again only raises its priority.
+    scheduler.enqueue(3, Priority::High, runner.task(3));
+    scheduler.enqueue(3, Priority::Low, runner.task(3));
+    QCOMPARE(scheduler.queuedTaskCount(), 2);
+    QCOMPARE(scheduler.priority(3), std::optional(Priority::High));
+
+    QCOMPARE(runner.wait(scheduler), (QList<qint64>{1, 3, 2}));
+
+    // A finished task can be repeated.
+    scheduler.enqueue(1, Priority::Normal, runner.task(1));
+    QCOMPARE(runner.wait(scheduler), (QList<qint64>{1}));
+}
+
+void PrioritySchedulerTest::finishedHandler()
+{
+    TaskRunner runner;
+    Scheduler scheduler(2);
+    QList<qint64> finishedKeys;
+
+    // A finished task can be enqueued again from the handler.
+    scheduler.setFinishedHandler([&](qint64 key) {
+        if (key == 1 && !finishedKeys.contains(key)) {
+            scheduler.enqueue(key, Priority::Normal, runner.task(key));
+        }
+
+        finishedKeys.append(key);
+    });
+
+    scheduler.enqueue(1, Priority::Normal, runner.task(1));
+    scheduler.enqueue(2, Priority::Normal, runner.task(2));
+
+    QCOMPARE(runner.wait(scheduler), (QList<qint64>{1, 2, 1}));
+    QCOMPARE(finishedKeys.count(1), 2);
+}
+
+void PrioritySchedulerTest::unsuccessfulTasks()
+{
+    TaskRunner runner;
+    Scheduler scheduler(1);
+    QList<qint64> finishedKeys;
+
+    scheduler.setFinishedHandler([&finishedKeys](qint64 key) {
+        finishedKeys.append(key);
+    });
+
+    // Failed and canceled tasks do not block the next tasks.
+    scheduler.enqueue(1, Priority::Normal, []() {
+        return QtFuture::makeExceptionalFuture(std::make_exception_ptr(std::runtime_error("Task failed")));
+    });
+    scheduler.enqueue(2, Priority::Normal, []() {
+        QPromise<void> promise;
+        promise.start();
+        promise.future().cancel();
+        promise.finish();
+        return promise.future();
+    });
+    scheduler.enqueue(3, Priority::Normal, runner.task(3));
+
+    QCOMPARE(runner.wait(scheduler), (QList<qint64>{3}));
+    QCOMPARE(finishedKeys, (QList<qint64>{1, 2, 3}));
+}
+
+QTEST_GUILESS_MAIN(PrioritySchedulerTest)
+#include "PrioritySchedulerTest.moc"
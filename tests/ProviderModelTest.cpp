@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Qt
+#include <QTest>
+// Kaidan
+#include "Provider.h"
+#include "ProviderCatalog.h"
+#include "ProviderFilterModel.h"
+#include "ProviderModel.h"
+#include "Test.h"
+
+class ProviderModelTest : public Test
+{
+    Q_OBJECT
+
+private:
+    Q_SLOT void initTestCase() override;
+    Q_SLOT void testFileParsedOnce();
+    Q_SLOT void testProviderFromBareJid();
+    Q_SLOT void testFiltering();
+};
+
+void ProviderModelTest::initTestCase()
+{
+    Test::initTestCase();
+    Q_INIT_RESOURCE(data);
+}
+
+void ProviderModelTest::testFileParsedOnce()
+{
+    // Provider models are created by several pages.
+    ProviderModel registrationModel;
+    ProviderModel providerPageModel;
+    ProviderModel accountDetailsModel;
+
+    ProviderFilterModel filterModel;
+    filterModel.setSourceModel(&registrationModel);
+
+    QVERIFY(registrationModel.rowCount() > 1);
+    QCOMPARE(providerPageModel.rowCount(), registrationModel.rowCount());
+    QCOMPARE(accountDetailsModel.rowCount(), registrationModel.rowCount());
+    QVERIFY(filterModel.rowCount() > 0);
+
+    // All models use the providers of the shared catalog instead of parsing the file themselves.
+    const auto &catalog = ProviderCatalog::instance();
+
+    for (int row = 0; row < registrationModel.rowCount(); ++row) {
+        QCOMPARE(&registrationModel.provider(row), &catalog.provider(row));
+        QCOMPARE(&providerPageModel.provider(row), &catalog.provider(row));
+        QCOMPARE(&accountDetailsModel.provider(row), &catalog.provider(row));
+    }
+}
+
+void ProviderModelTest::testProviderFromBareJid()
+{
+    ProviderModel model;
+    const auto jid = model.data(1, ProviderModel::Role::Jid).toString();
+
+    QCOMPARE(model.providerFromBareJid(QStringLiteral("user@") + jid).jid(), jid);
+    QVERIFY(model.providerFromBareJid(QStringLiteral("user@unknown.example.org")).isCustomProvider());
+}
+
+void ProviderModelTest::testFiltering()
+{
+    ProviderModel model;
+    ProviderFilterModel filterModel;
+    filterModel.setSourceModel(&model);
+
+    const auto unfilteredRowCount = filterModel.rowCount();
+
+    filterModel.setSupportsInBandRegistrationOnly(true);
+    filterModel.setHostedGreenOnly(true);
+
+    QVERIFY(filterModel.rowCount() <= unfilteredRowCount);
+
+    for (int i = 0; i < filterModel.rowCount(); ++i) {
+        const auto &provider = model.provider(filterModel.mapToSource(filterModel.index(i, 0)).row());
+
+        // The custom provider is always displayed.
+        if (!provider.isCustomProvider()) {
+            QVERIFY(provider.supportsInBandRegistration());
+            QVERIFY(provider.hostedGreen());
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(ProviderModelTest)
+#include "ProviderModelTest.moc"
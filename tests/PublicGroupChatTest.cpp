@@ -3,10 +3,17 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 // Qt
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFileInfo>
 #include <QJsonArray>
+#include <QJsonDocument>
 #include <QSignalSpy>
+#include <QStandardPaths>
+#include <QTcpServer>
+#include <QTcpSocket>
 #include <QTest>
-#include <QTimer>
+#include <QUrlQuery>
 // Kaidan
 #include "PublicGroupChat.h"
 #include "PublicGroupChatModel.h"
@@ -14,13 +21,110 @@
 #include "PublicGroupChatSearchController.h"
 #include "Test.h"
 
-#define REQUEST_TIMEOUT static_cast<int>((std::chrono::milliseconds(PublicGroupChatSearchController::RequestTimeout) * 1.2).count())
+static PublicGroupChat publicGroupChat(int number, int users = 1)
+{
+    PublicGroupChat groupChat;
+    groupChat.setAddress(QStringLiteral("group-chat-%1@muc.example.org").arg(number));
+    groupChat.setUsers(users);
+    groupChat.setIsOpen(true);
+    groupChat.setName(QStringLiteral("Group Chat %1").arg(number));
+    groupChat.setLanguages({QStringLiteral("en")});
+    return groupChat;
+}
+
+/**
+ * Local stand-in for the public group chat directory serving paged JSON.
+ *
+ * Each page has an entity tag so that conditional requests for unmodified pages are answered without the page.
+ */
+class PublicGroupChatDirectory : public QTcpServer
+{
+public:
+    PublicGroupChatDirectory()
+    {
+        QVERIFY(listen(QHostAddress::LocalHost));
+        connect(this, &QTcpServer::newConnection, this, &PublicGroupChatDirectory::handleNewConnections);
+    }
+
+    QUrl url() const
+    {
+        return QUrl(QStringLiteral("http://127.0.0.1:%1/api/1.0/rooms").arg(serverPort()));
+    }
+
+    // group chats sorted by their addresses
+    PublicGroupChats groupChats;
+    int pageSize = 2;
+    int requestCount = 0;
+    int notModifiedCount = 0;
+
+private:
+    void handleNewConnections()
+    {
+        while (auto *socket = nextPendingConnection()) {
+            connect(socket, &QTcpSocket::readyRead, this, [this, socket]() {
+                handleRequest(socket);
+            });
+            connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+        }
+    }
+
+    void handleRequest(QTcpSocket *socket)
+    {
+        if (!socket->peek(socket->bytesAvailable()).contains("\r\n\r\n")) {
+            return;
+        }
+
+        const auto lines = socket->readAll().split('\n');
+        const auto requestLine = lines.constFirst().split(' ');
+        const auto query = QUrlQuery(QUrl(QString::fromUtf8(requestLine.value(1))));
+        const auto previousAddress = QUrl::fromPercentEncoding(query.queryItemValue(QStringLiteral("after"), QUrl::FullyDecoded).toUtf8());
+
+        QByteArray entityTagCondition;
+
+        for (const auto &line : lines) {
+            if (line.toLower().startsWith("if-none-match:")) {
+                entityTagCondition = line.mid(line.indexOf(':') + 1).trimmed();
+            }
+        }
+
+        qsizetype firstIndex = 0;
+
+        while (firstIndex < groupChats.size() && groupChats.at(firstIndex).address() <= previousAddress) {
+            ++firstIndex;
+        }
+
+        const auto page = groupChats.mid(firstIndex, pageSize);
+        const auto body = QJsonDocument(QJsonObject{{QStringLiteral("items"), PublicGroupChat::toJson(page)}}).toJson(QJsonDocument::Compact);
+        const auto entityTag = '"' + QCryptographicHash::hash(body, QCryptographicHash::Md5).toHex() + '"';
+
+        requestCount++;
+
+        QByteArray response;
+
+        if (entityTagCondition == entityTag) {
+            notModifiedCount++;
+            response = QByteArrayLiteral("HTTP/1.1 304 Not Modified\r\nETag: ") + entityTag + QByteArrayLiteral("\r\nConnection: close\r\n\r\n");
+        } else {
+            response = QByteArrayLiteral("HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nETag: ") + entityTag
+                + QByteArrayLiteral("\r\nContent-Length: ") + QByteArray::number(body.size()) + QByteArrayLiteral("\r\nConnection: close\r\n\r\n") + body;
+        }
+
+        socket->write(response);
+        socket->disconnectFromHost();
+    }
+};
 
 class PublicGroupChatTest : public Test
 {
     Q_OBJECT
 
 private Q_SLOTS:
+    void init()
+    {
+        // Each test starts without cached group chats.
+        QFile::remove(cacheFilePath());
+    }
+
     void testSplitLanguages_data()
     {
         QTest::addColumn<QString>("languages");
@@ -135,65 +239,61 @@ private Q_SLOTS:
 
     void testGroupChatSearchManagerAndGroupChatModel()
     {
+        PublicGroupChatDirectory directory;
+        directory.groupChats = {publicGroupChat(1), publicGroupChat(2), publicGroupChat(3), publicGroupChat(4), publicGroupChat(5)};
+
         PublicGroupChatSearchController manager;
+        manager.setServiceUrl(directory.url());
+
         PublicGroupChatModel model;
         QSignalSpy spyIsRunning(&manager, &PublicGroupChatSearchController::isRunningChanged);
         QSignalSpy spyError(&manager, &PublicGroupChatSearchController::error);
         QSignalSpy spyReceived(&manager, &PublicGroupChatSearchController::groupChatsReceived);
+        QSignalSpy spyPageReceived(&manager, &PublicGroupChatSearchController::groupChatsPageReceived);
         auto clearSpies = [&]() {
             spyIsRunning.clear();
             spyError.clear();
             spyReceived.clear();
+            spyPageReceived.clear();
         };
 
+        connect(&manager, &PublicGroupChatSearchController::groupChatsPageReceived, &model, &PublicGroupChatModel::addGroupChats);
         connect(&manager, &PublicGroupChatSearchController::groupChatsReceived, &model, &PublicGroupChatModel::setGroupChats);
 
         QVERIFY(manager.cachedGroupChats().isEmpty());
         QVERIFY(model.rowCount() == manager.cachedGroupChats().count());
 
-        // requestAll and cancel after 1 second
+        // requestAll and cancel before any page is received
         QVERIFY(!manager.isRunning());
         manager.requestAll();
+        QVERIFY(manager.isRunning());
+        manager.cancel();
 
-        QTimer cancelTimer;
-        cancelTimer.setSingleShot(true);
-        cancelTimer.setInterval(1000);
-        cancelTimer.callOnTimeout(&manager, &PublicGroupChatSearchController::cancel);
-
-        cancelTimer.start();
-
-        QVERIFY(spyIsRunning.wait(2000));
         QVERIFY(spyError.isEmpty());
-        // Depending on how fast the network is, the cancellation can be requested too late (data already received).
-        QVERIFY(spyReceived.size() <= 1);
+        QVERIFY(spyReceived.isEmpty());
         QCOMPARE(spyIsRunning.count(), 2);
         QCOMPARE(spyIsRunning.constFirst().constFirst().toBool(), true);
         QCOMPARE(spyIsRunning.constLast().constFirst().toBool(), false);
-        if (spyReceived.isEmpty()) {
-            QVERIFY(manager.cachedGroupChats().isEmpty());
-        } else {
-            QVERIFY(manager.cachedGroupChats().size() >= 1);
-        }
+        QVERIFY(manager.cachedGroupChats().isEmpty());
         QVERIFY(model.rowCount() == manager.cachedGroupChats().count());
 
-        // In case the network was too fast, avoid canceling the next request.
-        cancelTimer.stop();
-
         clearSpies();
 
         // Really requestAll
-        QVERIFY(!manager.isRunning());
         manager.requestAll();
 
-        QVERIFY(spyIsRunning.wait(REQUEST_TIMEOUT));
+        QTRY_VERIFY(!manager.isRunning());
         QVERIFY(spyError.isEmpty());
         QCOMPARE(spyReceived.count(), 1);
         QCOMPARE(spyIsRunning.count(), 2);
         QCOMPARE(spyIsRunning.constFirst().constFirst().toBool(), true);
         QCOMPARE(spyIsRunning.constLast().constFirst().toBool(), false);
-        QVERIFY(!manager.cachedGroupChats().isEmpty());
+        QCOMPARE(manager.cachedGroupChats(), directory.groupChats);
         QVERIFY(model.rowCount() == manager.cachedGroupChats().count());
 
+        // Each page is provided as soon as it is received.
+        QCOMPARE(spyPageReceived.count(), 3);
+
         // Check first group chat
         const PublicGroupChat &groupChat = model.groupChats().constFirst();
         const QModelIndex index = model.index(0);
@@ -203,6 +303,106 @@ private Q_SLOTS:
         QCOMPARE(groupChat.description(), index.data(Qt::ToolTipRole));
     }
 
+    void testCachedGroupChats()
+    {
+        PublicGroupChatDirectory directory;
+        directory.groupChats = {publicGroupChat(1), publicGroupChat(2), publicGroupChat(3), publicGroupChat(4), publicGroupChat(5)};
+
+        // The file of the previous cache format is removed.
+        const auto legacyCacheFilePath = QFileInfo(cacheFilePath()).dir().absoluteFilePath(QStringLiteral("public-group-chats.json"));
+        QFile legacyCacheFile(legacyCacheFilePath);
+        QVERIFY(legacyCacheFile.open(QIODevice::WriteOnly));
+        legacyCacheFile.close();
+
+        cacheGroupChats(directory);
+        QVERIFY(!QFile::exists(legacyCacheFilePath));
+
+        PublicGroupChatSearchController manager;
+        manager.setServiceUrl(directory.url());
+
+        QSignalSpy spyReceived(&manager, &PublicGroupChatSearchController::groupChatsReceived);
+
+        // The cached group chats are provided immediately and not refreshed while they are up to date.
+        manager.requestAll();
+
+        QCOMPARE(spyReceived.count(), 1);
+        QCOMPARE(manager.cachedGroupChats(), directory.groupChats);
+        QVERIFY(!manager.isRunning());
+        QCOMPARE(directory.requestCount, 0);
+
+        // A refresh requested by the user is done even if the cache is up to date.
+        manager.refresh();
+        QVERIFY(manager.isRunning());
+        QTRY_VERIFY(!manager.isRunning());
+
+        QCOMPARE(directory.requestCount, 4);
+        QCOMPARE(directory.notModifiedCount, 3);
+        QCOMPARE(manager.cachedGroupChats(), directory.groupChats);
+    }
+
+    void testConditionalRefresh()
+    {
+        PublicGroupChatDirectory directory;
+        directory.groupChats = {publicGroupChat(1), publicGroupChat(2), publicGroupChat(3), publicGroupChat(4), publicGroupChat(5)};
+
+        cacheGroupChats(directory);
+        directory.groupChats[2] = publicGroupChat(3, 42);
+        directory.requestCount = 0;
+        directory.notModifiedCount = 0;
+
+        PublicGroupChatSearchController manager;
+        manager.setServiceUrl(directory.url());
+        manager.setCacheLifetime(0ms);
+
+        PublicGroupChatModel model;
+        connect(&manager, &PublicGroupChatSearchController::groupChatsPageReceived, &model, &PublicGroupChatModel::addGroupChats);
+        connect(&manager, &PublicGroupChatSearchController::groupChatsReceived, &model, &PublicGroupChatModel::setGroupChats);
+
+        QSignalSpy spyPageReceived(&manager, &PublicGroupChatSearchController::groupChatsPageReceived);
+
+        // The cached group chats are shown while they are refreshed in the background.
+        manager.requestAll();
+        QCOMPARE(model.rowCount(), 5);
+        QVERIFY(manager.isRunning());
+
+        QSignalSpy spyModelReset(&model, &PublicGroupChatModel::modelReset);
+        QSignalSpy spyDataChanged(&model, &PublicGroupChatModel::dataChanged);
+
+        QTRY_VERIFY(!manager.isRunning());
+
+        // Only the modified page is transferred and merged into the model.
+        QCOMPARE(directory.requestCount, 4);
+        QCOMPARE(directory.notModifiedCount, 2);
+        QCOMPARE(spyPageReceived.count(), 1);
+        QCOMPARE(spyDataChanged.count(), 1);
+        QVERIFY(spyModelReset.isEmpty());
+        QCOMPARE(model.groupChats(), directory.groupChats);
+        QCOMPARE(manager.cachedGroupChats(), directory.groupChats);
+
+        // Removed group chats are removed from the model after the refresh.
+        directory.groupChats.removeLast();
+        directory.requestCount = 0;
+        directory.notModifiedCount = 0;
+
+        QSignalSpy spyRowsRemoved(&model, &PublicGroupChatModel::rowsRemoved);
+
+        manager.requestAll();
+        QTRY_VERIFY(!manager.isRunning());
+
+        QCOMPARE(directory.requestCount, 3);
+        QCOMPARE(directory.notModifiedCount, 2);
+        QCOMPARE(spyRowsRemoved.count(), 1);
+        QVERIFY(spyModelReset.isEmpty());
+        QCOMPARE(model.groupChats(), directory.groupChats);
+
+        // The refreshed cache is used by other instances.
+        PublicGroupChatSearchController otherManager;
+        otherManager.setServiceUrl(directory.url());
+        otherManager.requestAll();
+        QCOMPARE(otherManager.cachedGroupChats(), directory.groupChats);
+        QVERIFY(!otherManager.isRunning());
+    }
+
     void testPublicGroupChatProxyModel_data()
     {
         using Role = PublicGroupChatModel::CustomRole;
@@ -540,6 +740,127 @@ private Q_SLOTS:
         QCOMPARE(modelData(Role::Address), expected.at(1));
         QCOMPARE(modelData(Role::Languages), expected.at(2));
     }
+
+    void testPublicGroupChatProxyModelSearchText()
+    {
+        PublicGroupChatModel model;
+        PublicGroupChatProxyModel proxy;
+        proxy.setSourceModel(&model);
+        proxy.setFilterRole(static_cast<int>(PublicGroupChatModel::CustomRole::GlobalSearch));
+
+        auto groupChat1 = publicGroupChat(1);
+        groupChat1.setName(QStringLiteral("Straße"));
+        groupChat1.setLanguages({QStringLiteral("de")});
+
+        auto groupChat2 = publicGroupChat(2);
+        groupChat2.setDescription(QStringLiteral("Kaidan Support"));
+
+        auto groupChat3 = publicGroupChat(3);
+        groupChat3.setDescription(QStringLiteral("Kaidan Development"));
+
+        model.setGroupChats({groupChat1, groupChat2, groupChat3});
+
+        // The search is case-insensitive.
+        proxy.setSearchText(QStringLiteral("STRASSE"));
+        QCOMPARE(proxy.count(), 1);
+
+        proxy.setSearchText(QStringLiteral("kaidan"));
+        QCOMPARE(proxy.count(), 2);
+
+        // Narrowing the search text.
+        proxy.setSearchText(QStringLiteral("kaidan s"));
+        QCOMPARE(proxy.count(), 1);
+
+        // Extending the search text.
+        proxy.setSearchText(QStringLiteral("muc.example"));
+        QCOMPARE(proxy.count(), 3);
+
+        // Group chats added while searching are filtered as well.
+        auto groupChat4 = publicGroupChat(4);
+        groupChat4.setAddress(QStringLiteral("group-chat-4@conference.example.net"));
+        model.addGroupChats({groupChat4});
+        QCOMPARE(proxy.count(), 3);
+
+        proxy.setSearchText(QStringLiteral("muc.example.org"));
+        QCOMPARE(proxy.count(), 3);
+
+        proxy.setSearchText(QStringLiteral("example"));
+        QCOMPARE(proxy.count(), 4);
+
+        proxy.setLanguageFilter(QStringLiteral("de"));
+        QCOMPARE(proxy.count(), 1);
+
+        // A language that is not yet known is filtered once a group chat with it is added.
+        proxy.setLanguageFilter(QStringLiteral("fr"));
+        QCOMPARE(proxy.count(), 0);
+
+        auto groupChat5 = publicGroupChat(5);
+        groupChat5.setLanguages({QStringLiteral("fr")});
+        model.addGroupChats({groupChat5});
+        QCOMPARE(proxy.count(), 1);
+    }
+
+    void benchmarkPublicGroupChatProxyModelSearch()
+    {
+        constexpr int groupChatCount = 50000;
+        const auto searchText = QStringLiteral("group chat 4242");
+
+        PublicGroupChats groupChats;
+        groupChats.reserve(groupChatCount);
+
+        for (int i = 0; i < groupChatCount; ++i) {
+            auto groupChat = publicGroupChat(i, i % 100);
+            groupChat.setDescription(QStringLiteral("Description of group chat %1").arg(i));
+            groupChat.setLanguages({i % 2 ? QStringLiteral("en") : QStringLiteral("de")});
+            groupChats.append(groupChat);
+        }
+
+        PublicGroupChatModel model;
+        model.setGroupChats(groupChats);
+
+        PublicGroupChatProxyModel proxy;
+        proxy.setSourceModel(&model);
+        proxy.setFilterRole(static_cast<int>(PublicGroupChatModel::CustomRole::GlobalSearch));
+
+        const auto matchingGroupChatCount = [&groupChats](const QString &text) {
+            return std::ranges::count_if(groupChats, [&text](const PublicGroupChat &groupChat) {
+                return groupChat.name().contains(text, Qt::CaseInsensitive) || groupChat.description().contains(text, Qt::CaseInsensitive)
+                    || groupChat.address().contains(text, Qt::CaseInsensitive);
+            });
+        };
+
+        // Emulate entering the search text character by character.
+        QBENCHMARK_ONCE {
+            for (int i = 1; i <= searchText.size(); ++i) {
+                proxy.setSearchText(searchText.left(i));
+            }
+        }
+
+        QCOMPARE(proxy.count(), matchingGroupChatCount(searchText));
+
+        // Removing characters searches all group chats again.
+        proxy.setSearchText(QStringLiteral("group chat 42"));
+        QCOMPARE(proxy.count(), matchingGroupChatCount(QStringLiteral("group chat 42")));
+    }
+
+private:
+    static QString cacheFilePath()
+    {
+        return QDir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)).absoluteFilePath(QStringLiteral("public-group-chats.cache"));
+    }
+
+    /**
+     * Caches the group chats of a directory.
+     */
+    static void cacheGroupChats(PublicGroupChatDirectory &directory)
+    {
+        PublicGroupChatSearchController manager;
+        manager.setServiceUrl(directory.url());
+        manager.requestAll();
+
+        QTRY_VERIFY(!manager.isRunning());
+        QCOMPARE(manager.cachedGroupChats(), directory.groupChats);
+    }
 };
 
 QTEST_GUILESS_MAIN(PublicGroupChatTest)
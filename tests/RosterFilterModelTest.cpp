@@ -0,0 +1,136 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Qt
+#include <QTest>
+// QXmpp
+#include <QXmppPresence.h>
+// Kaidan
+#include "Account.h"
+#include "PresenceCache.h"
+#include "RosterFilterModel.h"
+#include "RosterModel.h"
+#include "Test.h"
+
+static const auto accountJid = QStringLiteral("user@example.org");
+static constexpr int contactCount = 1000;
+static constexpr int presencesPerContact = 10;
+
+// Counts how often rows are filtered.
+class CountingRosterFilterModel : public RosterFilterModel
+{
+public:
+    mutable int filterAcceptsRowCount = 0;
+
+protected:
+    bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override
+    {
+        filterAcceptsRowCount++;
+        return RosterFilterModel::filterAcceptsRow(sourceRow, sourceParent);
+    }
+};
+
+class RosterFilterModelTest : public Test
+{
+    Q_OBJECT
+
+private:
+    Q_SLOT void initTestCase() override;
+    Q_SLOT void testAvailabilityFiltering();
+    Q_SLOT void testPresenceFlood();
+
+    static QString contactJid(int number);
+    void sendPresence(int contactNumber, int resourceNumber, QXmppPresence::Type type = QXmppPresence::Available);
+
+    Account *m_account = nullptr;
+};
+
+void RosterFilterModelTest::initTestCase()
+{
+    Test::initTestCase();
+
+    m_account = addAccount(accountJid);
+
+    for (int i = 0; i < contactCount; ++i) {
+        addRosterItem(accountJid, contactJid(i));
+    }
+
+    QCOMPARE(RosterModel::instance()->rowCount(), contactCount);
+}
+
+void RosterFilterModelTest::testAvailabilityFiltering()
+{
+    CountingRosterFilterModel model;
+    model.setSourceModel(RosterModel::instance());
+    model.addDisplayedType(RosterFilterModel::Type::AvailableContact);
+
+    QCOMPARE(model.rowCount(), 0);
+
+    sendPresence(1, 1);
+    sendPresence(2, 1);
+
+    // A contact becoming available and unavailable again within one event loop iteration is unchanged.
+    sendPresence(3, 1);
+    sendPresence(3, 1, QXmppPresence::Unavailable);
+
+    QTRY_COMPARE(model.rowCount(), 2);
+
+    // A contact stays available as long as one of its resources is available.
+    sendPresence(1, 2);
+    sendPresence(1, 1, QXmppPresence::Unavailable);
+    sendPresence(2, 1, QXmppPresence::Unavailable);
+
+    QTRY_COMPARE(model.rowCount(), 1);
+    QCOMPARE(model.data(model.index(0, 0), RosterModel::JidRole).toString(), contactJid(1));
+
+    // Clearing the presences makes all contacts unavailable.
+    m_account->presenceCache()->clear();
+
+    QTRY_COMPARE(model.rowCount(), 0);
+}
+
+void RosterFilterModelTest::testPresenceFlood()
+{
+    CountingRosterFilterModel model;
+    model.setSourceModel(RosterModel::instance());
+    model.addDisplayedType(RosterFilterModel::Type::AvailableContact);
+
+    QCOMPARE(model.rowCount(), 0);
+
+    model.filterAcceptsRowCount = 0;
+
+    // Each contact becomes available and sends further presences afterwards (e.g., for other
+    // resources or changed statuses).
+    for (int i = 0; i < contactCount; ++i) {
+        for (int j = 0; j < presencesPerContact; ++j) {
+            sendPresence(i, j);
+        }
+    }
+
+    // The rows are not filtered before the event loop is entered.
+    QCOMPARE(model.filterAcceptsRowCount, 0);
+
+    QTRY_COMPARE(model.rowCount(), contactCount);
+
+    // Only the rows of contacts whose availability changed are filtered, each only once.
+    QCOMPARE(model.filterAcceptsRowCount, contactCount);
+
+    m_account->presenceCache()->clear();
+    QTRY_COMPARE(model.rowCount(), 0);
+}
+
+QString RosterFilterModelTest::contactJid(int number)
+{
+    return QStringLiteral("contact-%1@example.org").arg(number);
+}
+
+void RosterFilterModelTest::sendPresence(int contactNumber, int resourceNumber, QXmppPresence::Type type)
+{
+    QXmppPresence presence(type);
+    presence.setFrom(contactJid(contactNumber) + QStringLiteral("/resource-%1").arg(resourceNumber));
+    m_account->presenceCache()->updatePresence(presence);
+}
+
+QTEST_GUILESS_MAIN(RosterFilterModelTest)
+#include "RosterFilterModelTest.moc"
@@ -5,6 +5,7 @@
 // std
 #include <optional>
 // Qt
+#include <QSignalSpy>
 #include <QTest>
 // QXmpp
 #include <QXmppRosterIq.h>
@@ -44,6 +45,8 @@ private:
     Q_SLOT void testClear();
     Q_SLOT void testLoadRoundTrip();
     Q_SLOT void testWireAttributesRoundTrip();
+    Q_SLOT void testReplaceAllEmitsChanges();
+    Q_SLOT void benchmarkReplaceAll();
 
     static QXmppRosterIq::Item
     wireItem(const QString &jid, const QString &name, QXmppRosterIq::Item::SubscriptionType subscription, const QSet<QString> &groups = {});
@@ -273,6 +276,85 @@ void RosterStorageTest::testWireAttributesRoundTrip()
     QCOMPARE(itemsByJid[channelJid].mixParticipantId(), QStringLiteral("part-1"));
 }
 
+void RosterStorageTest::testReplaceAllEmitsChanges()
+{
+    wait(this,
+         storage->replaceAll(QStringLiteral("v1"),
+                             {
+                                 wireItem(alice, QStringLiteral("Alice"), QXmppRosterIq::Item::Both, {QStringLiteral("Friends"), QStringLiteral("Work")}),
+                                 wireItem(bob, QStringLiteral("Bob"), QXmppRosterIq::Item::Both),
+                             }));
+
+    QSignalSpy itemsChangedSpy(rosterDb, &RosterDb::itemsChanged);
+
+    // Replacing the items with the same ones does not change anything.
+    wait(this,
+         storage->replaceAll(QStringLiteral("v2"),
+                             {
+                                 wireItem(alice, QStringLiteral("Alice"), QXmppRosterIq::Item::Both, {QStringLiteral("Work"), QStringLiteral("Friends")}),
+                                 wireItem(bob, QStringLiteral("Bob"), QXmppRosterIq::Item::Both),
+                             }));
+
+    QCOMPARE(itemsChangedSpy.count(), 0);
+
+    // Alice is updated, Bob is gone and Carol is new.
+    const auto carol = QStringLiteral("carol@example.org");
+    wait(this,
+         storage->replaceAll(QStringLiteral("v3"),
+                             {
+                                 wireItem(alice, QStringLiteral("Alice"), QXmppRosterIq::Item::Both, {QStringLiteral("Friends")}),
+                                 wireItem(carol, QStringLiteral("Carol"), QXmppRosterIq::Item::Both),
+                             }));
+
+    QCOMPARE(itemsChangedSpy.count(), 1);
+
+    const auto arguments = itemsChangedSpy.constFirst();
+    const auto addedItems = arguments.at(1).value<QList<RosterItem>>();
+    const auto updatedItems = arguments.at(2).value<QList<RosterItem>>();
+
+    QCOMPARE(addedItems.size(), 1);
+    QCOMPARE(addedItems.constFirst().jid, carol);
+    QCOMPARE(updatedItems.size(), 1);
+    QCOMPARE(updatedItems.constFirst().groups, QList<QString>{QStringLiteral("Friends")});
+    QCOMPARE(arguments.at(3).value<QList<QString>>(), QList<QString>{bob});
+
+    QCOMPARE(fetchItem(alice)->groups, QList<QString>{QStringLiteral("Friends")});
+    QVERIFY(!fetchItem(bob).has_value());
+}
+
+void RosterStorageTest::benchmarkReplaceAll()
+{
+    constexpr int itemCount = 5000;
+    constexpr int changedItemCount = 10;
+
+    std::vector<QXmppRosterIq::Item> items;
+    items.reserve(itemCount);
+
+    for (int i = 0; i < itemCount; ++i) {
+        items.push_back(wireItem(QStringLiteral("contact-%1@example.org").arg(i),
+                                 QStringLiteral("Contact %1").arg(i),
+                                 QXmppRosterIq::Item::Both,
+                                 {QStringLiteral("Group %1").arg(i % 20)}));
+    }
+
+    wait(this, storage->replaceAll(QStringLiteral("v1"), items));
+
+    for (int i = 0; i < itemCount; i += itemCount / changedItemCount) {
+        items[i].setName(items.at(i).name() + QStringLiteral(" (renamed)"));
+    }
+
+    QSignalSpy itemsChangedSpy(rosterDb, &RosterDb::itemsChanged);
+
+    QBENCHMARK_ONCE {
+        wait(this, storage->replaceAll(QStringLiteral("v2"), items));
+    }
+
+    QCOMPARE(itemsChangedSpy.count(), 1);
+    QVERIFY(itemsChangedSpy.constFirst().at(1).value<QList<RosterItem>>().isEmpty());
+    QCOMPARE(itemsChangedSpy.constFirst().at(2).value<QList<RosterItem>>().size(), changedItemCount);
+    QVERIFY(itemsChangedSpy.constFirst().at(3).value<QList<QString>>().isEmpty());
+}
+
 QTEST_GUILESS_MAIN(RosterStorageTest)
 
 #include "RosterStorageTest.moc"
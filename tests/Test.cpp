@@ -7,6 +7,13 @@
 // Qt
 #include <QStandardPaths>
 #include <QTest>
+// Kaidan
+#include "Account.h"
+#include "AccountController.h"
+#include "MainController.h"
+#include "RosterDb.h"
+
+Test::~Test() = default;
 
 void Test::initTestCase()
 {
@@ -16,6 +23,32 @@ void Test::initTestCase()
     removeTestDataDirectory();
 }
 
+Account *Test::addAccount(const QString &jid)
+{
+    if (!m_mainController) {
+        m_mainController = std::make_unique<MainController>();
+    }
+
+    auto *account = AccountController::instance()->createUninitializedAccount();
+    account->settings()->setJid(jid);
+    Q_EMIT AccountController::instance()->accountAdded(account);
+
+    return account;
+}
+
+void Test::addRosterItem(const RosterItem &item)
+{
+    Q_EMIT RosterDb::instance()->itemAdded(item);
+}
+
+void Test::addRosterItem(const QString &accountJid, const QString &jid)
+{
+    RosterItem item;
+    item.accountJid = accountJid;
+    item.jid = jid;
+    addRosterItem(item);
+}
+
 void Test::removeTestDataDirectory()
 {
     const auto testDirectoryPath = QStandardPaths::writableLocation(QStandardPaths::StandardLocation::AppDataLocation);
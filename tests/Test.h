@@ -4,19 +4,44 @@
 
 #pragma once
 
+// std
+#include <memory>
 // Qt
 #include <QObject>
 
+class Account;
+class MainController;
+struct RosterItem;
+
 class Test : public QObject
 {
     Q_OBJECT
 
 public:
     using QObject::QObject;
+    ~Test() override;
 
 protected Q_SLOTS:
     virtual void initTestCase();
 
+protected:
+    /**
+     * Creates the application's controllers and adds an account that is not connected.
+     *
+     * @param jid JID of the account
+     *
+     * @return the added account
+     */
+    Account *addAccount(const QString &jid);
+
+    /**
+     * Adds a roster item as if it has been stored in the database.
+     */
+    static void addRosterItem(const RosterItem &item);
+    static void addRosterItem(const QString &accountJid, const QString &jid);
+
 private:
     void removeTestDataDirectory();
+
+    std::unique_ptr<MainController> m_mainController;
 };
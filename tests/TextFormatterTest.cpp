@@ -0,0 +1,228 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// std
+#include <memory>
+// Qt
+#include <QQmlComponent>
+#include <QQmlEngine>
+#include <QQuickItem>
+#include <QQuickTextDocument>
+#include <QTest>
+#include <QTextCursor>
+#include <QTextDocument>
+// Kaidan
+#include "TextFormatter.h"
+#include "Test.h"
+
+constexpr auto TYPED_CHARACTER_COUNT = 10000;
+const auto EMOJI_FONT_FAMILY = QStringLiteral("emoji");
+
+class TextFormatterTest : public Test
+{
+    Q_OBJECT
+
+private:
+    Q_SLOT void incrementalFormatting_data();
+    Q_SLOT void incrementalFormatting();
+    Q_SLOT void emojiFontSize();
+    Q_SLOT void typing_data();
+    Q_SLOT void typing();
+
+    std::unique_ptr<QQuickItem> createTextEdit();
+    static QQuickTextDocument *textDocument(QQuickItem *textEdit);
+    static QStringList textParts();
+    static void type(QTextDocument *document, const QStringList &characters);
+
+    QQmlEngine m_engine;
+};
+
+void TextFormatterTest::incrementalFormatting_data()
+{
+    QTest::addColumn<bool>("enhancedFormatting");
+
+    QTest::newRow("normal") << false;
+    QTest::newRow("enhanced") << true;
+}
+
+void TextFormatterTest::incrementalFormatting()
+{
+    QFETCH(bool, enhancedFormatting);
+
+    QStringList characters;
+    for (const auto &part : textParts()) {
+        characters.append(part);
+    }
+
+    // Format the text while it is typed.
+    auto typedTextEdit = createTextEdit();
+    auto typedDocument = textDocument(typedTextEdit.get());
+    TextFormatter typedFormatter;
+    typedFormatter.setEnhancedFormatting(enhancedFormatting);
+    typedFormatter.setTextDocument(typedDocument);
+    type(typedDocument->textDocument(), characters);
+
+    // Format the whole text at once.
+    auto insertedTextEdit = createTextEdit();
+    auto insertedDocument = textDocument(insertedTextEdit.get());
+    insertedDocument->textDocument()->setPlainText(characters.join(QString()));
+    TextFormatter insertedFormatter;
+    insertedFormatter.setEnhancedFormatting(enhancedFormatting);
+    insertedFormatter.setTextDocument(insertedDocument);
+
+    QCOMPARE(typedDocument->textDocument()->toRawText(), insertedDocument->textDocument()->toRawText());
+
+    QTextCursor typedCursor(typedDocument->textDocument());
+    QTextCursor insertedCursor(insertedDocument->textDocument());
+
+    for (int i = 1; i < typedDocument->textDocument()->characterCount(); ++i) {
+        typedCursor.setPosition(i);
+        insertedCursor.setPosition(i);
+
+        const auto typedFont = typedCursor.charFormat().font();
+        const auto insertedFont = insertedCursor.charFormat().font();
+
+        QCOMPARE(typedFont.family() == EMOJI_FONT_FAMILY, insertedFont.family() == EMOJI_FONT_FAMILY);
+
+        if (typedFont.family() == EMOJI_FONT_FAMILY) {
+            QCOMPARE(typedFont.pointSizeF(), insertedFont.pointSizeF());
+        }
+    }
+
+    // URLs and mentions are only formatted with enhanced formatting.
+    const auto text = typedDocument->textDocument()->toRawText();
+
+    typedCursor.setPosition(text.indexOf(QStringLiteral("https://")) + 1);
+    QCOMPARE(typedCursor.charFormat().isAnchor(), enhancedFormatting);
+    QCOMPARE(typedCursor.charFormat().anchorHref(), enhancedFormatting ? QStringLiteral("https://kaidan.im") : QString());
+
+    typedCursor.setPosition(text.indexOf(QStringLiteral("@alice")) + 1);
+    QCOMPARE(typedCursor.charFormat().fontWeight() == QFont::DemiBold, enhancedFormatting);
+}
+
+void TextFormatterTest::emojiFontSize()
+{
+    auto textEdit = createTextEdit();
+    auto document = textDocument(textEdit.get());
+    TextFormatter formatter;
+    formatter.setEnhancedFormatting(true);
+    formatter.setTextDocument(document);
+
+    QTextCursor cursor(document->textDocument());
+
+    const auto emojiPointSize = [&cursor]() {
+        cursor.setPosition(2);
+        return cursor.charFormat().font().pointSizeF();
+    };
+
+    type(document->textDocument(), {QStringLiteral("😀")});
+    const auto singleEmojiPointSize = emojiPointSize();
+
+    type(document->textDocument(), {QStringLiteral("😀")});
+    const auto multipleEmojisPointSize = emojiPointSize();
+
+    type(document->textDocument(), {QStringLiteral("a")});
+    const auto mixedTextPointSize = emojiPointSize();
+
+    QVERIFY(singleEmojiPointSize > multipleEmojisPointSize);
+    QVERIFY(multipleEmojisPointSize > mixedTextPointSize);
+
+    // The text added after an emoji does not get the emoji's format.
+    cursor.movePosition(QTextCursor::End);
+    QVERIFY(cursor.charFormat().font().family() != EMOJI_FONT_FAMILY);
+}
+
+void TextFormatterTest::typing_data()
+{
+    QTest::addColumn<bool>("enhancedFormatting");
+
+    QTest::newRow("normal") << false;
+    QTest::newRow("enhanced") << true;
+}
+
+void TextFormatterTest::typing()
+{
+    QFETCH(bool, enhancedFormatting);
+
+    QStringList characters;
+    characters.reserve(TYPED_CHARACTER_COUNT);
+
+    for (const auto parts = textParts(); characters.size() < TYPED_CHARACTER_COUNT;) {
+        characters.append(parts.at(characters.size() % parts.size()));
+    }
+
+    auto textEdit = createTextEdit();
+    auto document = textDocument(textEdit.get());
+    TextFormatter formatter;
+    formatter.setEnhancedFormatting(enhancedFormatting);
+    formatter.setTextDocument(document);
+
+    QBENCHMARK {
+        document->textDocument()->clear();
+        type(document->textDocument(), characters);
+    }
+}
+
+std::unique_ptr<QQuickItem> TextFormatterTest::createTextEdit()
+{
+    QQmlComponent component(&m_engine);
+    component.setData("import QtQuick\nTextEdit {}", QUrl());
+    return std::unique_ptr<QQuickItem>(qobject_cast<QQuickItem *>(component.create()));
+}
+
+QQuickTextDocument *TextFormatterTest::textDocument(QQuickItem *textEdit)
+{
+    return textEdit->property("textDocument").value<QQuickTextDocument *>();
+}
+
+// Returns the characters (i.e., grapheme clusters) of a text with emojis, a URL and a mention.
+QStringList TextFormatterTest::textParts()
+{
+    return {
+        QStringLiteral("H"),
+        QStringLiteral("i"),
+        QStringLiteral(" "),
+        QStringLiteral("😀"),
+        QStringLiteral(" "),
+        QStringLiteral("h"),
+        QStringLiteral("t"),
+        QStringLiteral("t"),
+        QStringLiteral("p"),
+        QStringLiteral("s"),
+        QStringLiteral(":"),
+        QStringLiteral("/"),
+        QStringLiteral("/"),
+        QStringLiteral("k"),
+        QStringLiteral("a"),
+        QStringLiteral("i"),
+        QStringLiteral("d"),
+        QStringLiteral("a"),
+        QStringLiteral("n"),
+        QStringLiteral("."),
+        QStringLiteral("i"),
+        QStringLiteral("m"),
+        QStringLiteral(" "),
+        QStringLiteral("@"),
+        QStringLiteral("a"),
+        QStringLiteral("l"),
+        QStringLiteral("i"),
+        QStringLiteral("c"),
+        QStringLiteral("e"),
+        QStringLiteral("👍"),
+        QStringLiteral("\n"),
+    };
+}
+
+void TextFormatterTest::type(QTextDocument *document, const QStringList &characters)
+{
+    QTextCursor cursor(document);
+    cursor.movePosition(QTextCursor::End);
+
+    for (const auto &character : characters) {
+        cursor.insertText(character);
+    }
+}
+
+QTEST_MAIN(TextFormatterTest)
+#include "TextFormatterTest.moc"
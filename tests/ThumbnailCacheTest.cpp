@@ -0,0 +1,262 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// std
+#include <stdexcept>
+// Qt
+#include <QDir>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QTest>
+// Kaidan
+#include "Test.h"
+#include "TestUtils.h"
+#include "ThumbnailCache.h"
+
+constexpr auto EDGE_PIXEL_COUNT = 100;
+constexpr auto DEVICE_PIXEL_RATIO = 1.0;
+constexpr qsizetype MEMORY_LIMIT = 1024 * 1024;
+constexpr qint64 DISK_LIMIT = 1024 * 1024;
+
+class ThumbnailCacheTest : public Test
+{
+    Q_OBJECT
+
+private:
+    Q_SLOT void initTestCase() override;
+    Q_SLOT void singleDecode();
+    Q_SLOT void concurrentRequests();
+    Q_SLOT void diskCache();
+    Q_SLOT void modifiedFile();
+    Q_SLOT void canceledGeneration();
+    Q_SLOT void diskLimit();
+    Q_SLOT void diskLimitExceededByStoring();
+
+    QString createImageFile(const QString &fileName, const QColor &color);
+    static void setLastModified(const QString &filePath, const QDateTime &lastModified);
+    ThumbnailCache::Generator countingGenerator(int &decodeCount, const QColor &color = Qt::red);
+
+    QTemporaryDir m_dir;
+};
+
+void ThumbnailCacheTest::initTestCase()
+{
+    Test::initTestCase();
+
+    QVERIFY(m_dir.isValid());
+}
+
+void ThumbnailCacheTest::singleDecode()
+{
+    ThumbnailCache cache(m_dir.filePath(QStringLiteral("single-decode")), MEMORY_LIMIT, DISK_LIMIT);
+    const auto filePath = createImageFile(QStringLiteral("single-decode.png"), Qt::red);
+    int decodeCount = 0;
+
+    for (int i = 0; i < 100; ++i) {
+        const auto image = wait(cache.thumbnail(filePath, EDGE_PIXEL_COUNT, DEVICE_PIXEL_RATIO, countingGenerator(decodeCount)));
+        QCOMPARE(image.size(), QSize(EDGE_PIXEL_COUNT, EDGE_PIXEL_COUNT));
+    }
+
+    QCOMPARE(decodeCount, 1);
+
+    // A different thumbnail size is a different entry.
+    wait(cache.thumbnail(filePath, EDGE_PIXEL_COUNT * 2, DEVICE_PIXEL_RATIO, countingGenerator(decodeCount)));
+    QCOMPARE(decodeCount, 2);
+}
+
+void ThumbnailCacheTest::concurrentRequests()
+{
+    ThumbnailCache cache(m_dir.filePath(QStringLiteral("concurrent-requests")), MEMORY_LIMIT, DISK_LIMIT);
+    const auto filePath = createImageFile(QStringLiteral("concurrent-requests.png"), Qt::green);
+
+    int decodeCount = 0;
+    QPromise<QImage> decodePromise;
+
+    QList<QFuture<QImage>> futures;
+
+    for (int i = 0; i < 100; ++i) {
+        futures.append(cache.thumbnail(filePath, EDGE_PIXEL_COUNT, DEVICE_PIXEL_RATIO, [&decodeCount, &decodePromise]() {
+            decodeCount++;
+            decodePromise.start();
+            return decodePromise.future();
+        }));
+    }
+
+    decodePromise.addResult(QImage(EDGE_PIXEL_COUNT, EDGE_PIXEL_COUNT, QImage::Format_RGB32));
+    decodePromise.finish();
+
+    for (const auto &future : std::as_const(futures)) {
+        QVERIFY(future.isFinished());
+        QVERIFY(!future.result().isNull());
+    }
+
+    QCOMPARE(decodeCount, 1);
+}
+
+void ThumbnailCacheTest::diskCache()
+{
+    const auto directoryPath = m_dir.filePath(QStringLiteral("disk-cache"));
+    const auto filePath = createImageFile(QStringLiteral("disk-cache.png"), Qt::blue);
+    int decodeCount = 0;
+
+    {
+        ThumbnailCache cache(directoryPath, MEMORY_LIMIT, DISK_LIMIT);
+        wait(cache.thumbnail(filePath, EDGE_PIXEL_COUNT, DEVICE_PIXEL_RATIO, countingGenerator(decodeCount, Qt::blue)));
+
+        // The thumbnail written in the background is stored once the cache is destroyed.
+    }
+
+    // A new cache (e.g., after a restart) loads the thumbnail from disk.
+    ThumbnailCache cache(directoryPath, MEMORY_LIMIT, DISK_LIMIT);
+
+    for (int i = 0; i < 100; ++i) {
+        const auto image = wait(cache.thumbnail(filePath, EDGE_PIXEL_COUNT, DEVICE_PIXEL_RATIO, countingGenerator(decodeCount, Qt::blue)));
+        QCOMPARE(image.pixelColor(0, 0), QColor(Qt::blue));
+    }
+
+    QCOMPARE(decodeCount, 1);
+
+    // Thumbnails removed from memory are loaded from disk again.
+    cache.clearMemory();
+    wait(cache.thumbnail(filePath, EDGE_PIXEL_COUNT, DEVICE_PIXEL_RATIO, countingGenerator(decodeCount, Qt::blue)));
+    QCOMPARE(decodeCount, 1);
+}
+
+void ThumbnailCacheTest::modifiedFile()
+{
+    ThumbnailCache cache(m_dir.filePath(QStringLiteral("modified-file")), MEMORY_LIMIT, DISK_LIMIT);
+    const auto fileName = QStringLiteral("modified-file.png");
+    const auto filePath = createImageFile(fileName, Qt::red);
+    int decodeCount = 0;
+
+    wait(cache.thumbnail(filePath, EDGE_PIXEL_COUNT, DEVICE_PIXEL_RATIO, countingGenerator(decodeCount)));
+    QCOMPARE(decodeCount, 1);
+
+    // Ensure a different modification time even if the file is changed within the same second.
+    const auto lastModified = QFileInfo(filePath).lastModified();
+    createImageFile(fileName, Qt::yellow);
+    setLastModified(filePath, lastModified.addSecs(1));
+
+    wait(cache.thumbnail(filePath, EDGE_PIXEL_COUNT, DEVICE_PIXEL_RATIO, countingGenerator(decodeCount)));
+    QCOMPARE(decodeCount, 2);
+}
+
+void ThumbnailCacheTest::canceledGeneration()
+{
+    ThumbnailCache cache(m_dir.filePath(QStringLiteral("canceled-generation")), MEMORY_LIMIT, DISK_LIMIT);
+    const auto filePath = createImageFile(QStringLiteral("canceled-generation.png"), Qt::red);
+    int decodeCount = 0;
+
+    const auto image = wait(cache.thumbnail(filePath, EDGE_PIXEL_COUNT, DEVICE_PIXEL_RATIO, [&decodeCount]() {
+        decodeCount++;
+        return QtFuture::makeReadyVoidFuture().then([]() -> QImage {
+            throw std::runtime_error("Decoding failed");
+        });
+    }));
+    QVERIFY(image.isNull());
+
+    // A canceled generation does not block further requests.
+    QPromise<QImage> decodePromise;
+    auto canceledFuture = cache.thumbnail(filePath, EDGE_PIXEL_COUNT, DEVICE_PIXEL_RATIO, [&decodeCount, &decodePromise]() {
+        decodeCount++;
+        decodePromise.start();
+        return decodePromise.future();
+    });
+    decodePromise.future().cancel();
+    decodePromise.finish();
+    QVERIFY(canceledFuture.isFinished());
+
+    wait(cache.thumbnail(filePath, EDGE_PIXEL_COUNT, DEVICE_PIXEL_RATIO, countingGenerator(decodeCount)));
+    QCOMPARE(decodeCount, 3);
+}
+
+void ThumbnailCacheTest::diskLimit()
+{
+    const auto directoryPath = m_dir.filePath(QStringLiteral("disk-limit"));
+    QDir().mkpath(directoryPath);
+
+    // Thumbnails of 100 bytes each with the least recently used one first.
+    const auto now = QDateTime::currentDateTimeUtc();
+
+    for (int i = 0; i < 10; ++i) {
+        const auto filePath = directoryPath + QStringLiteral("/%1.png").arg(i);
+        QFile file(filePath);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        file.write(QByteArray(100, 'x'));
+        file.close();
+        setLastModified(filePath, now.addSecs(i - 10));
+    }
+
+    ThumbnailCache cache(directoryPath, MEMORY_LIMIT, 450);
+    wait(cache.removeLeastRecentlyUsedFiles());
+
+    QCOMPARE(QDir(directoryPath).entryList(QDir::Files, QDir::Name),
+             (QStringList{QStringLiteral("6.png"), QStringLiteral("7.png"), QStringLiteral("8.png"), QStringLiteral("9.png")}));
+}
+
+void ThumbnailCacheTest::diskLimitExceededByStoring()
+{
+    const auto directoryPath = m_dir.filePath(QStringLiteral("disk-limit-exceeded"));
+    constexpr int fileCount = 10;
+    constexpr int keptFileCount = 3;
+    int decodeCount = 0;
+
+    QStringList filePaths;
+
+    for (int i = 0; i < fileCount; ++i) {
+        filePaths.append(createImageFile(QStringLiteral("disk-limit-exceeded-%1.png").arg(i), Qt::red));
+    }
+
+    // Determine the size of a stored thumbnail.
+    {
+        ThumbnailCache cache(directoryPath, MEMORY_LIMIT, DISK_LIMIT);
+        wait(cache.thumbnail(filePaths.constFirst(), EDGE_PIXEL_COUNT, DEVICE_PIXEL_RATIO, countingGenerator(decodeCount)));
+    }
+
+    const auto thumbnailFileInfos = QDir(directoryPath).entryInfoList(QDir::Files);
+    QCOMPARE(thumbnailFileInfos.size(), 1);
+    const auto thumbnailSize = thumbnailFileInfos.constFirst().size();
+    QVERIFY(QFile::remove(thumbnailFileInfos.constFirst().absoluteFilePath()));
+
+    // Storing thumbnails that exceed the disk limit removes the least recently used ones.
+    {
+        ThumbnailCache cache(directoryPath, MEMORY_LIMIT, thumbnailSize * keptFileCount + thumbnailSize / 2);
+
+        for (const auto &filePath : std::as_const(filePaths)) {
+            wait(cache.thumbnail(filePath, EDGE_PIXEL_COUNT, DEVICE_PIXEL_RATIO, countingGenerator(decodeCount)));
+        }
+    }
+
+    QCOMPARE(decodeCount, fileCount + 1);
+    QCOMPARE(QDir(directoryPath).entryList(QDir::Files).size(), keptFileCount);
+}
+
+QString ThumbnailCacheTest::createImageFile(const QString &fileName, const QColor &color)
+{
+    const auto filePath = m_dir.filePath(fileName);
+    QImage image(EDGE_PIXEL_COUNT * 4, EDGE_PIXEL_COUNT * 4, QImage::Format_RGB32);
+    image.fill(color);
+    image.save(filePath);
+    return filePath;
+}
+
+void ThumbnailCacheTest::setLastModified(const QString &filePath, const QDateTime &lastModified)
+{
+    QFile file(filePath);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QVERIFY(file.setFileTime(lastModified, QFileDevice::FileModificationTime));
+}
+
+ThumbnailCache::Generator ThumbnailCacheTest::countingGenerator(int &decodeCount, const QColor &color)
+{
+    return [&decodeCount, color]() {
+        decodeCount++;
+        QImage image(EDGE_PIXEL_COUNT, EDGE_PIXEL_COUNT, QImage::Format_RGB32);
+        image.fill(color);
+        return QtFuture::makeReadyValueFuture(std::move(image));
+    };
+}
+
+QTEST_GUILESS_MAIN(ThumbnailCacheTest)
+#include "ThumbnailCacheTest.moc"
@@ -0,0 +1,177 @@
+// SPDX-FileCopyrightText: 2026 Kaidan developers and contributors
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// Qt
+#include <QCryptographicHash>
+#include <QPromise>
+#include <QTest>
+// QXmpp
+#include <QXmppPresence.h>
+// Kaidan
+#include "Account.h"
+#include "AvatarImageCache.h"
+#include "ClientController.h"
+#include "Globals.h"
+#include "RosterItem.h"
+#include "RosterModel.h"
+#include "Test.h"
+#include "VCardController.h"
+
+static const auto accountJid = QStringLiteral("user@example.org");
+
+class VCardControllerTest : public Test
+{
+    Q_OBJECT
+
+private:
+    Q_SLOT void initTestCase() override;
+    Q_SLOT void testRecentlyCheckedContacts();
+    Q_SLOT void testAvatarAnnouncedByMultipleResources();
+    Q_SLOT void testAvatarAnnouncedDuringRequest();
+
+    /**
+     * Announces an avatar as a contact's resource does via its presence.
+     */
+    void announceAvatar(const QString &jid, const QString &resource, const QByteArray &avatar);
+
+    /**
+     * Answers a pending vCard request with a vCard containing an avatar.
+     */
+    void respond(int requestIndex, const QByteArray &avatar);
+
+    static QString avatarHash(const QByteArray &avatar);
+
+    struct Request {
+        QString jid;
+        std::shared_ptr<QPromise<QXmppVCardManager::Result>> promise;
+    };
+
+    Account *m_account = nullptr;
+    QList<Request> m_requests;
+};
+
+void VCardControllerTest::initTestCase()
+{
+    Test::initTestCase();
+
+    m_account = addAccount(accountJid);
+
+    // vCard requests are answered by the test.
+    m_account->vCardController()->setVCardFetcher([this](const QString &jid) {
+        auto promise = std::make_shared<QPromise<QXmppVCardManager::Result>>();
+        promise->start();
+
+        m_requests.append({jid, promise});
+
+        return promise->future();
+    });
+}
+
+void VCardControllerTest::testRecentlyCheckedContacts()
+{
+    const auto recentlyCheckedJid = QStringLiteral("recent@example.org");
+    const auto uncheckedJid = QStringLiteral("unchecked@example.org");
+
+    RosterItem recentlyCheckedItem;
+    recentlyCheckedItem.accountJid = accountJid;
+    recentlyCheckedItem.jid = recentlyCheckedJid;
+    recentlyCheckedItem.lastVCardCheckTimestamp = QDateTime::currentDateTimeUtc().addDuration(-VCARD_CHECK_INTERVAL / 2);
+
+    RosterItem uncheckedItem;
+    uncheckedItem.accountJid = accountJid;
+    uncheckedItem.jid = uncheckedJid;
+
+    // The roster items are fetched before being connected.
+    // The recently checked item is handled first so that its request would be started first.
+    Q_EMIT RosterModel::instance()->itemsFetched({recentlyCheckedItem, uncheckedItem});
+    QVERIFY(m_requests.isEmpty());
+
+    Q_EMIT m_account->clientController()->connectionStateChanged(Enums::ConnectionState::StateConnected);
+
+    // Only the vCard that has not been checked recently is requested after connecting.
+    QTRY_COMPARE(m_requests.size(), 1);
+    QCOMPARE(m_requests.constFirst().jid, uncheckedJid);
+
+    respond(0, {});
+    m_requests.clear();
+}
+
+void VCardControllerTest::testAvatarAnnouncedByMultipleResources()
+{
+    const auto jid = QStringLiteral("contact-1@example.org");
+    const auto avatar = QByteArrayLiteral("avatar-1");
+
+    announceAvatar(jid, QStringLiteral("resource-1"), avatar);
+    QTRY_COMPARE(m_requests.size(), 1);
+
+    // Further resources announce the same avatar while it is being requested.
+    announceAvatar(jid, QStringLiteral("resource-2"), avatar);
+    announceAvatar(jid, QStringLiteral("resource-3"), avatar);
+
+    // The response contains the announced avatar and thus no further request is needed.
+    respond(0, avatar);
+    QTRY_COMPARE(AvatarImageCache::instance()->getHashOfJid(jid), avatarHash(avatar));
+
+    // Resources announcing the stored avatar do not cause a request.
+    announceAvatar(jid, QStringLiteral("resource-4"), avatar);
+
+    QCOMPARE(m_requests.size(), 1);
+    m_requests.clear();
+}
+
+void VCardControllerTest::testAvatarAnnouncedDuringRequest()
+{
+    const auto jid = QStringLiteral("contact-2@example.org");
+    const auto firstAvatar = QByteArrayLiteral("avatar-2");
+    const auto secondAvatar = QByteArrayLiteral("avatar-3");
+
+    announceAvatar(jid, QStringLiteral("resource-1"), firstAvatar);
+    QTRY_COMPARE(m_requests.size(), 1);
+
+    // Another avatar is announced while the previous one is being requested.
+    announceAvatar(jid, QStringLiteral("resource-2"), secondAvatar);
+    QCOMPARE(m_requests.size(), 1);
+
+    // The response does not contain the avatar announced last and thus it is requested afterwards.
+    respond(0, firstAvatar);
+
+    QTRY_COMPARE(m_requests.size(), 2);
+    QCOMPARE(m_requests.at(1).jid, jid);
+
+    respond(1, secondAvatar);
+    QTRY_COMPARE(AvatarImageCache::instance()->getHashOfJid(jid), avatarHash(secondAvatar));
+
+    QCOMPARE(m_requests.size(), 2);
+    m_requests.clear();
+}
+
+void VCardControllerTest::announceAvatar(const QString &jid, const QString &resource, const QByteArray &avatar)
+{
+    QXmppPresence presence;
+    presence.setFrom(jid + u'/' + resource);
+    presence.setVCardUpdateType(QXmppPresence::VCardUpdateValidPhoto);
+    presence.setPhotoHash(QCryptographicHash::hash(avatar, QCryptographicHash::Sha1));
+
+    Q_EMIT m_account->clientController()->xmppClient()->presenceReceived(presence);
+}
+
+void VCardControllerTest::respond(int requestIndex, const QByteArray &avatar)
+{
+    const auto &request = m_requests.at(requestIndex);
+
+    QXmppVCardIq vCard;
+    vCard.setFrom(request.jid);
+    vCard.setPhoto(avatar);
+
+    request.promise->addResult(QXmppVCardManager::Result(vCard));
+    request.promise->finish();
+}
+
+QString VCardControllerTest::avatarHash(const QByteArray &avatar)
+{
+    return QString::fromUtf8(QCryptographicHash::hash(avatar, QCryptographicHash::Sha1).toHex());
+}
+
+QTEST_GUILESS_MAIN(VCardControllerTest)
+#include "VCardControllerTest.moc"